@@ -0,0 +1,88 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_BASELINE_HPP
+#define TENSORMATH_BASELINE_HPP
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include "Workloads.hpp"
+
+//baseline files: the results of a run as a small JSON object, one workload per line
+//{"threads": 1, "isa": "avx512", "workloads": {
+//  "gemm_64": {"median_ns": 5210.3, "noise": 0.004},
+//  ...
+//}}
+//only files written by TensorMath_perf are read, the reader just looks for the keys
+
+namespace Perf {
+
+    //results of a run, with what they were measured on
+    struct Baseline {
+        int threads = 0;
+        std::string isa;
+        std::vector<Result> results;
+
+        const Result *find(const std::string &name) const {
+            for (const Result &result: results) { if (result.name == name) { return &result; } }
+            return nullptr;
+        } //result of a workload, nullptr if it was not measured
+    };
+
+    inline bool saveBaseline(const std::string &path, const Baseline &baseline) {
+        std::ofstream file(path);
+        if (!file.is_open()) { return false; }
+        file << "{\"threads\": " << baseline.threads << ", \"isa\": \"" << baseline.isa << "\", \"workloads\": {\n";
+        char line[256];
+        for (size_t i = 0; i < baseline.results.size(); ++i) {
+            const Result &result = baseline.results[i];
+            snprintf(line, sizeof(line), "  \"%s\": {\"median_ns\": %.1f, \"noise\": %.4f}%s\n", result.name.c_str(),
+                     result.median_ns, result.noise, i + 1 < baseline.results.size() ? "," : "");
+            file << line;
+        }
+        file << "}}\n";
+        return file.good();
+    } //write results as JSON. false if the file can not be written.
+
+    inline double numberAfter(const std::string &text, size_t position, const std::string &key) {
+        position = text.find("\"" + key + "\":", position);
+        if (position == std::string::npos) { return -1; }
+        return std::strtod(text.c_str() + position + key.size() + 3, nullptr);
+    } //value of the first numeric key after a position, -1 if there is none
+
+    inline bool loadBaseline(const std::string &path, Baseline &baseline) {
+        std::ifstream file(path);
+        if (!file.is_open()) { return false; }
+        std::stringstream stream;
+        stream << file.rdbuf();
+        std::string text = stream.str();
+        baseline = Baseline();
+        baseline.threads = (int) numberAfter(text, 0, "threads");
+        size_t isa = text.find("\"isa\": \"");
+        if (isa != std::string::npos) {
+            isa += 8;
+            baseline.isa = text.substr(isa, text.find('"', isa) - isa);
+        }
+        size_t position = text.find("\"workloads\"");
+        if (position == std::string::npos) { return false; }
+        while ((position = text.find("\n  \"", position)) != std::string::npos) {
+            position += 4;
+            Result result;
+            result.name = text.substr(position, text.find('"', position) - position);
+            result.median_ns = numberAfter(text, position, "median_ns");
+            result.noise = numberAfter(text, position, "noise");
+            if (result.median_ns <= 0 || result.noise < 0) { return false; }
+            baseline.results.push_back(result);
+        }
+        return !baseline.results.empty();
+    } //read results written by saveBaseline(). false if the file is missing or not a baseline.
+
+    inline double getLimit(const Result &base, const Result &now, double tolerance) {
+        return base.median_ns * (1 + std::max(tolerance, 3 * (base.noise + now.noise)));
+    } //slowest time that is not a regression: the tolerance, or three times the noise of both runs when that is larger
+}
+
+#endif //TENSORMATH_BASELINE_HPP
@@ -0,0 +1,92 @@
+//
+// Created by Philip on 10/19/2026.
+//
+#include <cstring>
+#include <iostream>
+#include "Baseline.hpp"
+
+//runs the workload suite and compares it against a baseline
+//TensorMath_perf [--baseline file] [--update] [--output file] [--tolerance fraction]
+//exit code 1 if any workload is slower than the baseline allows or the workloads differ from it,
+//2 for bad arguments or files, or a thread count or instruction set other than the baseline's
+
+int main(int argc, char **argv) {
+    using namespace Perf;
+    std::string baseline_path, output_path;
+    bool update = false;
+    double tolerance = 0.10; //slowdown that is always allowed
+    for (int i = 1; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--baseline") == 0 && has_value) { baseline_path = argv[++i]; }
+        else if (std::strcmp(argv[i], "--output") == 0 && has_value) { output_path = argv[++i]; }
+        else if (std::strcmp(argv[i], "--tolerance") == 0 && has_value) { tolerance = std::atof(argv[++i]); }
+        else if (std::strcmp(argv[i], "--update") == 0) { update = true; }
+        else { tolerance = -1; } //bad argument
+        if (tolerance < 0) {
+            std::cerr << "usage: TensorMath_perf [--baseline file] [--update] [--output file] [--tolerance fraction]\n";
+            return 2;
+        }
+    }
+
+    Baseline base;
+    bool compare = !baseline_path.empty() && !update;
+    if (compare && !loadBaseline(baseline_path, base)) {
+        std::cerr << "can not read baseline " << baseline_path << "\n";
+        return 2;
+    }
+    Baseline now;
+    now.threads = ThreadPool::global().getThreadCount();
+    now.isa = getIsaName(getIsa());
+    if (compare && (base.threads != now.threads || base.isa != now.isa)) {
+        std::cerr << "baseline was measured with " << base.threads << " threads and " << base.isa
+                  << ", this run uses " << now.threads << " threads and " << now.isa << "\n"
+                  << "pin them with TENSORMATH_THREADS=" << base.threads << " TENSORMATH_ISA=" << base.isa
+                  << ", or measure a new baseline with --update\n";
+        return 2;
+    }
+
+    int regressions = 0, mismatches = 0; //slower workloads, workloads only in the run or only in the baseline
+    char line[256];
+    for (const Workload &workload: getWorkloads()) {
+        Result result = measure(workload);
+        now.results.push_back(result);
+        snprintf(line, sizeof(line), "%-24s %14.1f ns  +-%5.2f%%", result.name.c_str(), result.median_ns, result.noise * 100);
+        std::cout << line;
+        if (result.flops > 0) {
+            snprintf(line, sizeof(line), "  %7.2f GFLOP/s", result.flops / result.median_ns);
+            std::cout << line;
+        }
+        const Result *old = compare ? base.find(result.name) : nullptr;
+        if (old != nullptr) {
+            bool slower = result.median_ns > getLimit(*old, result, tolerance);
+            regressions += slower;
+            snprintf(line, sizeof(line), "  %+7.2f%% vs baseline%s", (result.median_ns / old->median_ns - 1) * 100,
+                     slower ? "  REGRESSION" : "");
+            std::cout << line;
+        } else if (compare) {
+            mismatches++;
+            std::cout << "  NOT IN BASELINE";
+        }
+        std::cout << std::endl;
+    }
+    for (const Result &old: base.results) {
+        if (compare && now.find(old.name) == nullptr) {
+            mismatches++;
+            snprintf(line, sizeof(line), "%-24s  IN BASELINE, NOT RUN", old.name.c_str());
+            std::cout << line << std::endl;
+        }
+    }
+
+    if (update && !saveBaseline(baseline_path, now)) {
+        std::cerr << "can not write baseline " << baseline_path << "\n";
+        return 2;
+    }
+    if (!output_path.empty() && !saveBaseline(output_path, now)) {
+        std::cerr << "can not write " << output_path << "\n";
+        return 2;
+    }
+    if (regressions > 0) { std::cout << regressions << " workload(s) slower than the baseline allows\n"; }
+    if (mismatches > 0) { std::cout << mismatches << " workload(s) not in both the run and the baseline, update it\n"; }
+    if (regressions > 0 || mismatches > 0) { return 1; }
+    return 0;
+}
@@ -0,0 +1,110 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_WORKLOADS_HPP
+#define TENSORMATH_WORKLOADS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../TensorMath/Matrix.hpp"
+#include "../TensorMath/Strassen.hpp"
+#include "../TensorMath/Serialization.hpp"
+
+//fixed suite of realistic workloads timed by TensorMath_perf
+//each workload is set up once, then its body is run enough times that one sample lasts about SAMPLE_SECONDS
+using namespace TensorMath;
+
+namespace Perf {
+    constexpr double SAMPLE_SECONDS = 0.05; //length of one sample
+    constexpr int SAMPLES = 9; //samples per workload, the median is reported
+
+    //one timed workload
+    struct Workload {
+        std::string name;
+        double flops; //floating point operations of one run of the body, 0 when not meaningful
+        std::function<void()> body;
+    };
+
+    //timing of one workload
+    struct Result {
+        std::string name;
+        double median_ns = 0; //median time of one run of the body
+        double noise = 0; //median absolute deviation of the samples, relative to the median
+        double flops = 0;
+    };
+
+    inline double secondsOf(const std::function<void()> &body, long long runs) {
+        auto start = std::chrono::steady_clock::now();
+        for (long long i = 0; i < runs; ++i) { body(); }
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } //time runs of a body
+
+    inline Result measure(const Workload &workload) {
+        long long runs = 1;
+        double seconds = secondsOf(workload.body, runs); //warm up caches, pool threads and dispatch
+        while ((seconds = secondsOf(workload.body, runs)) < SAMPLE_SECONDS / 4) { runs *= 2; }
+        runs = std::max(1LL, (long long) (runs * SAMPLE_SECONDS / seconds));
+        std::vector<double> samples(SAMPLES);
+        for (double &sample: samples) { sample = secondsOf(workload.body, runs) * 1e9 / runs; }
+        std::sort(samples.begin(), samples.end());
+        Result result;
+        result.name = workload.name;
+        result.flops = workload.flops;
+        result.median_ns = samples[SAMPLES / 2];
+        std::vector<double> deviations(SAMPLES);
+        for (int i = 0; i < SAMPLES; ++i) { deviations[i] = std::abs(samples[i] - result.median_ns); }
+        std::sort(deviations.begin(), deviations.end());
+        result.noise = deviations[SAMPLES / 2] / result.median_ns;
+        return result;
+    } //median time per run and its noise
+
+    inline void addProduct(std::vector<Workload> &workloads, int size) {
+        std::shared_ptr<Matrix> a = std::make_shared<Matrix>(size, size), b = std::make_shared<Matrix>(size, size),
+                out = std::make_shared<Matrix>(size, size);
+        a->randomFill(-1, 1, 1);
+        b->randomFill(-1, 1, 2);
+        workloads.push_back({"gemm_" + std::to_string(size), 2.0 * size * size * size,
+                             [a, b, out]() { multiply(*a, *b, *out); }});
+    } //square matrix product into an existing matrix
+
+    inline std::vector<Workload> getWorkloads() {
+        std::vector<Workload> workloads;
+        for (int size: {32, 64, 128, 256, 512}) { addProduct(workloads, size); }
+
+        std::shared_ptr<Matrix> a = std::make_shared<Matrix>(1024, 1024), b = std::make_shared<Matrix>(1024, 1024),
+                out = std::make_shared<Matrix>(1024, 1024);
+        a->randomFill(-1, 1, 3);
+        b->randomFill(-1, 1, 4);
+        workloads.push_back({"strassen_1024", 2.0 * 1024 * 1024 * 1024, [a, b, out]() { multiplyStrassen(*a, *b, *out); }});
+
+        constexpr int COUNT = 1000000;
+        std::shared_ptr<std::vector<FixedVector<3>>> points = std::make_shared<std::vector<FixedVector<3>>>(COUNT),
+                moved = std::make_shared<std::vector<FixedVector<3>>>(COUNT);
+        for (int i = 0; i < COUNT; ++i) { (*points)[i] = FixedVector<3>(1.0 + i % 7, 2.0 - i % 5, 0.5 + i % 3); }
+        workloads.push_back({"normalize_vector3_1M", 0, [points, moved]() {
+            std::copy(points->begin(), points->end(), moved->begin()); //same input every run
+            FixedVector<3>::normalizeBatch(moved->data(), COUNT);
+        }});
+        std::shared_ptr<FixedMatrix<3, 3>> rotation = std::make_shared<FixedMatrix<3, 3>>();
+        rotation->randomFill(-1, 1, 5);
+        workloads.push_back({"transform_vector3_1M", 2.0 * 3 * 3 * COUNT, [points, moved, rotation]() {
+            rotation->transformBatch(points->data(), moved->data(), COUNT);
+        }});
+
+        std::shared_ptr<std::vector<unsigned char>> bytes =
+                std::make_shared<std::vector<unsigned char>>(getSerializedSize<FixedVector<3>>(COUNT));
+        workloads.push_back({"serialize_vector3_1M", 0, [points, moved, bytes]() {
+            serialize(points->data(), COUNT, bytes->data(), Endian::Big); //byte swapped both ways
+            deserialize(bytes->data(), COUNT, moved->data(), Endian::Big);
+        }});
+        return workloads;
+    } //the suite, in the order it runs
+}
+
+#endif //TENSORMATH_WORKLOADS_HPP
@@ -0,0 +1,159 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_AABB_HPP
+#define TENSORMATH_AABB_HPP
+
+#include "FixedVector.hpp"
+#include "Ray.hpp"
+
+namespace TensorMath {
+
+    //axis aligned bounding box in n dimensions, stored as a minimum and maximum corner
+    //a default constructed box is empty(min = +infinity, max = -infinity) so expanding it with anything just works
+    template<int dimensions>
+    class AABB {
+    public:
+        //CONSTRUCTORS
+            AABB() : m_min(std::numeric_limits<double>::infinity()), m_max(-std::numeric_limits<double>::infinity()) {
+            } //create an empty box
+            AABB(const FixedVector<dimensions> &min, const FixedVector<dimensions> &max) : m_min(min), m_max(max) {
+            } //create a box from two corners
+            explicit AABB(const FixedVector<dimensions> &point) : m_min(point), m_max(point) {
+            } //create a box around a single point
+
+        //SETTERS AND GETTERS
+            const FixedVector<dimensions> &getMin() const { return m_min; } //get the minimum corner
+            const FixedVector<dimensions> &getMax() const { return m_max; } //get the maximum corner
+            void setMin(const FixedVector<dimensions> &min) { m_min = min; } //set the minimum corner
+            void setMax(const FixedVector<dimensions> &max) { m_max = max; } //set the maximum corner
+            static constexpr int getDim() { return dimensions; } //get num dimensions
+
+        //COMPARISON
+            bool equals(const AABB &other, double epsilon = std::numeric_limits<double>::epsilon() * 10) const {
+                return m_min.equals(other.m_min, epsilon) && m_max.equals(other.m_max, epsilon);
+            } //compare both corners, using epsilon for reliability
+            bool operator==(const AABB &other) const { return equals(other); } //comparison
+            bool operator!=(const AABB &other) const { return !equals(other); } //comparison
+
+        //UTILITIES
+            void expand(const FixedVector<dimensions> &point) {
+                m_min = m_min.min(point);
+                m_max = m_max.max(point);
+            } //grow the box to contain a point
+            void expand(const AABB &other) {
+                m_min = m_min.min(other.m_min);
+                m_max = m_max.max(other.m_max);
+            } //grow the box to contain another box
+            AABB merged(const AABB &other) const {
+                AABB out = *this;
+                out.expand(other);
+                return out;
+            } //get a box containing both boxes
+            bool isEmpty() const {
+                for (int i = 0; i < dimensions; ++i) { if (m_min[i] > m_max[i]) { return true; }}
+                return false;
+            } //check if the box contains nothing
+            bool contains(const FixedVector<dimensions> &point) const {
+                for (int i = 0; i < dimensions; ++i) { if (point[i] < m_min[i] || point[i] > m_max[i]) { return false; }}
+                return true;
+            } //check if a point is inside the box(inclusive)
+            bool overlaps(const AABB &other) const {
+                for (int i = 0; i < dimensions; ++i) {
+                    if (other.m_max[i] < m_min[i] || other.m_min[i] > m_max[i]) { return false; }
+                }
+                return true;
+            } //check if two boxes touch or overlap
+            FixedVector<dimensions> center() const {
+                return (m_min + m_max) * 0.5;
+            } //get the center of the box
+            FixedVector<dimensions> extent() const {
+                return m_max - m_min;
+            } //get the size of the box along each axis
+            int longestAxis() const {
+                FixedVector<dimensions> size = extent();
+                int axis = 0;
+                for (int i = 1; i < dimensions; ++i) { if (size[i] > size[axis]) { axis = i; }}
+                return axis;
+            } //get the index of the axis the box is largest along(Useful for splitting)
+            double volume() const {
+                if (isEmpty()) { return 0; }
+                FixedVector<dimensions> size = extent();
+                double out = 1;
+                for (int i = 0; i < dimensions; ++i) { out *= size[i]; }
+                return out;
+            } //get the volume(area in 2d)
+            double surfaceArea() const {
+                if (isEmpty()) { return 0; }
+                FixedVector<dimensions> size = extent();
+                double sum = 0; //2 * sum of the faces. 2(xy + yz + zx) in 3d, perimeter in 2d
+                for (int skip = 0; skip < dimensions; ++skip) {
+                    double face = 1;
+                    for (int i = 0; i < dimensions; ++i) { if (i != skip) { face *= size[i]; }}
+                    sum += face;
+                }
+                return 2.0 * sum;
+            } //get the surface area of the box(Used for the surface area heuristic)
+
+        //INTERSECTION
+            bool intersect(const Ray &ray, double &t_near, double t_min = 0,
+                           double t_max = std::numeric_limits<double>::infinity()) const {
+                static_assert(dimensions == 3, "Ray intersection is only for 3d boxes");
+                const Vector3 &origin = ray.getOrigin();
+                const Vector3 &inverse = ray.getInverseDirection();
+                for (int axis = 0; axis < 3; ++axis) {
+                    double t_0 = (m_min[axis] - origin[axis]) * inverse[axis];
+                    double t_1 = (m_max[axis] - origin[axis]) * inverse[axis];
+                    t_min = maxNumber(minNumber(t_0, t_1), t_min);
+                    t_max = minNumber(maxNumber(t_0, t_1), t_max);
+                }
+                t_near = t_min;
+                return t_min <= t_max;
+            } //branchless slab test. Sets t_near to the entry distance on hit.
+            template<int size>
+            int intersect(const RayPacket<size> &rays, double t_near[size], double t_min = 0) const {
+                static_assert(dimensions == 3, "Ray intersection is only for 3d boxes");
+                double t_far[size];
+                for (int i = 0; i < size; ++i) {
+                    t_near[i] = t_min;
+                    t_far[i] = rays.t_max[i];
+                }
+                for (int axis = 0; axis < 3; ++axis) {
+                    const double low = m_min[axis];
+                    const double high = m_max[axis];
+                    for (int i = 0; i < size; ++i) { //one slab for every lane, vectorizes cleanly
+                        double t_0 = (low - rays.origin[axis][i]) * rays.inverse_direction[axis][i];
+                        double t_1 = (high - rays.origin[axis][i]) * rays.inverse_direction[axis][i];
+                        t_near[i] = maxNumber(minNumber(t_0, t_1), t_near[i]);
+                        t_far[i] = minNumber(maxNumber(t_0, t_1), t_far[i]);
+                    }
+                }
+                int mask = 0;
+                for (int i = 0; i < size; ++i) { mask |= (int) (t_near[i] <= t_far[i]) << i; }
+                return mask;
+            } //branchless slab test for a whole packet, limited by each lane's t_max. Returns a bit mask of the lanes that hit.
+
+        //PRINTING
+            friend auto operator<<(std::ostream &os, AABB const &box) -> std::ostream & {
+                return os << box.toString();
+            } //standard output overload
+            std::string toString() const {
+                return "[ " + m_min.toString() + " " + m_max.toString() + " ]";
+            }  //make box into string
+
+    private:
+        FixedVector<dimensions> m_min; //minimum corner
+        FixedVector<dimensions> m_max; //maximum corner
+        inline static double minNumber(double a, double b) { return a < b ? a : b; }
+        inline static double maxNumber(double a, double b) { return a > b ? a : b; }
+        //min and max that skip a NaN in the first argument(0 * infinity in the slab test), and compile to a single instruction
+    };
+
+    //helper names(easier typing for common uses)
+    typedef AABB<3> AABB3; //3d box
+    typedef AABB<2> AABB2; //2d box
+
+}
+
+#endif //TENSORMATH_AABB_HPP
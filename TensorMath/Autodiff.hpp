@@ -0,0 +1,336 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_AUTODIFF_HPP
+#define TENSORMATH_AUTODIFF_HPP
+
+#include "Functions.hpp"
+
+//reverse mode automatic differentiation
+//operations on Variables are recorded on a Tape, then backward() walks the tape from the end and accumulates the
+//gradient of a scalar result by every recorded value
+//values and gradients live in one arena owned by the tape and nodes in one list, both keep their memory across reset(),
+//so once the first training step has sized them, later steps with the same shapes do not allocate at all
+//every value is a column major matrix, vectors are one column
+
+namespace TensorMath {
+
+    class Tape;
+
+    //handle to a value recorded on a tape, cheap to copy
+    struct Variable {
+        Tape *tape;
+        int index; //node on the tape
+    };
+
+    namespace Autodiff {
+        //recorded operations
+        enum class Operation {
+            Input, Add, Subtract, Multiply, Hadamard, Scale, AddBias, Exp, Log, Sqrt, Sin, Cos, Tanh, Sigmoid, Relu, Sum,
+            Mean
+        };
+
+        //one recorded operation
+        struct Node {
+            Operation operation;
+            int a, b; //input nodes, -1 if unused
+            int width, height;
+            size_t offset; //values in the arena, the gradient follows them
+            double scalar; //factor for Scale
+        };
+    }
+
+    //recording of operations for reverse mode differentiation
+    class Tape {
+    public:
+        //CONSTRUCTORS
+            explicit Tape(size_t values = 0, int nodes = 0) {
+                m_arena.resize(values);
+                m_nodes.reserve(nodes);
+            } //tape with room for values doubles(values and gradients) and nodes operations before it has to grow
+            Tape(const Tape &other) = delete; //Variables point to their tape
+            Tape &operator=(const Tape &other) = delete;
+
+        //SETTERS AND GETTERS
+            int getNodeCount() const { return (int) m_nodes.size(); } //get number of recorded operations
+            size_t getArenaSize() const { return m_arena.size(); } //get doubles reserved for values and gradients
+            ConstMatrixView value(const Variable &variable) const {
+                assert(variable.tape == this); //variable from another tape
+                const Autodiff::Node &node = m_nodes[variable.index];
+                return ConstMatrixView::columnMajor(m_arena.data() + node.offset, node.width, node.height);
+            } //get the value of a variable. Valid until the next operation is recorded.
+            ConstMatrixView gradient(const Variable &variable) const {
+                assert(variable.tape == this); //variable from another tape
+                const Autodiff::Node &node = m_nodes[variable.index];
+                return ConstMatrixView::columnMajor(gradientData(node), node.width, node.height);
+            } //get the gradient of the last backward() result by a variable. Valid until the next operation is recorded.
+            double scalar(const Variable &variable) const {
+                assert(m_nodes[variable.index].width == 1 && m_nodes[variable.index].height == 1); //not a scalar
+                return value(variable).getValue(0, 0);
+            } //get the value of a 1 x 1 variable
+
+        //RECORDING
+            Variable input(const ConstMatrixView &value) {
+                Variable out = record(Autodiff::Operation::Input, -1, -1, value.getWidth(), value.getHeight());
+                view(out.index) = value;
+                return out;
+            } //record a value to differentiate by(parameters, inputs), copying it onto the tape. Not for views of this tape.
+            Variable input(const ConstVectorView &value) {
+                return input(ConstMatrixView(value.data(), 1, value.getDim(), value.getDim() * value.getStride(), value.getStride()));
+            } //record a vector, as one column
+            Variable record(Autodiff::Operation operation, int a, int b, int width, int height, double scalar = 0) {
+                size_t size = (size_t) width * height;
+                if (m_used + 2 * size > m_arena.size()) { m_arena.resize(std::max(m_used + 2 * size, 2 * m_arena.size())); }
+                m_nodes.push_back({operation, a, b, width, height, m_used, scalar});
+                m_used += 2 * size;
+                int index = (int) m_nodes.size() - 1;
+                if (operation != Autodiff::Operation::Input) { forward(index); }
+                return {this, index};
+            } //record an operation and compute its value, used by the Variable operations
+
+        //DIFFERENTIATING
+            void backward(const Variable &result) {
+                assert(result.tape == this); //variable from another tape
+                const Autodiff::Node &last = m_nodes[result.index];
+                assert(last.width == 1 && last.height == 1); //gradients are of one scalar
+                for (int i = 0; i <= result.index; ++i) {
+                    const Autodiff::Node &node = m_nodes[i];
+                    std::fill(gradientData(node), gradientData(node) + (size_t) node.width * node.height, 0.0);
+                }
+                gradientData(last)[0] = 1;
+                for (int i = result.index; i >= 0; --i) { backward(i); }
+            } //fill the gradient of result by every value recorded before it
+            void reset() {
+                m_nodes.clear();
+                m_used = 0;
+            } //forget all operations, keeping the memory for the next recording
+
+    private:
+        std::vector<double> m_arena; //values and gradients of all nodes
+        size_t m_used = 0; //doubles of the arena in use
+        std::vector<Autodiff::Node> m_nodes;
+        std::vector<double> m_packed; //transposed operand for product gradients
+        std::vector<double> m_product; //product before it is added to a gradient
+
+        double *valueData(const Autodiff::Node &node) { return m_arena.data() + node.offset; }
+        double *gradientData(const Autodiff::Node &node) {
+            return m_arena.data() + node.offset + (size_t) node.width * node.height;
+        }
+        const double *gradientData(const Autodiff::Node &node) const {
+            return m_arena.data() + node.offset + (size_t) node.width * node.height;
+        }
+        MatrixView view(int index) {
+            const Autodiff::Node &node = m_nodes[index];
+            return MatrixView::columnMajor(valueData(node), node.width, node.height);
+        } //values of a node
+
+        void forward(int index) {
+            using Autodiff::Operation;
+            const Autodiff::Node &node = m_nodes[index];
+            MatrixView out = view(index);
+            size_t size = (size_t) node.width * node.height;
+            double *values = out.data();
+            const double *a = node.a >= 0 ? valueData(m_nodes[node.a]) : nullptr;
+            const double *b = node.b >= 0 ? valueData(m_nodes[node.b]) : nullptr;
+            switch (node.operation) {
+                case Operation::Add: add(view(node.a), view(node.b), out); break;
+                case Operation::Subtract: subtract(view(node.a), view(node.b), out); break;
+                case Operation::Multiply: multiply(view(node.a), view(node.b), out); break;
+                case Operation::Hadamard: for (size_t i = 0; i < size; ++i) { values[i] = a[i] * b[i]; } break;
+                case Operation::Scale: for (size_t i = 0; i < size; ++i) { values[i] = a[i] * node.scalar; } break;
+                case Operation::AddBias:
+                    for (int x = 0; x < node.width; ++x) {
+                        for (int y = 0; y < node.height; ++y) { values[x * node.height + y] = a[x * node.height + y] + b[y]; }
+                    }
+                    break;
+                case Operation::Exp: exp(view(node.a), out); break;
+                case Operation::Log: log(view(node.a), out); break;
+                case Operation::Sqrt: sqrt(view(node.a), out); break;
+                case Operation::Sin: sin(view(node.a), out); break;
+                case Operation::Cos: cos(view(node.a), out); break;
+                case Operation::Tanh: tanh(view(node.a), out); break;
+                case Operation::Sigmoid: sigmoid(view(node.a), out); break;
+                case Operation::Relu: relu(view(node.a), out); break;
+                case Operation::Sum:
+                case Operation::Mean: {
+                    const Autodiff::Node &input = m_nodes[node.a];
+                    size_t count = (size_t) input.width * input.height;
+                    double sum = 0;
+                    for (size_t i = 0; i < count; ++i) { sum += a[i]; }
+                    values[0] = node.operation == Operation::Mean ? sum / (double) count : sum;
+                    break;
+                }
+                default: break;
+            }
+        } //compute the value of a node from its inputs
+
+        void backward(int index) {
+            using Autodiff::Operation;
+            const Autodiff::Node &node = m_nodes[index];
+            size_t size = (size_t) node.width * node.height;
+            const double *gradient = gradientData(node);
+            const double *values = valueData(node);
+            const double *a = node.a >= 0 ? valueData(m_nodes[node.a]) : nullptr;
+            const double *b = node.b >= 0 ? valueData(m_nodes[node.b]) : nullptr;
+            double *a_gradient = node.a >= 0 ? gradientData(m_nodes[node.a]) : nullptr;
+            double *b_gradient = node.b >= 0 ? gradientData(m_nodes[node.b]) : nullptr;
+            switch (node.operation) {
+                case Operation::Add:
+                    for (size_t i = 0; i < size; ++i) { a_gradient[i] += gradient[i]; }
+                    for (size_t i = 0; i < size; ++i) { b_gradient[i] += gradient[i]; }
+                    break;
+                case Operation::Subtract:
+                    for (size_t i = 0; i < size; ++i) { a_gradient[i] += gradient[i]; }
+                    for (size_t i = 0; i < size; ++i) { b_gradient[i] -= gradient[i]; }
+                    break;
+                case Operation::Multiply: {
+                    const Autodiff::Node &left = m_nodes[node.a], &right = m_nodes[node.b];
+                    int m = left.height, k = left.width, n = right.width;
+                    //gradient of a is gradient * b^T, gradient of b is a^T * gradient
+                    productInto(gradient, m, n, false, b, k, n, true, a_gradient);
+                    productInto(a, m, k, true, gradient, m, n, false, b_gradient);
+                    break;
+                }
+                case Operation::Hadamard:
+                    for (size_t i = 0; i < size; ++i) { a_gradient[i] += gradient[i] * b[i]; }
+                    for (size_t i = 0; i < size; ++i) { b_gradient[i] += gradient[i] * a[i]; }
+                    break;
+                case Operation::Scale:
+                    for (size_t i = 0; i < size; ++i) { a_gradient[i] += gradient[i] * node.scalar; }
+                    break;
+                case Operation::AddBias:
+                    for (size_t i = 0; i < size; ++i) { a_gradient[i] += gradient[i]; }
+                    for (int x = 0; x < node.width; ++x) { //bias is used by every column
+                        for (int y = 0; y < node.height; ++y) { b_gradient[y] += gradient[x * node.height + y]; }
+                    }
+                    break;
+                case Operation::Exp:
+                    for (size_t i = 0; i < size; ++i) { a_gradient[i] += gradient[i] * values[i]; }
+                    break;
+                case Operation::Log:
+                    for (size_t i = 0; i < size; ++i) { a_gradient[i] += gradient[i] / a[i]; }
+                    break;
+                case Operation::Sqrt:
+                    for (size_t i = 0; i < size; ++i) { a_gradient[i] += gradient[i] * 0.5 / values[i]; }
+                    break;
+                case Operation::Sin:
+                    for (size_t i = 0; i < size; ++i) { a_gradient[i] += gradient[i] * std::cos(a[i]); }
+                    break;
+                case Operation::Cos:
+                    for (size_t i = 0; i < size; ++i) { a_gradient[i] -= gradient[i] * std::sin(a[i]); }
+                    break;
+                case Operation::Tanh:
+                    for (size_t i = 0; i < size; ++i) { a_gradient[i] += gradient[i] * (1.0 - values[i] * values[i]); }
+                    break;
+                case Operation::Sigmoid:
+                    for (size_t i = 0; i < size; ++i) { a_gradient[i] += gradient[i] * values[i] * (1.0 - values[i]); }
+                    break;
+                case Operation::Relu:
+                    for (size_t i = 0; i < size; ++i) { a_gradient[i] += values[i] > 0 ? gradient[i] : 0.0; }
+                    break;
+                case Operation::Sum:
+                case Operation::Mean: {
+                    const Autodiff::Node &input = m_nodes[node.a];
+                    size_t count = (size_t) input.width * input.height;
+                    double each = node.operation == Operation::Mean ? gradient[0] / (double) count : gradient[0];
+                    for (size_t i = 0; i < count; ++i) { a_gradient[i] += each; }
+                    break;
+                }
+                default: break; //inputs have nothing to pass on
+            }
+        } //add the gradient of a node to the gradients of its inputs
+
+        void productInto(const double *a, int a_height, int a_width, bool transpose_a, const double *b, int b_height,
+                         int b_width, bool transpose_b, double *out) {
+            //one of the operands is transposed, pack it column major so the gemm kernel can use it
+            int m = transpose_a ? a_width : a_height;
+            int k = transpose_a ? a_height : a_width;
+            int n = transpose_b ? b_height : b_width;
+            assert(!(transpose_a && transpose_b)); //one packing buffer
+            ConstMatrixView a_view = ConstMatrixView::columnMajor(a, a_width, a_height);
+            ConstMatrixView b_view = ConstMatrixView::columnMajor(b, b_width, b_height);
+            ConstMatrixView a_used = transpose_a ? pack(a_view.transposed()) : a_view;
+            ConstMatrixView b_used = transpose_b ? pack(b_view.transposed()) : b_view;
+            if (m_product.size() < (size_t) m * n) { m_product.resize((size_t) m * n); }
+            kernels().gemm(m, n, k, a_used.data(), a_used.getColumnStride(), b_used.data(), b_used.getColumnStride(),
+                           m_product.data(), m);
+            for (size_t i = 0; i < (size_t) m * n; ++i) { out[i] += m_product[i]; }
+        } //out += a * b, with either operand transposed(column major, out is not packed)
+        ConstMatrixView pack(const ConstMatrixView &view) {
+            if (m_packed.size() < (size_t) view.getWidth() * view.getHeight()) {
+                m_packed.resize((size_t) view.getWidth() * view.getHeight());
+            }
+            MatrixView packed = MatrixView::columnMajor(m_packed.data(), view.getWidth(), view.getHeight());
+            packed = view;
+            return packed;
+        } //copy a view into the packing buffer, column major
+    };
+
+    //OPERATIONS
+    inline Variable operator+(const Variable &a, const Variable &b) {
+        assert(a.tape == b.tape); //variables from different tapes
+        ConstMatrixView a_value = a.tape->value(a), b_value = b.tape->value(b);
+        assert(a_value.getWidth() == b_value.getWidth() && a_value.getHeight() == b_value.getHeight()); //must be same size
+        return a.tape->record(Autodiff::Operation::Add, a.index, b.index, a_value.getWidth(), a_value.getHeight());
+    } //a + b
+    inline Variable operator-(const Variable &a, const Variable &b) {
+        assert(a.tape == b.tape); //variables from different tapes
+        ConstMatrixView a_value = a.tape->value(a), b_value = b.tape->value(b);
+        assert(a_value.getWidth() == b_value.getWidth() && a_value.getHeight() == b_value.getHeight()); //must be same size
+        return a.tape->record(Autodiff::Operation::Subtract, a.index, b.index, a_value.getWidth(), a_value.getHeight());
+    } //a - b
+    inline Variable operator*(const Variable &a, const Variable &b) {
+        assert(a.tape == b.tape); //variables from different tapes
+        ConstMatrixView a_value = a.tape->value(a), b_value = b.tape->value(b);
+        assert(a_value.getWidth() == b_value.getHeight()); //number of columns in a must be equal to # of rows in b
+        return a.tape->record(Autodiff::Operation::Multiply, a.index, b.index, b_value.getWidth(), a_value.getHeight());
+    } //matrix product a * b
+    inline Variable operator*(const Variable &a, double scalar) {
+        ConstMatrixView a_value = a.tape->value(a);
+        return a.tape->record(Autodiff::Operation::Scale, a.index, -1, a_value.getWidth(), a_value.getHeight(), scalar);
+    } //a * scalar
+    inline Variable operator*(double scalar, const Variable &a) { return a * scalar; } //scalar * a
+    inline Variable operator-(const Variable &a) { return a * -1.0; } //-a
+    inline Variable hadamard(const Variable &a, const Variable &b) {
+        assert(a.tape == b.tape); //variables from different tapes
+        ConstMatrixView a_value = a.tape->value(a), b_value = b.tape->value(b);
+        assert(a_value.getWidth() == b_value.getWidth() && a_value.getHeight() == b_value.getHeight()); //must be same size
+        return a.tape->record(Autodiff::Operation::Hadamard, a.index, b.index, a_value.getWidth(), a_value.getHeight());
+    } //component wise product
+    inline Variable addBias(const Variable &a, const Variable &bias) {
+        assert(a.tape == bias.tape); //variables from different tapes
+        ConstMatrixView a_value = a.tape->value(a), bias_value = bias.tape->value(bias);
+        assert(bias_value.getWidth() == 1 && bias_value.getHeight() == a_value.getHeight()); //one value per row
+        return a.tape->record(Autodiff::Operation::AddBias, a.index, bias.index, a_value.getWidth(), a_value.getHeight());
+    } //add a column to every column of a
+
+    //every elementwise function records the same way
+    #define TENSORMATH_AUTODIFF_ELEMENTWISE(name, operation) \
+        inline Variable name(const Variable &a) { \
+            ConstMatrixView a_value = a.tape->value(a); \
+            return a.tape->record(Autodiff::Operation::operation, a.index, -1, a_value.getWidth(), a_value.getHeight()); \
+        }
+
+    TENSORMATH_AUTODIFF_ELEMENTWISE(exp, Exp) //e^x
+    TENSORMATH_AUTODIFF_ELEMENTWISE(log, Log) //natural logarithm
+    TENSORMATH_AUTODIFF_ELEMENTWISE(sqrt, Sqrt) //square root
+    TENSORMATH_AUTODIFF_ELEMENTWISE(sin, Sin) //sine, radians
+    TENSORMATH_AUTODIFF_ELEMENTWISE(cos, Cos) //cosine, radians
+    TENSORMATH_AUTODIFF_ELEMENTWISE(tanh, Tanh) //hyperbolic tangent
+    TENSORMATH_AUTODIFF_ELEMENTWISE(sigmoid, Sigmoid) //logistic function
+    TENSORMATH_AUTODIFF_ELEMENTWISE(relu, Relu) //max(x, 0)
+
+    #undef TENSORMATH_AUTODIFF_ELEMENTWISE
+
+    //REDUCTIONS
+    inline Variable sum(const Variable &a) {
+        return a.tape->record(Autodiff::Operation::Sum, a.index, -1, 1, 1);
+    } //sum of all values, 1 x 1
+    inline Variable mean(const Variable &a) {
+        return a.tape->record(Autodiff::Operation::Mean, a.index, -1, 1, 1);
+    } //average of all values, 1 x 1
+
+}
+
+#endif //TENSORMATH_AUTODIFF_HPP
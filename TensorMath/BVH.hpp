@@ -0,0 +1,271 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_BVH_HPP
+#define TENSORMATH_BVH_HPP
+
+#include <vector>
+#include <future>
+#include <thread>
+#include <algorithm>
+#include "AABB.hpp"
+
+namespace TensorMath {
+
+    //bounding volume hierarchy over 3d boxes, for fast ray casts and overlap queries
+    //built top down with a binned surface area heuristic, large subtrees are built in parallel
+    //nodes are stored flat in depth first order: the left child of an inner node is always the next node,
+    //so only the right child index is stored and most traversal steps read the next cache line
+    class BVH {
+    public:
+        struct Node {
+            AABB3 bounds; //box around everything below this node
+            int offset; //leaf: first index into getIndices(), inner: index of right child
+            int count; //leaf: number of primitives, inner: 0
+            int axis; //inner: split axis, used to visit the nearer child first
+            bool isLeaf() const { return count > 0; }
+        };
+
+        //CONSTRUCTORS
+            explicit BVH(const std::vector<AABB3> &primitives, int max_leaf_size = 4) : m_max_leaf_size(max_leaf_size) {
+                assert(max_leaf_size > 0); //leaves need at least one primitive
+                int count = (int) primitives.size();
+                m_indices.resize(count);
+                m_centroids.resize(count);
+                for (int i = 0; i < count; ++i) {
+                    m_indices[i] = i;
+                    m_centroids[i] = primitives[i].center();
+                }
+                if (count > 0) {
+                    m_nodes.reserve(2 * count / max_leaf_size + 1);
+                    build(primitives, m_nodes, 0, count, 0);
+                }
+                m_centroids.clear(); //only needed while building
+                m_centroids.shrink_to_fit();
+            } //build a hierarchy over primitive boxes. Primitives are referred to by their index in the vector.
+
+        //SETTERS AND GETTERS
+            const std::vector<Node> &getNodes() const { return m_nodes; } //get the flattened nodes, root first
+            const std::vector<int> &getIndices() const { return m_indices; } //get primitive indices in leaf order
+            int getNodeCount() const { return (int) m_nodes.size(); } //get number of nodes
+            int getDepth() const { return m_nodes.empty() ? 0 : depth(0); } //get the longest path from root to leaf
+            AABB3 getBounds() const { return m_nodes.empty() ? AABB3() : m_nodes[0].bounds; } //get box around everything
+
+        //QUERIES
+            //intersect is called as bool intersect(int primitive, const Ray& ray, double t_max, double& t)
+            //and should return true and set t if the primitive is hit closer than t_max
+            template<class Intersector>
+            bool closestHit(const Ray &ray, double &t, int &primitive, Intersector intersect,
+                            double t_max = std::numeric_limits<double>::infinity()) const {
+                bool hit = false;
+                traverse(ray, t_max, [&](int index, double closest) {
+                    double t_hit;
+                    if (intersect(index, ray, closest, t_hit) && t_hit < closest) {
+                        t = t_hit;
+                        primitive = index;
+                        hit = true;
+                        return t_hit; //shorten the ray
+                    }
+                    return closest;
+                });
+                return hit;
+            } //find the closest primitive hit by a ray. Sets t and primitive on hit.
+            template<class Intersector>
+            bool anyHit(const Ray &ray, Intersector intersect,
+                        double t_max = std::numeric_limits<double>::infinity()) const {
+                bool hit = false;
+                traverse(ray, t_max, [&](int index, double closest) {
+                    double t_hit;
+                    if (intersect(index, ray, closest, t_hit) && t_hit < closest) {
+                        hit = true;
+                        return -1.0; //a negative distance stops the traversal
+                    }
+                    return closest;
+                });
+                return hit;
+            } //check if a ray hits anything before t_max(shadow rays, visibility). Stops at the first hit.
+            template<class Callback>
+            void overlapping(const AABB3 &box, Callback callback) const {
+                if (m_nodes.empty()) { return; }
+                int stack[STACK_SIZE];
+                int stack_size = 0;
+                int current = 0;
+                while (true) {
+                    const Node &node = m_nodes[current];
+                    if (node.bounds.overlaps(box)) {
+                        if (node.isLeaf()) {
+                            for (int i = node.offset; i < node.offset + node.count; ++i) { callback(m_indices[i]); }
+                        } else {
+                            assert(stack_size < STACK_SIZE); //tree too deep
+                            stack[stack_size++] = node.offset;
+                            current = current + 1;
+                            continue;
+                        }
+                    }
+                    if (stack_size == 0) { break; }
+                    current = stack[--stack_size];
+                }
+            } //call callback(int primitive) for every primitive box that overlaps a box(collision broad phase)
+
+    private:
+        static constexpr int BIN_COUNT = 16; //number of SAH buckets per axis
+        static constexpr int STACK_SIZE = 64; //traversal stack size, trees are never built deeper than this
+        static constexpr int PARALLEL_THRESHOLD = 4096; //smallest subtree that is built on its own thread
+        static constexpr double TRAVERSAL_COST = 1.0; //cost of visiting a node relative to testing a primitive
+
+        std::vector<Node> m_nodes; //flattened tree
+        std::vector<int> m_indices; //primitive indices, each leaf owns a range
+        std::vector<Vector3> m_centroids; //primitive centers, used while building
+        int m_max_leaf_size;
+
+        void build(const std::vector<AABB3> &primitives, std::vector<Node> &nodes, int begin, int end, int level) {
+            int node_index = (int) nodes.size();
+            nodes.push_back(Node());
+            AABB3 bounds;
+            AABB3 centroid_bounds;
+            for (int i = begin; i < end; ++i) {
+                bounds.expand(primitives[m_indices[i]]);
+                centroid_bounds.expand(m_centroids[m_indices[i]]);
+            }
+            nodes[node_index].bounds = bounds;
+            int count = end - begin;
+            int axis;
+            int middle = level < STACK_SIZE - 1 ? split(primitives, bounds, centroid_bounds, begin, end, axis) : -1;
+            if (middle < 0) { //cheaper as a leaf
+                nodes[node_index].offset = begin;
+                nodes[node_index].count = count;
+                nodes[node_index].axis = 0;
+                return;
+            }
+            nodes[node_index].count = 0;
+            nodes[node_index].axis = axis;
+            //the ranges are disjoint, so big subtrees can be built at the same time into their own node lists
+            if (count >= PARALLEL_THRESHOLD && (1 << level) < (int) std::thread::hardware_concurrency()) {
+                std::vector<Node> left_nodes;
+                std::future<void> left = std::async(std::launch::async, [&] {
+                    build(primitives, left_nodes, begin, middle, level + 1);
+                });
+                std::vector<Node> right_nodes;
+                build(primitives, right_nodes, middle, end, level + 1);
+                left.get();
+                append(nodes, left_nodes);
+                nodes[node_index].offset = (int) nodes.size();
+                append(nodes, right_nodes);
+            } else {
+                build(primitives, nodes, begin, middle, level + 1);
+                nodes[node_index].offset = (int) nodes.size();
+                build(primitives, nodes, middle, end, level + 1);
+            }
+        } //recursively build node for primitive range [begin, end)
+
+        int split(const std::vector<AABB3> &primitives, const AABB3 &bounds, const AABB3 &centroid_bounds, int begin,
+                  int end, int &best_axis) {
+            int count = end - begin;
+            if (count <= 1) { return -1; }
+            double best_cost = std::numeric_limits<double>::infinity();
+            int best_bin = -1;
+            best_axis = 0;
+            for (int axis = 0; axis < 3; ++axis) {
+                double low = centroid_bounds.getMin()[axis];
+                double high = centroid_bounds.getMax()[axis];
+                if (high <= low) { continue; } //all centers on a plane
+                double scale = BIN_COUNT / (high - low);
+                AABB3 bin_bounds[BIN_COUNT];
+                int bin_counts[BIN_COUNT] = {};
+                for (int i = begin; i < end; ++i) {
+                    int bin = std::min(BIN_COUNT - 1, (int) ((m_centroids[m_indices[i]][axis] - low) * scale));
+                    bin_counts[bin]++;
+                    bin_bounds[bin].expand(primitives[m_indices[i]]);
+                }
+                //sweep from the right to get the cost of every right side, then from the left
+                double right_area[BIN_COUNT];
+                int right_count[BIN_COUNT];
+                AABB3 accumulated;
+                int accumulated_count = 0;
+                for (int bin = BIN_COUNT - 1; bin > 0; --bin) {
+                    accumulated.expand(bin_bounds[bin]);
+                    accumulated_count += bin_counts[bin];
+                    right_area[bin] = accumulated.surfaceArea();
+                    right_count[bin] = accumulated_count;
+                }
+                accumulated = AABB3();
+                accumulated_count = 0;
+                for (int bin = 0; bin < BIN_COUNT - 1; ++bin) {
+                    accumulated.expand(bin_bounds[bin]);
+                    accumulated_count += bin_counts[bin];
+                    if (accumulated_count == 0 || right_count[bin + 1] == 0) { continue; }
+                    double cost = accumulated.surfaceArea() * accumulated_count + right_area[bin + 1] * right_count[bin + 1];
+                    if (cost < best_cost) {
+                        best_cost = cost;
+                        best_bin = bin;
+                        best_axis = axis;
+                    }
+                }
+            }
+            double parent_area = bounds.surfaceArea();
+            double leaf_cost = count;
+            double split_cost = TRAVERSAL_COST + (parent_area > 0 ? best_cost / parent_area : 0);
+            if (best_bin < 0) { //all centers in one spot, no split helps
+                best_axis = 0;
+                return count > m_max_leaf_size ? begin + count / 2 : -1;
+            }
+            if (count <= m_max_leaf_size && split_cost >= leaf_cost) { return -1; }
+            //partition the indices around the chosen bin
+            double low = centroid_bounds.getMin()[best_axis];
+            double scale = BIN_COUNT / (centroid_bounds.getMax()[best_axis] - low);
+            int *middle = std::partition(m_indices.data() + begin, m_indices.data() + end, [&](int index) {
+                return std::min(BIN_COUNT - 1, (int) ((m_centroids[index][best_axis] - low) * scale)) <= best_bin;
+            });
+            return (int) (middle - m_indices.data());
+        } //pick the cheapest split with binned SAH and partition the range. Returns the middle index, or -1 for a leaf.
+
+        static void append(std::vector<Node> &nodes, const std::vector<Node> &subtree) {
+            int base = (int) nodes.size();
+            for (Node node: subtree) {
+                if (!node.isLeaf()) { node.offset += base; } //child indices were relative to the subtree
+                nodes.push_back(node);
+            }
+        } //move a separately built subtree to the end of the node list
+
+        int depth(int index) const {
+            const Node &node = m_nodes[index];
+            if (node.isLeaf()) { return 1; }
+            return 1 + std::max(depth(index + 1), depth(node.offset));
+        } //depth below a node
+
+        template<class Visitor>
+        void traverse(const Ray &ray, double t_max, Visitor visit) const {
+            if (m_nodes.empty()) { return; }
+            int stack[STACK_SIZE];
+            int stack_size = 0;
+            int current = 0;
+            while (true) {
+                const Node &node = m_nodes[current];
+                double t_near;
+                if (node.bounds.intersect(ray, t_near, 0, t_max)) {
+                    if (node.isLeaf()) {
+                        for (int i = node.offset; i < node.offset + node.count; ++i) {
+                            t_max = visit(m_indices[i], t_max);
+                            if (t_max < 0) { return; }
+                        }
+                    } else {
+                        //go to the child on the side the ray comes from first, the other one waits on the stack
+                        bool backwards = ray.getDirection()[node.axis] < 0;
+                        int first = backwards ? node.offset : current + 1;
+                        int second = backwards ? current + 1 : node.offset;
+                        assert(stack_size < STACK_SIZE); //tree too deep
+                        stack[stack_size++] = second;
+                        current = first;
+                        continue;
+                    }
+                }
+                if (stack_size == 0) { break; }
+                current = stack[--stack_size];
+            }
+        } //walk the tree front to back with a short fixed size stack. visit(primitive, t_max) returns the new t_max.
+    };
+
+}
+
+#endif //TENSORMATH_BVH_HPP
@@ -0,0 +1,65 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_BATCH_HPP
+#define TENSORMATH_BATCH_HPP
+
+#include "View.hpp"
+#include "Parallel.hpp"
+
+//batched matrix products: many independent small products in one call
+//the kernel table is read once, common row counts(4, 8, 16, 32) use unrolled kernels that keep several columns
+//of the output in registers, and the batch is split across the thread pool when the total work is large enough
+
+namespace TensorMath {
+
+    inline void multiplyBatch(int m, int n, int k, const double *a, long long stride_a, const double *b,
+                              long long stride_b, double *out, long long stride_out, int count) {
+        assert(m > 0 && n > 0 && k > 0 && count >= 0); //too small sizes
+        TENSORMATH_TIME(Multiply);
+        TENSORMATH_COUNT_FLOPS(2 * (uint64_t) m * n * k * count);
+        TENSORMATH_TRACE_SCOPE("multiplyBatch", m, n, k, 2 * (uint64_t) m * n * k * count);
+        const KernelTable &table = kernels();
+        parallelFor((size_t) count, [&](size_t begin, size_t end) {
+            table.gemmBatch(m, n, k, a + begin * stride_a, m, stride_a, b + begin * stride_b, k, stride_b,
+                            out + begin * stride_out, m, stride_out, (int) (end - begin));
+        }, (size_t) m * n * k);
+    } //out[i] = a[i] * b[i] for count packed column major products, a is m x k, b is k x n, out is m x n.
+      //item i of each array starts stride values after item i - 1, so the batch can sit in one buffer.
+
+    inline void multiplyBatch(int m, int n, int k, const double *a, const double *b, double *out, int count) {
+        multiplyBatch(m, n, k, a, (long long) m * k, b, (long long) k * n, out, (long long) m * n, count);
+    } //count packed column major products stored back to back
+
+    inline void multiplyBatch(const ConstMatrixView *a, const ConstMatrixView *b, const MatrixView *out, int count) {
+        if (count <= 0) { return; }
+        TENSORMATH_TIME(Multiply);
+        TENSORMATH_TRACE_SCOPE("multiplyBatch", a[0].getHeight(), b[0].getWidth(), a[0].getWidth(), 0); //sizes of the first
+        #ifdef TENSORMATH_INSTRUMENT
+            for (int i = 0; i < count; ++i) { //other layouts count in multiply()
+                if (a[i].isColumnMajor() && b[i].isColumnMajor() && out[i].isColumnMajor()) {
+                    TENSORMATH_COUNT_FLOPS(2 * (uint64_t) a[i].getHeight() * b[i].getWidth() * a[i].getWidth());
+                }
+            }
+        #endif
+        const KernelTable &table = kernels();
+        size_t cost = (size_t) a[0].getHeight() * a[0].getWidth() * b[0].getWidth(); //estimate from the first product
+        parallelFor((size_t) count, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                assert(a[i].getWidth() == b[i].getHeight()); //number of columns in a must be equal to # of rows in b
+                assert(out[i].getWidth() == b[i].getWidth() && out[i].getHeight() == a[i].getHeight()); //output must be result size
+                if (a[i].isColumnMajor() && b[i].isColumnMajor() && out[i].isColumnMajor()) {
+                    table.gemmBatch(a[i].getHeight(), b[i].getWidth(), a[i].getWidth(), a[i].data(),
+                                    a[i].getColumnStride(), 0, b[i].data(), b[i].getColumnStride(), 0, out[i].data(),
+                                    out[i].getColumnStride(), 0, 1);
+                } else {
+                    multiply(a[i], b[i], out[i]); //other layouts are packed
+                }
+            }
+        }, cost);
+    } //out[i] = a[i] * b[i] for count views of any size and layout. Outputs must not overlap inputs.
+
+}
+
+#endif //TENSORMATH_BATCH_HPP
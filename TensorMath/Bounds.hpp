@@ -0,0 +1,55 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_BOUNDS_HPP
+#define TENSORMATH_BOUNDS_HPP
+
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+//bounds checking of element access(getValue, setValue, operator[], column() and row() of vectors, matrices and views)
+//TENSORMATH_BOUNDS picks what those checks do, for the whole program(define it before including, or -DTENSORMATH_BOUNDS=...)
+//  TENSORMATH_BOUNDS_ASSERT(default): assert, so nothing is checked with NDEBUG
+//  TENSORMATH_BOUNDS_THROW: throw std::out_of_range, also in release builds
+//  TENSORMATH_BOUNDS_NONE: never check, also in debug and instrumented builds
+//at() always checks and throws, and atUnchecked() never checks, whatever the policy
+//loops inside the library use unchecked access, so the policy only costs in user code
+//negative indices are out of range too
+
+#define TENSORMATH_BOUNDS_NONE 0
+#define TENSORMATH_BOUNDS_ASSERT 1
+#define TENSORMATH_BOUNDS_THROW 2
+#ifndef TENSORMATH_BOUNDS
+    #define TENSORMATH_BOUNDS TENSORMATH_BOUNDS_ASSERT
+#endif
+
+namespace TensorMath {
+
+    namespace Bounds {
+        inline bool inRange(int i, int size) {
+            return (unsigned) i < (unsigned) size; //negative indices wrap to huge ones
+        } //check if 0 <= i < size
+
+        [[noreturn]] inline void fail(int i, int size) {
+            throw std::out_of_range("TensorMath: index " + std::to_string(i) + " is out of range [0, " +
+                                    std::to_string(size) + ")");
+        } //report a bad index
+
+        inline void check(int i, int size) {
+            if (!inRange(i, size)) { fail(i, size); }
+        } //throw std::out_of_range unless 0 <= i < size
+    }
+
+    #if TENSORMATH_BOUNDS == TENSORMATH_BOUNDS_THROW
+        #define TENSORMATH_CHECK_INDEX(i, size) ::TensorMath::Bounds::check(i, size)
+    #elif TENSORMATH_BOUNDS == TENSORMATH_BOUNDS_ASSERT
+        #define TENSORMATH_CHECK_INDEX(i, size) assert(::TensorMath::Bounds::inRange(i, size)) //index out of range
+    #else
+        #define TENSORMATH_CHECK_INDEX(i, size) ((void) 0)
+    #endif
+
+}
+
+#endif //TENSORMATH_BOUNDS_HPP
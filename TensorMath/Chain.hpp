@@ -0,0 +1,125 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_CHAIN_HPP
+#define TENSORMATH_CHAIN_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Matrix.hpp"
+
+//products of several matrices in the cheapest order
+//(A * B) * C and A * (B * C) are the same matrix, but for different shapes the work can differ by orders of magnitude:
+//10x100 * 100x5 * 5x50 is 7500 multiply adds one way and 75000 the other. Left to right operator* is just one order.
+//the cheapest order is found by dynamic programming on the sizes(O(n^3) for n matrices, nothing next to the products),
+//then all intermediates get one buffer kept between calls, and each product goes through the same multiply as Matrix
+
+namespace TensorMath {
+
+    //cheapest order of a chain of products
+    struct ChainPlan {
+        int count = 0; //matrices in the chain
+        std::vector<int> splits; //splits[i * count + j]: the chain i..j is (i..split) * (split + 1..j)
+        uint64_t cost = 0; //multiply adds of the whole chain in this order
+
+        int getSplit(int first, int last) const { return splits[first * count + last]; } //where a sub chain splits
+        std::string toString() const { return count == 0 ? "" : toString(0, count - 1); } //order like ((0 1) 2)
+        std::string toString(int first, int last) const {
+            if (first == last) { return std::to_string(first); }
+            int split = getSplit(first, last);
+            return "(" + toString(first, split) + " " + toString(split + 1, last) + ")";
+        } //order of a sub chain
+    };
+
+    namespace Chain {
+        inline std::vector<double> &workspace() {
+            thread_local std::vector<double> buffer;
+            return buffer;
+        } //intermediates kept between chains, so repeated chains do not allocate
+
+        inline size_t size(const std::vector<ConstMatrixView> &matrices, int first, int last) {
+            return (size_t) matrices[first].getHeight() * matrices[last].getWidth();
+        } //values in the product of a sub chain
+
+        inline size_t place(const ChainPlan &plan, const std::vector<ConstMatrixView> &matrices, int first, int last,
+                            size_t offset, std::vector<size_t> &offsets) {
+            if (first == last) { return offset; }
+            int split = plan.getSplit(first, last);
+            offset = place(plan, matrices, first, split, offset, offsets);
+            offset = place(plan, matrices, split + 1, last, offset, offsets);
+            offsets[first * plan.count + last] = offset;
+            return offset + size(matrices, first, last);
+        } //give every intermediate of a sub chain its place in the workspace, returns the end
+
+        inline void run(const ChainPlan &plan, const std::vector<ConstMatrixView> &matrices, int first, int last,
+                        const std::vector<size_t> &offsets, MatrixView out) {
+            int split = plan.getSplit(first, last);
+            auto operand = [&](int from, int to) {
+                if (from == to) { return matrices[from]; }
+                MatrixView part = MatrixView::columnMajor(workspace().data() + offsets[from * plan.count + to],
+                                                          matrices[to].getWidth(), matrices[from].getHeight());
+                run(plan, matrices, from, to, offsets, part);
+                return ConstMatrixView(part);
+            };
+            ConstMatrixView left = operand(first, split);
+            ConstMatrixView right = operand(split + 1, last);
+            multiplyInto(left, right, out);
+        } //compute a sub chain of at least two matrices into out
+    }
+
+    inline ChainPlan planChain(const std::vector<ConstMatrixView> &matrices) {
+        ChainPlan plan;
+        int count = plan.count = (int) matrices.size();
+        for (int i = 0; i + 1 < count; ++i) {
+            assert(matrices[i].getWidth() == matrices[i + 1].getHeight()); //each width must be the next height
+        }
+        plan.splits.assign((size_t) count * count, 0);
+        std::vector<uint64_t> costs((size_t) count * count, 0); //cheapest cost of each sub chain
+        for (int length = 2; length <= count; ++length) {
+            for (int first = 0; first + length <= count; ++first) {
+                int last = first + length - 1;
+                uint64_t best = UINT64_MAX;
+                for (int split = first; split < last; ++split) {
+                    uint64_t cost = costs[first * count + split] + costs[(split + 1) * count + last] +
+                                    (uint64_t) matrices[first].getHeight() * matrices[split].getWidth() * matrices[last].getWidth();
+                    if (cost < best) {
+                        best = cost;
+                        plan.splits[first * count + last] = split;
+                    }
+                }
+                costs[first * count + last] = best;
+            }
+        }
+        plan.cost = count == 0 ? 0 : costs[count - 1];
+        return plan;
+    } //find the cheapest order to multiply a chain of matrices
+
+    inline void multiplyChain(const std::vector<ConstMatrixView> &matrices, MatrixView out) {
+        assert(!matrices.empty()); //nothing to multiply
+        assert(out.getWidth() == matrices.back().getWidth() && out.getHeight() == matrices.front().getHeight()); //output must be result size
+        if (matrices.size() == 1) {
+            out = matrices[0];
+            return;
+        }
+        ChainPlan plan = planChain(matrices);
+        TENSORMATH_TRACE_SCOPE("multiplyChain", out.getHeight(), out.getWidth(), matrices.size(), 2 * plan.cost);
+        std::vector<size_t> offsets(plan.splits.size());
+        int last = plan.count - 1, split = plan.getSplit(0, last);
+        size_t end = Chain::place(plan, matrices, 0, split, 0, offsets); //the result itself goes into out
+        end = Chain::place(plan, matrices, split + 1, last, end, offsets);
+        if (Chain::workspace().size() < end) { Chain::workspace().resize(end); } //once, for every intermediate
+        Chain::run(plan, matrices, 0, last, offsets, out);
+    } //out = matrices[0] * matrices[1] * ... in the cheapest order. out must not overlap the matrices.
+
+    inline Matrix multiplyChain(const std::vector<ConstMatrixView> &matrices) {
+        assert(!matrices.empty()); //nothing to multiply
+        Matrix out(matrices.back().getWidth(), matrices.front().getHeight());
+        multiplyChain(matrices, out.view());
+        return out;
+    } //product of a chain of matrices or views in the cheapest order, multiplyChain({a, b, c})
+
+}
+
+#endif //TENSORMATH_CHAIN_HPP
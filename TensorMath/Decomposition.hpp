@@ -0,0 +1,384 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_DECOMPOSITION_HPP
+#define TENSORMATH_DECOMPOSITION_HPP
+
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+#include "Matrix.hpp"
+#include "FixedMatrix.hpp"
+
+//eigen decomposition of symmetric matrices and singular value decomposition of any matrix
+//symmetric: Householder reduction to tridiagonal form, then implicit QL with Wilkinson shifts(the tred2/tql2 pair of
+//EISPACK). Both are O(n^3). Each Householder step updates its columns on the thread pool, and the rotations of a QL
+//sweep are applied to the eigenvectors together, a block of rows per thread, instead of one rotation at a time.
+//SVD: one sided Jacobi(Hestenes). Columns are rotated in pairs until they are all orthogonal, the pairs of a round are
+//disjoint(round robin order), so a round runs on the thread pool. Slower than bidiagonalization for large matrices,
+//but simple, and accurate to the last bits for small singular values too.
+//3x3 symmetric FixedMatrices have a closed form(Smith's trigonometric eigenvalues, eigenvectors from cross products)
+//with no iteration and no allocation, for normals of point neighborhoods and other per point work
+
+namespace TensorMath {
+
+    //eigenvalues and eigenvectors of a symmetric matrix
+    struct Eigensystem {
+        Vector values; //ascending
+        Matrix vectors; //one unit eigenvector per column, in the order of values
+        bool converged; //false if the iteration limit was hit, results are then approximate
+    };
+
+    //a = u * diagonal(values) * v^T
+    struct SingularValueDecomposition {
+        Matrix u; //height of a x min(width, height) of a, orthonormal columns
+        Vector values; //min(width, height) of a, descending, not negative
+        Matrix v; //width of a x min(width, height) of a, orthonormal columns
+        bool converged; //false if the iteration limit was hit, results are then approximate
+    };
+
+    namespace Decomposition {
+        constexpr int MAX_ITERATIONS = 60; //QL iterations per eigenvalue, usually 2 or 3
+        constexpr int MAX_SWEEPS = 60; //Jacobi sweeps, usually under 10
+        constexpr size_t COST = 4; //a rotation or update step costs about as much as this many additions, for parallelFor
+
+        inline void tridiagonalize(std::vector<double> &work, int n, std::vector<double> &diagonal,
+                                   std::vector<double> &off_diagonal, std::vector<double> &q) {
+            std::vector<double> betas(n, 0.0), p(n), w(n);
+            const KernelTable &table = kernels();
+            for (int k = 0; k + 2 < n; ++k) {
+                int size = n - k - 1;
+                double *v = work.data() + (size_t) k * n + k + 1; //column k below the diagonal, becomes the reflector
+                double norm = std::sqrt(table.dot(v, v, size));
+                if (norm == 0) { continue; } //already tridiagonal here
+                double alpha = v[0] > 0 ? -norm : norm;
+                double beta = 1.0 / (norm * (norm + std::abs(v[0]))); //2 / v^T v
+                v[0] -= alpha;
+                betas[k] = beta;
+                off_diagonal[k] = alpha;
+                double *lower = work.data() + (size_t) (k + 1) * n + k + 1; //trailing block, rows and columns > k
+                parallelFor((size_t) size, [&](size_t begin, size_t end) {
+                    for (size_t j = begin; j < end; ++j) { p[j] = beta * table.dot(lower + j * n, v, size); }
+                }, size * COST);
+                double scale = 0.5 * beta * table.dot(p.data(), v, size);
+                for (int i = 0; i < size; ++i) { w[i] = p[i] - scale * v[i]; }
+                parallelFor((size_t) size, [&](size_t begin, size_t end) {
+                    for (size_t j = begin; j < end; ++j) { //lower -= v w^T + w v^T
+                        double *column = lower + j * n;
+                        double vj = v[j], wj = w[j];
+                        for (int i = 0; i < size; ++i) { column[i] -= v[i] * wj + w[i] * vj; }
+                    }
+                }, size * COST);
+            }
+            for (int k = 0; k < n; ++k) { diagonal[k] = work[(size_t) k * n + k]; }
+            if (n > 1) { off_diagonal[n - 2] = work[(size_t) (n - 2) * n + n - 1]; }
+            q.assign((size_t) n * n, 0.0);
+            for (int k = 0; k < n; ++k) { q[(size_t) k * n + k] = 1; }
+            for (int k = n - 3; k >= 0; --k) { //q = H0 * H1 * ..., from the last reflector back
+                if (betas[k] == 0) { continue; }
+                int size = n - k - 1;
+                const double *v = work.data() + (size_t) k * n + k + 1;
+                parallelFor((size_t) size, [&](size_t begin, size_t end) {
+                    for (size_t j = begin; j < end; ++j) {
+                        double *column = q.data() + (k + 1 + j) * n + k + 1;
+                        double scale = betas[k] * table.dot(v, column, size);
+                        for (int i = 0; i < size; ++i) { column[i] -= scale * v[i]; }
+                    }
+                }, size * COST);
+            }
+        } //a = q * t * q^T, t tridiagonal. work holds a(column major, both triangles) and is overwritten.
+
+        inline bool diagonalize(std::vector<double> &diagonal, std::vector<double> &off_diagonal, std::vector<double> &q,
+                                int n) {
+            const double epsilon = std::numeric_limits<double>::epsilon();
+            std::vector<double> cosines(n), sines(n);
+            off_diagonal[n - 1] = 0;
+            double shift = 0, largest = 0;
+            bool converged = true;
+            for (int l = 0; l < n; ++l) {
+                largest = std::max(largest, std::abs(diagonal[l]) + std::abs(off_diagonal[l]));
+                int m = l;
+                while (std::abs(off_diagonal[m]) > epsilon * largest) { ++m; } //off_diagonal[n - 1] is 0
+                for (int iteration = 0; m > l; ++iteration) {
+                    if (iteration == MAX_ITERATIONS) {
+                        converged = false;
+                        break;
+                    }
+                    double g = diagonal[l];
+                    double p = (diagonal[l + 1] - g) / (2.0 * off_diagonal[l]);
+                    double r = std::hypot(p, 1.0);
+                    if (p < 0) { r = -r; }
+                    diagonal[l] = off_diagonal[l] / (p + r);
+                    diagonal[l + 1] = off_diagonal[l] * (p + r);
+                    double next = diagonal[l + 1];
+                    double h = g - diagonal[l];
+                    for (int i = l + 2; i < n; ++i) { diagonal[i] -= h; }
+                    shift += h;
+                    p = diagonal[m];
+                    double c = 1, c2 = 1, c3 = 1, s = 0, s2 = 0;
+                    double el1 = off_diagonal[l + 1];
+                    for (int i = m - 1; i >= l; --i) {
+                        c3 = c2;
+                        c2 = c;
+                        s2 = s;
+                        g = c * off_diagonal[i];
+                        h = c * p;
+                        r = std::hypot(p, off_diagonal[i]);
+                        off_diagonal[i + 1] = s * r;
+                        s = off_diagonal[i] / r;
+                        c = p / r;
+                        p = c * diagonal[i] - s * g;
+                        diagonal[i + 1] = h + s * (c * g + s * diagonal[i]);
+                        cosines[i] = c;
+                        sines[i] = s;
+                    }
+                    parallelFor((size_t) n, [&](size_t begin, size_t end) { //all rotations of the sweep, row block by row block
+                        for (int i = m - 1; i >= l; --i) {
+                            double *left = q.data() + (size_t) i * n, *right = left + n;
+                            double ci = cosines[i], si = sines[i];
+                            for (size_t k = begin; k < end; ++k) {
+                                double value = right[k];
+                                right[k] = si * left[k] + ci * value;
+                                left[k] = ci * left[k] - si * value;
+                            }
+                        }
+                    }, (size_t) (m - l) * COST);
+                    p = -s * s2 * c3 * el1 * off_diagonal[l] / next;
+                    off_diagonal[l] = s * p;
+                    diagonal[l] = c * p;
+                    if (std::abs(off_diagonal[l]) <= epsilon * largest) { break; }
+                }
+                diagonal[l] += shift;
+                off_diagonal[l] = 0;
+            }
+            return converged;
+        } //eigenvalues of a tridiagonal matrix into diagonal, rotations applied to the columns of q
+
+        inline void sortColumns(double *values, int count, double *columns, int rows, bool descending) {
+            for (int i = 0; i < count; ++i) { //selection sort, one column swap per value
+                int best = i;
+                for (int j = i + 1; j < count; ++j) {
+                    if (descending ? values[j] > values[best] : values[j] < values[best]) { best = j; }
+                }
+                if (best == i) { continue; }
+                std::swap(values[i], values[best]);
+                std::swap_ranges(columns + (size_t) i * rows, columns + (size_t) (i + 1) * rows, columns + (size_t) best * rows);
+            }
+        } //sort values and their columns(column major, rows long)
+
+        inline bool rotate(double *a, double *b, double *v, double *w, int rows, int size) {
+            const KernelTable &table = kernels();
+            double alpha = table.dot(a, a, rows), beta = table.dot(b, b, rows), gamma = table.dot(a, b, rows);
+            if (std::abs(gamma) <= std::numeric_limits<double>::epsilon() * rows * std::sqrt(alpha * beta)) { return false; }
+            double zeta = (beta - alpha) / (2 * gamma);
+            double t = (zeta >= 0 ? 1.0 : -1.0) / (std::abs(zeta) + std::sqrt(1 + zeta * zeta));
+            double c = 1 / std::sqrt(1 + t * t), s = c * t;
+            for (int i = 0; i < rows; ++i) {
+                double x = a[i], y = b[i];
+                a[i] = c * x - s * y;
+                b[i] = s * x + c * y;
+            }
+            for (int i = 0; i < size; ++i) {
+                double x = v[i], y = w[i];
+                v[i] = c * x - s * y;
+                w[i] = s * x + c * y;
+            }
+            return true;
+        } //make columns a and b orthogonal, the same rotation on columns v and w. false if they already are.
+
+        inline FixedVector<3> eigenvector(const FixedMatrix<3, 3> &a, double value) {
+            FixedVector<3> row0(a.getValue(0, 0) - value, a.getValue(1, 0), a.getValue(2, 0));
+            FixedVector<3> row1(a.getValue(0, 1), a.getValue(1, 1) - value, a.getValue(2, 1));
+            FixedVector<3> row2(a.getValue(0, 2), a.getValue(1, 2), a.getValue(2, 2) - value);
+            FixedVector<3> crosses[3] = {row0.crossProduct(row1), row0.crossProduct(row2), row1.crossProduct(row2)};
+            int best = 0;
+            double lengths[3];
+            for (int i = 0; i < 3; ++i) {
+                lengths[i] = crosses[i].lengthSquared();
+                if (lengths[i] > lengths[best]) { best = i; }
+            }
+            if (lengths[best] == 0) { return FixedVector<3>(1, 0, 0); } //a is value * identity
+            return crosses[best] * (1.0 / std::sqrt(lengths[best]));
+        } //unit eigenvector of a single eigenvalue, perpendicular to the rows of a - value * identity
+
+        inline FixedVector<3> eigenvector(const FixedMatrix<3, 3> &a, const FixedVector<3> &known, double value) {
+            FixedVector<3> u = std::abs(known[0]) > std::abs(known[1]) ?
+                               FixedVector<3>(-known[2], 0, known[0]) * (1.0 / std::sqrt(known[0] * known[0] + known[2] * known[2])) :
+                               FixedVector<3>(0, known[2], -known[1]) * (1.0 / std::sqrt(known[1] * known[1] + known[2] * known[2]));
+            FixedVector<3> v = known.crossProduct(u); //u, v span the plane perpendicular to known
+            auto product = [&](const FixedVector<3> &x) {
+                FixedVector<3> out;
+                for (int y = 0; y < 3; ++y) {
+                    out[y] = a.getValue(0, y) * x[0] + a.getValue(1, y) * x[1] + a.getValue(2, y) * x[2];
+                }
+                return out;
+            };
+            double m00 = u.dotProduct(product(u)) - value, m01 = u.dotProduct(product(v)), m11 = v.dotProduct(product(v)) - value;
+            double abs00 = std::abs(m00), abs01 = std::abs(m01), abs11 = std::abs(m11);
+            if (abs00 >= abs11) { //null vector of the 2x2 problem in the plane, from its larger row
+                if (std::max(abs00, abs01) == 0) { return u; }
+                if (abs00 >= abs01) {
+                    m01 /= m00;
+                    m00 = 1 / std::sqrt(1 + m01 * m01);
+                    m01 *= m00;
+                } else {
+                    m00 /= m01;
+                    m01 = 1 / std::sqrt(1 + m00 * m00);
+                    m00 *= m01;
+                }
+                return u * m01 - v * m00;
+            }
+            if (std::max(abs11, abs01) == 0) { return u; }
+            if (abs11 >= abs01) {
+                m01 /= m11;
+                m11 = 1 / std::sqrt(1 + m01 * m01);
+                m01 *= m11;
+            } else {
+                m11 /= m01;
+                m01 = 1 / std::sqrt(1 + m11 * m11);
+                m11 *= m01;
+            }
+            return u * m11 - v * m01;
+        } //unit eigenvector perpendicular to a known one(Eberly's method), correct for repeated eigenvalues too
+    }
+
+    inline bool symmetricEigen(const ConstMatrixView &a, VectorView values, MatrixView vectors) {
+        int n = a.getWidth();
+        assert(a.getHeight() == n); //must be square
+        assert(values.getDim() == n && vectors.getWidth() == n && vectors.getHeight() == n); //outputs must be a's size
+        TENSORMATH_TRACE_SCOPE("symmetricEigen", n, n, 0, 0);
+        if (n == 0) { return true; }
+        std::vector<double> work((size_t) n * n), diagonal(n), off_diagonal(n, 0.0), q;
+        for (int x = 0; x < n; ++x) {
+            for (int y = x; y < n; ++y) { work[(size_t) x * n + y] = work[(size_t) y * n + x] = a.atUnchecked(x, y); }
+        }
+        Decomposition::tridiagonalize(work, n, diagonal, off_diagonal, q);
+        bool converged = Decomposition::diagonalize(diagonal, off_diagonal, q, n);
+        Decomposition::sortColumns(diagonal.data(), n, q.data(), n, false);
+        values = ConstVectorView(diagonal.data(), n);
+        vectors = ConstMatrixView::columnMajor(q.data(), n, n);
+        return converged;
+    } //eigenvalues(ascending) and unit eigenvectors(columns) of a symmetric matrix, only the lower triangle is read.
+      //false if the iteration did not converge.
+
+    inline Eigensystem symmetricEigen(const ConstMatrixView &a) {
+        Eigensystem out{Vector(a.getWidth()), Matrix(a.getWidth()), true};
+        out.converged = symmetricEigen(a, out.values, out.vectors);
+        return out;
+    } //eigenvalues and eigenvectors of a symmetric matrix into new storage
+
+    inline bool svd(const ConstMatrixView &a, MatrixView u, VectorView values, MatrixView v) {
+        int rows = a.getHeight(), columns = a.getWidth();
+        if (rows < columns) { return svd(a.transposed(), v, values, u); } //a^T = v * s * u^T
+        assert(u.getWidth() == columns && u.getHeight() == rows); //u must be height of a x width of a
+        assert(values.getDim() == columns && v.getWidth() == columns && v.getHeight() == columns); //one value per column
+        TENSORMATH_TRACE_SCOPE("svd", rows, columns, 0, 0);
+        std::vector<double> work((size_t) rows * columns), right((size_t) columns * columns, 0.0);
+        MatrixView::columnMajor(work.data(), columns, rows) = a;
+        for (int i = 0; i < columns; ++i) { right[(size_t) i * columns + i] = 1; }
+        int count = columns + columns % 2; //round robin needs an even count, the extra index sits out
+        std::vector<int> order(count);
+        std::iota(order.begin(), order.end(), 0);
+        bool converged = false;
+        for (int sweep = 0; sweep < Decomposition::MAX_SWEEPS && !converged; ++sweep) {
+            std::atomic<bool> rotated{false};
+            for (int round = 0; round + 1 < count; ++round) {
+                parallelFor((size_t) count / 2, [&](size_t begin, size_t end) {
+                    for (size_t pair = begin; pair < end; ++pair) {
+                        int first = std::min(order[pair], order[count - 1 - pair]);
+                        int second = std::max(order[pair], order[count - 1 - pair]);
+                        if (second == columns) { continue; } //paired with the extra index
+                        if (Decomposition::rotate(work.data() + (size_t) first * rows, work.data() + (size_t) second * rows,
+                                                  right.data() + (size_t) first * columns,
+                                                  right.data() + (size_t) second * columns, rows, columns)) {
+                            rotated.store(true, std::memory_order_relaxed);
+                        }
+                    }
+                }, (size_t) (rows + columns) * Decomposition::COST);
+                std::rotate(order.begin() + 1, order.end() - 1, order.end()); //next pairing, order[0] stays
+            }
+            converged = !rotated.load();
+        }
+        std::vector<double> norms(columns);
+        for (int i = 0; i < columns; ++i) {
+            double *column = work.data() + (size_t) i * rows;
+            norms[i] = std::sqrt(kernels().dot(column, column, rows));
+            double scale = norms[i] > 0 ? 1 / norms[i] : 0;
+            for (int y = 0; y < rows; ++y) { column[y] *= scale; }
+        }
+        std::vector<double> sorted = norms;
+        Decomposition::sortColumns(norms.data(), columns, work.data(), rows, true);
+        Decomposition::sortColumns(sorted.data(), columns, right.data(), columns, true);
+        u = ConstMatrixView::columnMajor(work.data(), columns, rows);
+        values = ConstVectorView(norms.data(), columns);
+        v = ConstMatrixView::columnMajor(right.data(), columns, columns);
+        return converged;
+    } //thin singular value decomposition a = u * diagonal(values) * v^T, values descending.
+      //u is height x k, v is width x k, k = min(width, height). Columns of u for zero values are zero.
+      //false if the iteration did not converge.
+
+    inline SingularValueDecomposition svd(const ConstMatrixView &a) {
+        int k = std::min(a.getWidth(), a.getHeight());
+        SingularValueDecomposition out{Matrix(k, a.getHeight()), Vector(k), Matrix(k, a.getWidth()), true};
+        out.converged = svd(a, out.u, out.values, out.v);
+        return out;
+    } //singular value decomposition into new storage
+
+    inline void symmetricEigen(const FixedMatrix<3, 3> &a, FixedVector<3> &values, FixedMatrix<3, 3> &vectors) {
+        double largest = 0;
+        for (int x = 0; x < 3; ++x) {
+            for (int y = x; y < 3; ++y) { largest = std::max(largest, std::abs(a.getValue(x, y))); }
+        }
+        vectors.setIdentity();
+        if (largest == 0) {
+            values = FixedVector<3>(0.0);
+            return;
+        }
+        FixedMatrix<3, 3> scaled; //largest value 1, no overflow or underflow in the squares below
+        for (int x = 0; x < 3; ++x) {
+            for (int y = x; y < 3; ++y) {
+                scaled.setValue(x, y, a.getValue(x, y) / largest);
+                scaled.setValue(y, x, a.getValue(x, y) / largest);
+            }
+        }
+        double a00 = scaled.getValue(0, 0), a01 = scaled.getValue(1, 0), a02 = scaled.getValue(2, 0);
+        double a11 = scaled.getValue(1, 1), a12 = scaled.getValue(2, 1), a22 = scaled.getValue(2, 2);
+        double off = a01 * a01 + a02 * a02 + a12 * a12;
+        if (off == 0) { //diagonal
+            double diagonal[3] = {a00, a11, a22};
+            Decomposition::sortColumns(diagonal, 3, vectors.data(), 3, false);
+            values = FixedVector<3>(diagonal[0] * largest, diagonal[1] * largest, diagonal[2] * largest);
+            return;
+        }
+        double mean = (a00 + a11 + a22) / 3;
+        double b00 = a00 - mean, b11 = a11 - mean, b22 = a22 - mean;
+        double p = std::sqrt((b00 * b00 + b11 * b11 + b22 * b22 + 2 * off) / 6);
+        double determinant = b00 * (b11 * b22 - a12 * a12) - a01 * (a01 * b22 - a12 * a02) + a02 * (a01 * a12 - b11 * a02);
+        double half = std::min(std::max(determinant / (2 * p * p * p), -1.0), 1.0); //det((a - mean) / p) / 2
+        double angle = std::acos(half) / 3;
+        const double third = 2.0943951023931954923; //2 pi / 3
+        double beta2 = 2 * std::cos(angle), beta0 = 2 * std::cos(angle + third), beta1 = -(beta0 + beta2);
+        double value0 = mean + p * beta0, value1 = mean + p * beta1, value2 = mean + p * beta2; //ascending
+        FixedVector<3> vector0, vector1, vector2;
+        if (half >= 0) { //value2 is the most separated, start from it
+            vector2 = Decomposition::eigenvector(scaled, value2);
+            vector1 = Decomposition::eigenvector(scaled, vector2, value1);
+            vector0 = vector1.crossProduct(vector2);
+        } else {
+            vector0 = Decomposition::eigenvector(scaled, value0);
+            vector1 = Decomposition::eigenvector(scaled, vector0, value1);
+            vector2 = vector0.crossProduct(vector1);
+        }
+        values = FixedVector<3>(value0 * largest, value1 * largest, value2 * largest);
+        vectors[0] = vector0;
+        vectors[1] = vector1;
+        vectors[2] = vector2;
+    } //closed form eigenvalues(ascending) and unit eigenvectors(columns) of a symmetric 3x3 matrix, no iteration.
+      //only the lower triangle is read.
+
+}
+
+#endif //TENSORMATH_DECOMPOSITION_HPP
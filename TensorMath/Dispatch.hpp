@@ -0,0 +1,230 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_DISPATCH_HPP
+#define TENSORMATH_DISPATCH_HPP
+
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+//runtime instruction set dispatch for the hot kernels
+//Kernels.hpp is compiled once per instruction set level, and the best level the cpu supports is picked at startup
+//so one binary built without -march flags still uses AVX2/AVX-512 on hosts that have them
+//set the environment variable TENSORMATH_ISA(generic, sse4.2, avx2, avx512) to force a level for a whole run
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define TENSORMATH_RESTRICT __restrict__
+#elif defined(_MSC_VER)
+    #define TENSORMATH_RESTRICT __restrict
+#else
+    #define TENSORMATH_RESTRICT
+#endif
+
+#if defined(__clang__)
+    #define TENSORMATH_NO_CONTRACT _Pragma("clang fp contract(off)")
+#else
+    #define TENSORMATH_NO_CONTRACT //gcc turns contraction off around the whole include instead
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__)
+    //gcc otherwise vectorizes the k loop of the small gemm kernels as an in order reduction, spilling the sums
+    #define TENSORMATH_NO_LOOP_VECTORIZE __attribute__((optimize("no-tree-loop-vectorize")))
+#else
+    #define TENSORMATH_NO_LOOP_VECTORIZE
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define TENSORMATH_UNROLL _Pragma("GCC unroll 64") //unroll the next loop completely(up to 64 steps)
+#else
+    #define TENSORMATH_UNROLL
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define TENSORMATH_DISPATCH_X86 //multiple versions are only built where gcc style target switching exists
+#endif
+
+namespace TensorMath {
+
+    //instruction set levels, in order
+    enum class Isa {
+        Generic = 0, //whatever the compiler flags allow
+        SSE42 = 1,
+        AVX2 = 2,
+        AVX512 = 3
+    };
+
+    //function table for one instruction set level, see Kernels.hpp for what each kernel does
+    struct KernelTable {
+        Isa isa;
+        void (*add)(const double *a, const double *b, double *out, int count);
+        void (*subtract)(const double *a, const double *b, double *out, int count);
+        void (*multiply)(const double *a, const double *b, double *out, int count);
+        void (*scale)(const double *a, double scalar, double *out, int count);
+        double (*dot)(const double *a, const double *b, int count);
+        void (*gemv)(const double *a, int lda, int rows, int columns, const double *x, double *y);
+        void (*gemm)(int m, int n, int k, const double *a, int lda, const double *b, int ldb, double *c, int ldc);
+        void (*transform)(const double *matrix, int width, int height, const double *in, double *out, int count);
+        void (*gemmBatch)(int m, int n, int k, const double *a, int lda, long long stride_a, const double *b, int ldb,
+                          long long stride_b, double *c, int ldc, long long stride_c, int count);
+        void (*exp)(const double *in, double *out, int count);
+        void (*log)(const double *in, double *out, int count);
+        void (*sqrt)(const double *in, double *out, int count);
+        void (*sin)(const double *in, double *out, int count);
+        void (*cos)(const double *in, double *out, int count);
+        void (*tanh)(const double *in, double *out, int count);
+        void (*sigmoid)(const double *in, double *out, int count);
+        void (*relu)(const double *in, double *out, int count);
+        void (*random)(uint64_t *state, double *out, int count);
+    };
+
+    namespace Kernels {
+        constexpr int RANDOM_LANES = 8; //independent xoshiro256** generators the random kernel steps side by side
+
+        #if defined(__GNUC__) && !defined(__clang__)
+            #pragma GCC push_options
+            #pragma GCC optimize("fp-contract=off") //no fused multiply add, on any level(see Kernels.hpp)
+            #pragma GCC optimize("no-trapping-math") //kernels never raise exception flags on purpose, so selects vectorize
+        #endif
+        #define TENSORMATH_KERNEL_NAMESPACE Generic
+        #include "Kernels.hpp"
+        #undef TENSORMATH_KERNEL_NAMESPACE
+
+        #ifdef TENSORMATH_DISPATCH_X86
+            #if defined(__clang__)
+                #define TENSORMATH_KERNEL_NAMESPACE SSE42
+                #pragma clang attribute push (__attribute__((target("sse4.2"))), apply_to = function)
+                #include "Kernels.hpp"
+                #pragma clang attribute pop
+                #undef TENSORMATH_KERNEL_NAMESPACE
+                #define TENSORMATH_KERNEL_NAMESPACE AVX2
+                #pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+                #include "Kernels.hpp"
+                #pragma clang attribute pop
+                #undef TENSORMATH_KERNEL_NAMESPACE
+                #define TENSORMATH_KERNEL_NAMESPACE AVX512
+                #pragma clang attribute push (__attribute__((target("avx512f"))), apply_to = function)
+                #include "Kernels.hpp"
+                #pragma clang attribute pop
+                #undef TENSORMATH_KERNEL_NAMESPACE
+            #else
+                #define TENSORMATH_KERNEL_NAMESPACE SSE42
+                #pragma GCC push_options
+                #pragma GCC target("sse4.2")
+                #include "Kernels.hpp"
+                #pragma GCC pop_options
+                #undef TENSORMATH_KERNEL_NAMESPACE
+                #define TENSORMATH_KERNEL_NAMESPACE AVX2
+                #pragma GCC push_options
+                #pragma GCC target("avx2")
+                #include "Kernels.hpp"
+                #pragma GCC pop_options
+                #undef TENSORMATH_KERNEL_NAMESPACE
+                #define TENSORMATH_KERNEL_NAMESPACE AVX512
+                #pragma GCC push_options
+                #pragma GCC target("avx512f")
+                #include "Kernels.hpp"
+                #pragma GCC pop_options
+                #undef TENSORMATH_KERNEL_NAMESPACE
+            #endif
+        #endif
+        #if defined(__GNUC__) && !defined(__clang__)
+            #pragma GCC pop_options
+        #endif
+
+        #define TENSORMATH_KERNEL_TABLE(level) KernelTable{Isa::level, &level::add, &level::subtract, &level::multiply, \
+            &level::scale, &level::dot, &level::gemv, &level::gemm, &level::transform, &level::gemmBatch, \
+            &level::exp, &level::log, &level::sqrt, &level::sin, &level::cos, &level::tanh, &level::sigmoid, &level::relu, \
+            &level::random}
+
+        inline const KernelTable &getTable(Isa isa) {
+            static const KernelTable generic = TENSORMATH_KERNEL_TABLE(Generic);
+            #ifdef TENSORMATH_DISPATCH_X86
+                static const KernelTable sse42 = TENSORMATH_KERNEL_TABLE(SSE42);
+                static const KernelTable avx2 = TENSORMATH_KERNEL_TABLE(AVX2);
+                static const KernelTable avx512 = TENSORMATH_KERNEL_TABLE(AVX512);
+                switch (isa) {
+                    case Isa::SSE42: return sse42;
+                    case Isa::AVX2: return avx2;
+                    case Isa::AVX512: return avx512;
+                    default: return generic;
+                }
+            #else
+                (void) isa;
+                return generic;
+            #endif
+        } //get the table for a level
+
+        #undef TENSORMATH_KERNEL_TABLE
+    }
+
+    inline bool isIsaSupported(Isa isa) {
+        #ifdef TENSORMATH_DISPATCH_X86
+            switch (isa) {
+                case Isa::Generic: return true;
+                case Isa::SSE42: return __builtin_cpu_supports("sse4.2");
+                case Isa::AVX2: return __builtin_cpu_supports("avx2");
+                case Isa::AVX512: return __builtin_cpu_supports("avx512f");
+            }
+            return false;
+        #else
+            return isa == Isa::Generic;
+        #endif
+    } //check if the cpu(and os) can run a level
+
+    inline Isa getBestIsa() {
+        for (int level = (int) Isa::AVX512; level > (int) Isa::Generic; --level) {
+            if (isIsaSupported((Isa) level)) { return (Isa) level; }
+        }
+        return Isa::Generic;
+    } //get the highest level the cpu supports
+
+    inline const char *getIsaName(Isa isa) {
+        switch (isa) {
+            case Isa::SSE42: return "sse4.2";
+            case Isa::AVX2: return "avx2";
+            case Isa::AVX512: return "avx512";
+            default: return "generic";
+        }
+    } //get a readable name for a level(same names as TENSORMATH_ISA)
+
+    namespace Kernels {
+        inline Isa getStartupIsa() {
+            const char *forced = std::getenv("TENSORMATH_ISA");
+            if (forced != nullptr) {
+                for (int level = (int) Isa::Generic; level <= (int) Isa::AVX512; ++level) {
+                    if (std::strcmp(forced, getIsaName((Isa) level)) == 0 && isIsaSupported((Isa) level)) {
+                        return (Isa) level;
+                    }
+                }
+            }
+            return getBestIsa();
+        } //level picked when the first kernel is used
+
+        inline std::atomic<const KernelTable *> &activeTable() {
+            static std::atomic<const KernelTable *> active{&getTable(getStartupIsa())};
+            return active;
+        } //the table all TensorMath types call through
+    }
+
+    inline const KernelTable &kernels() {
+        return *Kernels::activeTable().load(std::memory_order_relaxed);
+    } //get the active kernel table
+
+    inline Isa getIsa() {
+        return kernels().isa;
+    } //get the active level
+
+    inline void setIsa(Isa isa) {
+        assert(isIsaSupported(isa)); //cpu can not run this level
+        Kernels::activeTable().store(&Kernels::getTable(isa), std::memory_order_relaxed);
+    } //override the active level, for testing or to compare paths
+
+}
+
+#endif //TENSORMATH_DISPATCH_HPP
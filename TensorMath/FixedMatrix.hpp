@@ -16,43 +16,47 @@ namespace TensorMath {
     public:
         //CONSTRUCTORS
             FixedMatrix(){} //matrix of width and height, zero initialized
-            FixedMatrix(const FixedMatrix<width,height> &other) {
-                for (int y = 0; y < height; ++y) {
-                    for (int x = 0; x < width; ++x) {
-                        setValue(x,y,other.getValue(x,y));
-                    }
-                }
-            }   //copy constructor
+            FixedMatrix(const FixedMatrix<width,height> &other) = default; //copy constructor, trivial(plain memcpy)
             FixedMatrix(const FixedVector<width>&vec){
                     for (int x = 0; x < width; ++x) {
-                        setValue(x,0,vec[x]); //copy over
+                        atUnchecked(x,0) = vec.atUnchecked(x); //copy over
                     }
             } //create flat matrix from vector(for conversions)
                 //todo add TRS
         //SETTERS AND GETTERS
             double getValue(int x, int y) const{
-                assert(x < width && y < height);//check if in bounds
-                return m_data[x].getValue(y);
-            }//get a double value at coordinates
+                TENSORMATH_CHECK_INDEX(x, width);//check if in bounds
+                TENSORMATH_CHECK_INDEX(y, height);
+                return m_data[x].atUnchecked(y);
+            }//get a double value at coordinates, checked by the bounds policy(see Bounds.hpp)
             void setValue(int x, int y, double value) {
-                assert(x < width && y < height);//check if in bounds
-                m_data[x][y] = value;
-            } //set a double value at coordinates
+                TENSORMATH_CHECK_INDEX(x, width);//check if in bounds
+                TENSORMATH_CHECK_INDEX(y, height);
+                m_data[x].atUnchecked(y) = value;
+            } //set a double value at coordinates, checked by the bounds policy
+            double at(int x, int y) const{
+                Bounds::check(x, width);
+                Bounds::check(y, height);
+                return m_data[x].atUnchecked(y);
+            } //get a value, throws std::out_of_range for bad coordinates
+            double &at(int x, int y){
+                Bounds::check(x, width);
+                Bounds::check(y, height);
+                return m_data[x].atUnchecked(y);
+            } //get or set a value, throws std::out_of_range for bad coordinates
+            double atUnchecked(int x, int y) const{ return m_data[x].atUnchecked(y); } //get a value without any check, for hot loops
+            double &atUnchecked(int x, int y){ return m_data[x].atUnchecked(y); } //get or set a value without any check, for hot loops
             void setZero(){
-                for (int y = 0; y < width; ++y) {
-                    for (int x = 0; x < height; ++x) {
-                        setValue(x,y,0);
+                for (int y = 0; y < height; ++y) {
+                    for (int x = 0; x < width; ++x) {
+                        atUnchecked(x,y) = 0;
                     }
                 }
             }  //create a null matrix, all zero values
             void setIdentity(){
-                for (int y = 0; y < width; ++y) {
-                    for (int x = 0; x < height; ++x) {
-                        if(x == y){
-                            setValue(x,y,1);
-                        }else{
-                            setValue(x,y,0);
-                        }
+                for (int y = 0; y < height; ++y) {
+                    for (int x = 0; x < width; ++x) {
+                        atUnchecked(x,y) = x == y ? 1 : 0;
                     }
                 }
             }   //create an identity matrix, diagonal 1 values with others being zero
@@ -60,7 +64,7 @@ namespace TensorMath {
                 int counter = 0;
                 for (int y = 0; y < height; ++y) { //go one row at a time
                     for (int x = 0; x < width; ++x) { //fill in values left to right
-                        setValue(x,y,data[counter]);
+                        atUnchecked(x,y) = data[counter];
                         counter++;
                         if(counter == data.size()){
                             return; //fill as much as possible, then stop
@@ -70,35 +74,35 @@ namespace TensorMath {
             }      //fill the matrix from an array in standard left right then next row fashion
             std::vector<double> getArray(){
                 std::vector<double> output;
-                for (int y = 0; y < width; ++y) {
-                    for (int x = 0; x < height; ++x) {
-                        output.push_back(getValue(x,y));
+                for (int y = 0; y < height; ++y) {
+                    for (int x = 0; x < width; ++x) {
+                        output.push_back(atUnchecked(x,y));
                     }
                 }
                 return output;
             }   //get array, inverse of fill array. Useful for serialization.
             FixedVector<height> getColumn(int x)const{
-                assert(x < width); //check bounds
+                TENSORMATH_CHECK_INDEX(x, width); //check bounds
                 return m_data[x];
             }    //get a vector from matrix
             FixedVector<height> getRow(int y)const{
-                assert(y < height); //check bounds
+                TENSORMATH_CHECK_INDEX(y, height); //check bounds
                 FixedVector<width> out;
                 for (int x = 0; x < width; ++x) {
-                    out[x] = getValue(x, y); //fill vector
+                    out.atUnchecked(x) = atUnchecked(x, y); //fill vector
                 }
                 return out;
             }   //get a vector of the row rather than column
             static constexpr int getHeight()  {return height;} //get matrix height(# of rows)
             static constexpr int getWidth()  {return width;} //get matrix width
-            FixedMatrix<width,height> &operator=(const  FixedMatrix<width,height> &other) { //assign from other Matrix
-                if (this != &other) {//handle self assignment
-                    for (int i = 0; i < width; ++i) {
-                        m_data[i] = other[i];
-                    }
-                }
-                return *this;
-            }
+            double* data() { return m_data[0].data(); } //all values, one column after another(column major)
+            const double* data() const { return m_data[0].data(); } //all values(read only)
+            double* begin() { return data(); } //first value, for range for and standard algorithms(column major)
+            double* end() { return data() + width * height; } //past the last value
+            const double* begin() const { return data(); } //first value(read only)
+            const double* end() const { return data() + width * height; } //past the last value(read only)
+            static constexpr size_t size() { return (size_t) width * height; } //number of values
+            FixedMatrix<width,height> &operator=(const  FixedMatrix<width,height> &other) = default; //assign from other Matrix, trivial
 
         //COMPARISON
             bool equals(const FixedMatrix& other, double epsilon = std::numeric_limits<double>::epsilon()*10) const {
@@ -115,30 +119,29 @@ namespace TensorMath {
 
         //OPERATORS
         //allows matrix[x][y] to work, returns a vector
-        FixedVector<height> operator[](int x) const {  assert(x < width); //check if in bounds
+        FixedVector<height> operator[](int x) const {  TENSORMATH_CHECK_INDEX(x, width); //check if in bounds
             return m_data[x]; } //get vector using brackets
-        FixedVector<height> &operator[](int x) {  assert(x < width); //check if in bounds
+        FixedVector<height> &operator[](int x) {  TENSORMATH_CHECK_INDEX(x, width); //check if in bounds
             return m_data[x]; } //modify vector with brackets
         FixedMatrix operator * (const FixedMatrix<width, height>& other) const {
-            FixedMatrix<other.getWidth(),height> out; //create new matrix to output
-            for (int x = 0; x < out.getWidth(); ++x) {
-                for (int y = 0; y < out.getHeight(); ++y) {
-                    FixedVector a = getRow(y);
-                    FixedVector b = other[x];
-                    out[x][y] = a.dotProduct(b); //set new matrix value to dot product of row and column
-                }
-            }
+            static_assert(width == height, "Only square fixed matrices can be multiplied");
+            FixedMatrix<width,height> out; //create new matrix to output
+            TENSORMATH_COUNT_FLOPS(2 * width * width * height);
+            kernels().gemm(height, width, width, data(), height, other.data(), height, out.data(), height);
             return out;
         }   //multiply two matrices, only same size for fixed matrices
 
         FixedVector<width> operator * (const FixedVector<height>& other) const {
             FixedVector<width> out;
-            for (int x = 0; x < width; ++x) {
-                    FixedVector b = getColumn(x);
-                    out[x] = other.dotProduct(b); //set new matrix value to dot product of row and column
-            }
+            TENSORMATH_COUNT_FLOPS(2 * width * height);
+            kernels().gemv(data(), height, height, width, other.data(), out.data()); //dot product of each column with the vector
             return out;
         }   //multiply with vector
+        void transformBatch(const FixedVector<height>* in, FixedVector<width>* out, int count) const {
+            TENSORMATH_COUNT_FLOPS(2 * (uint64_t) width * height * count);
+            TENSORMATH_TRACE_SCOPE("transformBatch", width, height, count, 2 * (uint64_t) width * height * count);
+            kernels().transform(data(), width, height, in->data(), out->data(), count);
+        }   //multiply many vectors at once, same as operator * for each
 
         FixedMatrix<width,height> operator + (const FixedMatrix<width,height>& other) const {
             FixedMatrix<width,height> out; //output matrix
@@ -165,14 +168,18 @@ namespace TensorMath {
         } //convert flat matrix to vector
 
         //UTILS
-            void randomFill(double  min, double  max){
-                for (int x = 0; x < width; ++x) {
-                    for (int y = 0; y < height; ++y) {
-                        double random_value = min + ((double)rand() / RAND_MAX) * (max-min);
-                        setValue(x,y,random_value);
-                    }
-                }
-            } //fill the matrix with random floating point values using rand() between two bounds
+            void randomFill(double min, double max, uint64_t seed) {
+                uniformFill(data(), width * height, min, max, seed);
+            } //fill the matrix with uniform values in [min, max), same seed gives the same values
+            void randomFill(double min, double max) {
+                randomFill(min, max, nextRandomSeed());
+            } //fill the matrix with uniform values in [min, max), seeded from the global sequence(see setRandomSeed())
+            void randomNormalFill(double mean, double deviation, uint64_t seed) {
+                normalFill(data(), width * height, mean, deviation, seed);
+            } //fill the matrix with normally distributed values, same seed gives the same values
+            void randomNormalFill(double mean = 0, double deviation = 1) {
+                randomNormalFill(mean, deviation, nextRandomSeed());
+            } //fill the matrix with normally distributed values, seeded from the global sequence
 
         //PRINTING
         std::string toString() const {
@@ -180,7 +187,8 @@ namespace TensorMath {
             for (int y = 0; y < height; ++y) {
                 out +=  "[ ";
                 for (int x = 0; x < width; ++x) {
-                    out += std::to_string(getValue(x,y)) + " ";
+                    Text::appendFixed(out, atUnchecked(x,y));
+                    out += ' ';
                 }
                 out += "]\n";
             }
@@ -190,8 +198,14 @@ namespace TensorMath {
 
     private:
         FixedVector<height> m_data[width];  //actual data
+        static_assert(sizeof(FixedVector<height>) == sizeof(double) * height, "Columns must be packed for the kernels");
     };
 
+    static_assert(std::is_trivially_copyable<FixedMatrix<4,4>>::value && std::is_standard_layout<FixedMatrix<4,4>>::value,
+                  "Fixed matrices must be plain values");
+    static_assert(sizeof(FixedMatrix<4,3>) == 12 * sizeof(double) && alignof(FixedMatrix<4,3>) == alignof(double),
+                  "Fixed matrices must be packed doubles, column after column");
+
 }
 
 
@@ -4,6 +4,7 @@
 
 #ifndef TENSORMATH_FIXEDVECTOR_HPP
 #define TENSORMATH_FIXEDVECTOR_HPP
+#include <type_traits>
 #include "Vector.hpp"
 
 namespace TensorMath {
@@ -20,9 +21,7 @@ namespace TensorMath {
             FixedVector(double scalar) {
                 setScalar(scalar);
             }   //create a new vector , scalar initialized
-            FixedVector(const FixedVector<dimensions> &other) {
-                for (int i = 0; i < dimensions; ++i) { m_data[i] = other[i]; }
-            }  //copy constructor
+            FixedVector(const FixedVector<dimensions> &other) = default; //copy constructor, trivial(plain memcpy)
             FixedVector(std::initializer_list<double> values) {
             //todo optimize this, create specialized class for vec2, vec3
                 std::vector<double> v(values);
@@ -49,10 +48,27 @@ namespace TensorMath {
             void setScalar(double scalar) { for (int i = 0; i < dimensions; ++i) { m_data[i] = scalar; }} //set to scalar value
             void setZero() { setScalar(0); }  //set all to zero
             double getValue(int i) const {
-                assert(i < dimensions); //index out of vector range
+                TENSORMATH_CHECK_INDEX(i, dimensions); //index out of vector range
                 return m_data[i];
-            } //get a value
+            } //get a value, checked by the bounds policy(see Bounds.hpp)
+            double at(int i) const {
+                Bounds::check(i, dimensions);
+                return m_data[i];
+            } //get a value, throws std::out_of_range for a bad index
+            double &at(int i) {
+                Bounds::check(i, dimensions);
+                return m_data[i];
+            } //get or set a value, throws std::out_of_range for a bad index
+            double atUnchecked(int i) const { return m_data[i]; } //get a value without any check, for hot loops
+            double &atUnchecked(int i) { return m_data[i]; } //get or set a value without any check, for hot loops
             constexpr int getDim() const { return dimensions; } //get num dimensions
+            double *data() { return m_data; } //get the contiguous components(for kernels and other libraries)
+            const double *data() const { return m_data; } //get the contiguous components(read only)
+            double *begin() { return m_data; } //first value, for range for and standard algorithms(contiguous iterator)
+            double *end() { return m_data + dimensions; } //past the last value
+            const double *begin() const { return m_data; } //first value(read only)
+            const double *end() const { return m_data + dimensions; } //past the last value(read only)
+            size_t size() const { return (size_t) dimensions; } //number of values, for standard code(same as getDim())
             //get by names
             double inline x() const { return getValue(0); }
             double inline y() const { return getValue(1); }
@@ -66,7 +82,7 @@ namespace TensorMath {
             } //compare to scalar value, using epsilon for reliability
             bool equals(const FixedVector &other, double epsilon = std::numeric_limits<double>::epsilon()*10) const {
                 if (other.getDim() != dimensions) { return false; }//not same size
-                for (int i = 0; i < dimensions; ++i) { if (!doubleEquals(m_data[i], other[i], epsilon)) { return false; }}
+                for (int i = 0; i < dimensions; ++i) { if (!doubleEquals(m_data[i], other.atUnchecked(i), epsilon)) { return false; }}
                 return true;
             } //compare to other vector, using epsilon for reliability
 
@@ -74,21 +90,14 @@ namespace TensorMath {
             //Getting and setting values
             double operator[](int i) const { return getValue(i); } //getting with brackets
             double &operator[](int i) {
-                assert(i < dimensions); //index out of vector range
+                TENSORMATH_CHECK_INDEX(i, dimensions); //index out of vector range
                 return m_data[i];
             } //setting with brackets
             FixedVector<dimensions> &operator=(double scalar) {
                 setScalar(scalar);
                 return *this;
             }   //set to a scalar value with operator
-            FixedVector<dimensions> &operator=(const FixedVector<dimensions> &other) { //assign from other vector
-                if (this != &other) {//handle self assignment
-                    for (int i = 0; i < dimensions; ++i) {
-                        m_data[i] = other[i];
-                    }
-                }
-                return *this;
-            }   //set to a scalar value with operator
+            FixedVector<dimensions> &operator=(const FixedVector<dimensions> &other) = default; //assign from other vector, trivial
             FixedVector<dimensions> &operator=(std::initializer_list<double> values) {
                 setValues(std::vector<double>(values));
                 return *this;
@@ -97,7 +106,7 @@ namespace TensorMath {
             FixedVector<dimensions> inline operator+(const double &scalar) const { //adding
                 FixedVector<dimensions> out;
                 for (int i = 0; i < dimensions; ++i) {
-                    out[i] = m_data[i] + scalar;
+                    out.atUnchecked(i) = m_data[i] + scalar;
                 }
                 return out;
             }
@@ -109,7 +118,7 @@ namespace TensorMath {
             FixedVector<dimensions> inline operator-(const double &scalar) const { //subtracting
                 FixedVector<dimensions> out;
                 for (int i = 0; i < dimensions; ++i) {
-                    out[i] = m_data[i] - scalar;
+                    out.atUnchecked(i) = m_data[i] - scalar;
                 }
                 return out;
             }
@@ -121,7 +130,7 @@ namespace TensorMath {
             FixedVector<dimensions> inline operator*(const double &scalar) const {
                 FixedVector<dimensions> out;
                 for (int i = 0; i < dimensions; ++i) {
-                    out[i] = m_data[i] * scalar;
+                    out.atUnchecked(i) = m_data[i] * scalar;
                 }
                 return out;
             }
@@ -133,7 +142,7 @@ namespace TensorMath {
             FixedVector<dimensions> inline operator/(const double &scalar) const { //dividing
                 FixedVector<dimensions> out;
                 for (int i = 0; i < dimensions; ++i) {
-                    out[i] = m_data[i] / scalar;
+                    out.atUnchecked(i) = m_data[i] / scalar;
                 }
                 return out;
             }
@@ -152,56 +161,56 @@ namespace TensorMath {
             FixedVector<dimensions> inline operator+(const FixedVector<dimensions> &other) const { //adding
                 FixedVector<dimensions> out;
                 for (int i = 0; i < dimensions; ++i) {
-                    out[i] = m_data[i] + other[i];
+                    out.atUnchecked(i) = m_data[i] + other.atUnchecked(i);
                 }
                 return out;
             }
             void inline operator+=(const FixedVector<dimensions> &other) {
                 for (int i = 0; i < dimensions; ++i) {
-                    m_data[i] = m_data[i] + other[i];
+                    m_data[i] = m_data[i] + other.atUnchecked(i);
                 }
             }
             FixedVector<dimensions> inline operator-(const FixedVector<dimensions> &other) const { //subtracting
                 FixedVector<dimensions> out;
                 for (int i = 0; i < dimensions; ++i) {
-                    out[i] = m_data[i] - other[i];
+                    out.atUnchecked(i) = m_data[i] - other.atUnchecked(i);
                 }
                 return out;
             }
             FixedVector<dimensions> inline operator-() const { //negating
                 FixedVector<dimensions> out;
                 for (int i = 0; i < dimensions; ++i) {
-                    out[i] = -m_data[i];
+                    out.atUnchecked(i) = -m_data[i];
                 }
                 return out;
              }
             void inline operator-=(const FixedVector<dimensions> &other) {
                 for (int i = 0; i < dimensions; ++i) {
-                    m_data[i] = m_data[i] - other[i];
+                    m_data[i] = m_data[i] - other.atUnchecked(i);
                 }
             }
             FixedVector<dimensions> inline operator*(const FixedVector<dimensions> &other) const { //multiplying
                 FixedVector<dimensions> out;
                 for (int i = 0; i < dimensions; ++i) {
-                    out[i] = m_data[i] * other[i];
+                    out.atUnchecked(i) = m_data[i] * other.atUnchecked(i);
                 }
                 return out;
             }
             void inline operator*=(const FixedVector<dimensions> &other) {
                 for (int i = 0; i < dimensions; ++i) {
-                    m_data[i] = m_data[i] * other[i];
+                    m_data[i] = m_data[i] * other.atUnchecked(i);
                 }
             }
             FixedVector<dimensions> inline operator/(const FixedVector<dimensions> &other) const { //dividing
                 FixedVector<dimensions> out;
                 for (int i = 0; i < dimensions; ++i) {
-                    out[i] = m_data[i] / other[i];
+                    out.atUnchecked(i) = m_data[i] / other.atUnchecked(i);
                 }
                 return out;
             }
             void inline operator/=(const FixedVector<dimensions> &other) {
                 for (int i = 0; i < dimensions; ++i) {
-                    m_data[i] = m_data[i] / other[i];
+                    m_data[i] = m_data[i] / other.atUnchecked(i);
                 }
             }
             bool operator==(const FixedVector<dimensions> &other) const { //comparison
@@ -213,36 +222,77 @@ namespace TensorMath {
             //todo https://developer.nvidia.com/cuda-math-library cuda version
 
         //UTILITIES
+        void randomFill(double min, double max, uint64_t seed) {
+            uniformFill(data(), dimensions, min, max, seed);
+        } //fill the vector with uniform values in [min, max), same seed gives the same values
+        void randomFill(double min, double max) {
+            randomFill(min, max, nextRandomSeed());
+        } //fill the vector with uniform values in [min, max), seeded from the global sequence(see setRandomSeed())
+        void randomNormalFill(double mean, double deviation, uint64_t seed) {
+            normalFill(data(), dimensions, mean, deviation, seed);
+        } //fill the vector with normally distributed values, same seed gives the same values
+        void randomNormalFill(double mean = 0, double deviation = 1) {
+            randomNormalFill(mean, deviation, nextRandomSeed());
+        } //fill the vector with normally distributed values, seeded from the global sequence
+        double lengthSquared() const {
+            double sum = 0; //x^2 + y^2 ... == ||v||^2
+            for (int i = 0; i < dimensions; ++i) { sum = multiplyAdd(m_data[i], m_data[i], sum); }
+            return sum;
+        } //squared length of vector, cheaper than length() for comparisons
         double length() const {
-            double sum = 0; //sqrt(x^2 + y^2 ...) == ||v||
-            for (int i = 0; i < dimensions; ++i) { sum += std::pow(m_data[i], 2.0); }
-            return std::sqrt(sum);
+            return std::sqrt(lengthSquared()); //sqrt(x^2 + y^2 ...) == ||v||
         } //length of vector, the magnitude
         double dotProduct(const FixedVector<dimensions> &other) const {
             double sum = 0; //x1*x2 + y1*y2...
             for (int i = 0; i < dimensions; ++i) {
-                sum += m_data[i] * other[i];
+                sum = multiplyAdd(m_data[i], other.m_data[i], sum);
             }
             return sum;
         } //Get the dot product of two vectors. Combine two vectors into single value.
         FixedVector<3> crossProduct(const FixedVector<3> &other) const {
-            return FixedVector<3>{getValue(1) * other[2] - getValue(2) * other[1],
+            return FixedVector<3>(getValue(1) * other[2] - getValue(2) * other[1],
                         getValue(2) * other[0] - getValue(0) * other[2],
-                        getValue(0) * other[1] - getValue(1) * other[0]};
+                        getValue(0) * other[1] - getValue(1) * other[0]); //not braces, those take the initializer list
         } //Get the cross product of two vectors. Only for 3d vectors. (Right-hand rule)
         FixedVector<dimensions> reflect( FixedVector<dimensions> normal) const{
             return *this - normal * 2.0 * this->dotProduct(normal) / normal.dotProduct(normal) ;
         } //https://en.wikipedia.org/wiki/Reflection_(mathematics) , reflect a vector over a normal
-        double distance(const FixedVector<dimensions> &other) const {
-            double sum = 0; //sqrt((x2-x1)^2 + (y2-y1)^2...)
+        double distanceSquared(const FixedVector<dimensions> &other) const {
+            double sum = 0; //(x2-x1)^2 + (y2-y1)^2...
             for (int i = 0; i < dimensions; ++i) {
-                sum += std::pow(m_data[i] - other[i], 2.0);
+                double difference = m_data[i] - other.m_data[i];
+                sum = multiplyAdd(difference, difference, sum);
             }
-            return std::sqrt(sum);
+            return sum;
+        } //get the squared distance between two vectors, cheaper than distance() for comparisons
+        double distance(const FixedVector<dimensions> &other) const {
+            return std::sqrt(distanceSquared(other)); //sqrt((x2-x1)^2 + (y2-y1)^2...)
         } //get the distance between two vectors.
         FixedVector<dimensions> normalized() const {
-            return *this / length();  //(1/||v||) * v = unit v
+            return *this * (1.0 / length());  //(1/||v||) * v = unit v
         } //get the normalized(unit) vector. The direction of the vector.
+        FixedVector<dimensions> normalizedFast(Precision precision = Precision::Medium) const {
+            return *this * fastInverseSqrt(lengthSquared(), precision);
+        } //get the normalized vector using an approximate reciprocal square root. Not for zero length vectors.
+        void normalize() {
+            *this *= 1.0 / length();
+        } //normalize this vector in place
+        static void normalizeBatch(FixedVector<dimensions> *vectors, int count, Precision precision = Precision::Medium) {
+            constexpr int BLOCK = 16; //vectors per block, every step below is a simple loop over the block
+            double scale[BLOCK];
+            for (int start = 0; start < count; start += BLOCK) {
+                int size = std::min(BLOCK, count - start);
+                FixedVector<dimensions> *block = vectors + start;
+                for (int i = 0; i < size; ++i) { scale[i] = block[i].lengthSquared(); }
+                for (int i = 0; i < size; ++i) { scale[i] = fastInverseSqrt(scale[i], precision); }
+                for (int i = 0; i < size; ++i) {
+                    for (int d = 0; d < dimensions; ++d) { block[i].m_data[d] *= scale[i]; }
+                }
+            }
+        } //normalize many vectors in place with normalizedFast(), in blocks so the compiler can vectorize each step
+        static void lengthSquaredBatch(const FixedVector<dimensions> *vectors, double *out, int count) {
+            for (int i = 0; i < count; ++i) { out[i] = vectors[i].lengthSquared(); }
+        } //squared lengths of many vectors
         FixedVector<dimensions>  inverse() const {
             FixedVector<dimensions> one(1.0);
             return one / *this;
@@ -250,21 +300,21 @@ namespace TensorMath {
         FixedVector<dimensions>  abs() const {
             FixedVector<dimensions> out;
             for (int i = 0; i < dimensions; ++i) {
-                out[i] = std::abs(m_data[i]);
+                out.atUnchecked(i) = std::abs(m_data[i]);
             }
             return out;
         } //absolute value
         FixedVector<dimensions> min(const FixedVector<dimensions> &other) const {
             FixedVector<dimensions> out; //vector to return
             for (int i = 0; i < dimensions; ++i) {
-                out[i] = std::fmin(m_data[i], other[i]);
+                out.atUnchecked(i) = std::fmin(m_data[i], other.atUnchecked(i));
             }
             return out;
         } //get a new vector with the minimum components from both other vectors(Very useful for bounding boxes)
         FixedVector<dimensions> max(const FixedVector<dimensions> &other) const {
             FixedVector<dimensions> out; //vector to return
             for (int i = 0; i < dimensions; ++i) {
-                out[i] = std::max(m_data[i], other[i]);
+                out.atUnchecked(i) = std::max(m_data[i], other.atUnchecked(i));
             }
             return out;
         } //get a new vector with the maximum components from both other vectors(Very useful for bounding boxes)
@@ -275,7 +325,10 @@ namespace TensorMath {
         } //standard output overload
         std::string toString() const {
             std::string out = "{";
-            for (int i = 0; i < dimensions; ++i) { out += " " + std::to_string(m_data[i]); }
+            for (int i = 0; i < dimensions; ++i) {
+                out += ' ';
+                Text::appendFixed(out, m_data[i]);
+            }
             return out + " }";
         }  //make vector into string
 
@@ -291,6 +344,12 @@ namespace TensorMath {
     typedef FixedVector<3> Vector3;// 3d vector
     typedef FixedVector<2> Vector2;//2d vector
 
+    //plain values: copied with memcpy, placed in shared memory, and sent in bulk(see Serialization.hpp)
+    static_assert(std::is_trivially_copyable<Vector3>::value && std::is_standard_layout<Vector3>::value,
+                  "Fixed vectors must be plain values");
+    static_assert(sizeof(Vector3) == 3 * sizeof(double) && alignof(Vector3) == alignof(double),
+                  "Fixed vectors must be packed doubles");
+
 
 }
 #endif //TENSORMATH_FIXEDVECTOR_HPP
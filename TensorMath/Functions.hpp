@@ -0,0 +1,135 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_FUNCTIONS_HPP
+#define TENSORMATH_FUNCTIONS_HPP
+
+#include <algorithm>
+#include "Matrix.hpp"
+#include "FixedMatrix.hpp"
+
+//elementwise math functions for vectors, matrices, views and fixed types
+//every function writes into a destination(which may be the input itself, for in place use) without temporaries,
+//and has a version returning a new object. The work is done by the vectorized kernels in Kernels.hpp.
+//
+//Largest error against the exact result, measured on 2 million random inputs per range:
+//exp 1.2 ulp, log 0.9 ulp, sqrt 0.5 ulp(correctly rounded), sin and cos 1.5 ulp for |x| <= 10 and 2.5 ulp up to 1e5
+//(std::sin and std::cos beyond), tanh 3.2 ulp, sigmoid 2.6 ulp. relu is exact.
+//Special values follow std: exp(-inf) = 0, log(0) = -inf, log(-1) = NaN, NaN stays NaN.
+
+namespace TensorMath {
+
+    namespace Functions {
+        constexpr size_t COST = 8; //a math function costs about as much as this many additions, for parallelFor
+        constexpr int BLOCK = 256; //values strided views copy at once
+
+        typedef void (*Kernel)(const double *in, double *out, int count);
+
+        inline void map(const ConstVectorView &in, VectorView out, Kernel kernel) {
+            assert(in.getDim() == out.getDim()); //must be same size
+            TENSORMATH_TIME(Functions);
+            if (in.isContiguous() && out.isContiguous()) {
+                parallelFor((size_t) in.getDim(), [&](size_t begin, size_t end) {
+                    kernel(in.data() + begin, out.data() + begin, (int) (end - begin));
+                }, COST);
+                return;
+            }
+            parallelFor((size_t) in.getDim(), [&](size_t begin, size_t end) {
+                double block[BLOCK]; //gather, run the kernel, scatter
+                for (int start = (int) begin; start < (int) end; start += BLOCK) {
+                    int size = std::min(BLOCK, (int) end - start);
+                    for (int i = 0; i < size; ++i) { block[i] = in[start + i]; }
+                    kernel(block, block, size);
+                    for (int i = 0; i < size; ++i) { out[start + i] = block[i]; }
+                }
+            }, COST);
+        } //out = kernel(in) for views of any stride. out may be in, but must not partly overlap it.
+
+        inline void map(const ConstMatrixView &in, MatrixView out, Kernel kernel) {
+            assert(out.getWidth() == in.getWidth() && out.getHeight() == in.getHeight()); //output must be same size
+            TENSORMATH_TIME(Functions);
+            bool column_major = in.isColumnMajor() && out.isColumnMajor();
+            if (!column_major && in.isRowMajor() && out.isRowMajor()) {
+                map(in.transposed(), out.transposed(), kernel); //rows become contiguous columns
+                return;
+            }
+            if (in.isContiguous() && out.isContiguous()) { //one flat array
+                int size = in.getWidth() * in.getHeight();
+                map(ConstVectorView(in.data(), size), VectorView(out.data(), size), kernel);
+                return;
+            }
+            for (int x = 0; x < in.getWidth(); ++x) { map(in.column(x), out.column(x), kernel); }
+        } //out = kernel(in) for matrix views of any layout. out may be in, but must not partly overlap it.
+    }
+
+    //every function name gets the same set of versions
+    #define TENSORMATH_ELEMENTWISE(name) \
+        inline void name(const ConstVectorView &in, VectorView out) { Functions::map(in, out, kernels().name); } \
+        inline void name(const ConstMatrixView &in, MatrixView out) { Functions::map(in, out, kernels().name); } \
+        inline Vector name(const Vector &in) { \
+            Vector out(in.getDim()); \
+            name(in, out); \
+            return out; \
+        } \
+        inline Matrix name(const Matrix &in) { \
+            Matrix out(in.getWidth(), in.getHeight(), in.getLayout()); \
+            name(in, out); \
+            return out; \
+        } \
+        template<int dimensions> \
+        FixedVector<dimensions> name(const FixedVector<dimensions> &in) { \
+            FixedVector<dimensions> out; \
+            kernels().name(in.data(), out.data(), dimensions); \
+            return out; \
+        } \
+        template<int width, int height> \
+        FixedMatrix<width, height> name(const FixedMatrix<width, height> &in) { \
+            FixedMatrix<width, height> out; \
+            for (int x = 0; x < width; ++x) { out[x] = name(in[x]); } \
+            return out; \
+        }
+
+    TENSORMATH_ELEMENTWISE(exp) //e^x
+    TENSORMATH_ELEMENTWISE(log) //natural logarithm
+    TENSORMATH_ELEMENTWISE(sqrt) //square root
+    TENSORMATH_ELEMENTWISE(sin) //sine, radians
+    TENSORMATH_ELEMENTWISE(cos) //cosine, radians
+    TENSORMATH_ELEMENTWISE(tanh) //hyperbolic tangent
+    TENSORMATH_ELEMENTWISE(sigmoid) //logistic function 1 / (1 + e^-x)
+    TENSORMATH_ELEMENTWISE(relu) //max(x, 0)
+
+    #undef TENSORMATH_ELEMENTWISE
+
+    inline void softmax(const ConstVectorView &in, VectorView out) {
+        assert(in.getDim() == out.getDim()); //must be same size
+        double maximum = -HUGE_VAL;
+        for (int i = 0; i < in.getDim(); ++i) { maximum = std::max(maximum, in[i]); }
+        out = in;
+        out -= maximum; //largest value becomes e^0, so nothing overflows
+        exp(out, out);
+        out /= out.sum();
+    } //out = e^in / sum(e^in), values that sum to 1. out may be in.
+
+    inline Vector softmax(const Vector &in) {
+        Vector out(in.getDim());
+        softmax(in, out);
+        return out;
+    } //values that sum to 1
+
+    inline void softmaxColumns(const ConstMatrixView &in, MatrixView out) {
+        assert(out.getWidth() == in.getWidth() && out.getHeight() == in.getHeight()); //output must be same size
+        parallelFor((size_t) in.getWidth(), [&](size_t begin, size_t end) {
+            for (int x = (int) begin; x < (int) end; ++x) { softmax(in.column(x), out.column(x)); }
+        }, (size_t) in.getHeight() * Functions::COST);
+    } //softmax of every column on its own(one column per sample). out may be in.
+
+    inline Matrix softmaxColumns(const Matrix &in) {
+        Matrix out(in.getWidth(), in.getHeight(), in.getLayout());
+        softmaxColumns(in, out);
+        return out;
+    } //softmax of every column on its own
+
+}
+
+#endif //TENSORMATH_FUNCTIONS_HPP
@@ -0,0 +1,187 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_INSTRUMENT_HPP
+#define TENSORMATH_INSTRUMENT_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//optional counters of what the library does: buffers allocated, bytes copied, floating point operations, and calls and
+//time per kind of operation. Define TENSORMATH_INSTRUMENT(before including, or -DTENSORMATH_INSTRUMENT) to turn them on.
+//when it is not defined the counting macros are empty, so there is no cost at all, and snapshots are all zero
+//every thread counts into its own counters(no shared cache lines), a snapshot adds up all threads
+//work is counted on the thread that called the operation, not on the pool threads that helped with it
+//time is only taken for the outermost operation, so a layer that multiplies is counted once, as a layer
+
+namespace TensorMath {
+
+    //kinds of operations that are timed
+    enum class InstrumentCategory {
+        Elementwise, //vector and matrix + - * / with vectors, matrices and scalars
+        Reduction, //dot products, lengths
+        Multiply, //matrix products, batched and Strassen included
+        Functions, //exp, log, tanh...
+        Layers //fused dense layers
+    };
+
+    constexpr int INSTRUMENT_CATEGORIES = 5;
+
+    //counter values at one moment, subtract two to get the work done in between
+    struct InstrumentSnapshot {
+        uint64_t allocations = 0; //Vector and Matrix buffers allocated
+        uint64_t allocated_bytes = 0;
+        uint64_t copies = 0; //whole copies made by copy constructors, getColumn(), getRow(), getArray()...
+        uint64_t copied_bytes = 0;
+        uint64_t flops = 0; //floating point operations, a multiply add is 2
+        uint64_t calls[INSTRUMENT_CATEGORIES] = {}; //outermost operations of each category
+        uint64_t nanoseconds[INSTRUMENT_CATEGORIES] = {}; //time in them
+
+        InstrumentSnapshot operator-(const InstrumentSnapshot &other) const {
+            InstrumentSnapshot out;
+            out.allocations = allocations - other.allocations;
+            out.allocated_bytes = allocated_bytes - other.allocated_bytes;
+            out.copies = copies - other.copies;
+            out.copied_bytes = copied_bytes - other.copied_bytes;
+            out.flops = flops - other.flops;
+            for (int i = 0; i < INSTRUMENT_CATEGORIES; ++i) {
+                out.calls[i] = calls[i] - other.calls[i];
+                out.nanoseconds[i] = nanoseconds[i] - other.nanoseconds[i];
+            }
+            return out;
+        } //work done between two snapshots
+        uint64_t getCalls(InstrumentCategory category) const { return calls[(int) category]; } //calls of a category
+        double getSeconds(InstrumentCategory category) const {
+            return nanoseconds[(int) category] * 1e-9;
+        } //time spent in a category
+
+        std::string toString() const {
+            static const char *names[INSTRUMENT_CATEGORIES] = {"elementwise", "reduction", "multiply", "functions", "layers"};
+            std::string out = "allocations: " + std::to_string(allocations) + " (" + std::to_string(allocated_bytes) + " bytes)\n";
+            out += "copies: " + std::to_string(copies) + " (" + std::to_string(copied_bytes) + " bytes)\n";
+            out += "flops: " + std::to_string(flops) + "\n";
+            for (int i = 0; i < INSTRUMENT_CATEGORIES; ++i) {
+                out += std::string(names[i]) + ": " + std::to_string(calls[i]) + " calls, " +
+                       std::to_string(nanoseconds[i] / 1000) + " us\n";
+            }
+            return out;
+        } //report, one line per counter
+    };
+
+    namespace Instrument {
+        //counter indices
+        enum Counter { ALLOCATIONS, ALLOCATED_BYTES, COPIES, COPIED_BYTES, FLOPS, CALLS, NANOSECONDS = CALLS + INSTRUMENT_CATEGORIES,
+                       COUNTERS = NANOSECONDS + INSTRUMENT_CATEGORIES };
+
+        //counters of one thread, only that thread writes them
+        struct alignas(64) ThreadCounters {
+            std::atomic<uint64_t> values[COUNTERS]; //atomic so snapshots from other threads are not data races
+            int depth = 0; //operations in progress, only the outermost is timed
+
+            ThreadCounters() { for (std::atomic<uint64_t> &value: values) { value.store(0, std::memory_order_relaxed); } }
+        };
+
+        inline std::mutex &registryMutex() {
+            static std::mutex mutex;
+            return mutex;
+        } //guards the registry
+        inline std::vector<std::unique_ptr<ThreadCounters>> &registry() {
+            static std::vector<std::unique_ptr<ThreadCounters>> threads;
+            return threads;
+        } //counters of every thread that counted something, kept after the thread ends so totals stay
+
+        inline ThreadCounters &local() {
+            thread_local ThreadCounters *counters = []() {
+                std::lock_guard<std::mutex> lock(registryMutex());
+                registry().emplace_back(new ThreadCounters());
+                return registry().back().get();
+            }();
+            return *counters;
+        } //counters of the calling thread, registered on first use
+
+        inline void add(Counter counter, uint64_t amount) {
+            std::atomic<uint64_t> &value = local().values[counter];
+            value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed); //one writer, no lock
+        } //count on the calling thread
+
+        inline InstrumentSnapshot read(const ThreadCounters &counters, InstrumentSnapshot out) {
+            out.allocations += counters.values[ALLOCATIONS].load(std::memory_order_relaxed);
+            out.allocated_bytes += counters.values[ALLOCATED_BYTES].load(std::memory_order_relaxed);
+            out.copies += counters.values[COPIES].load(std::memory_order_relaxed);
+            out.copied_bytes += counters.values[COPIED_BYTES].load(std::memory_order_relaxed);
+            out.flops += counters.values[FLOPS].load(std::memory_order_relaxed);
+            for (int i = 0; i < INSTRUMENT_CATEGORIES; ++i) {
+                out.calls[i] += counters.values[CALLS + i].load(std::memory_order_relaxed);
+                out.nanoseconds[i] += counters.values[NANOSECONDS + i].load(std::memory_order_relaxed);
+            }
+            return out;
+        } //add one thread's counters to a snapshot
+
+        //times an operation from construction to destruction, if no other operation is in progress on the thread
+        class Timer {
+        public:
+            explicit Timer(InstrumentCategory category) : m_category((int) category), m_counters(local()) {
+                if (m_counters.depth++ == 0) { m_start = std::chrono::steady_clock::now(); }
+            }
+            Timer(const Timer &other) = delete;
+            Timer &operator=(const Timer &other) = delete;
+            ~Timer() {
+                if (--m_counters.depth != 0) { return; }
+                auto elapsed = std::chrono::steady_clock::now() - m_start;
+                add((Counter) (CALLS + m_category), 1);
+                add((Counter) (NANOSECONDS + m_category),
+                    (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            }
+
+        private:
+            int m_category;
+            ThreadCounters &m_counters;
+            std::chrono::steady_clock::time_point m_start;
+        };
+    }
+
+    #ifdef TENSORMATH_INSTRUMENT
+        #define TENSORMATH_COUNT_ALLOCATION(bytes) ::TensorMath::Instrument::add(::TensorMath::Instrument::ALLOCATIONS, 1), \
+            ::TensorMath::Instrument::add(::TensorMath::Instrument::ALLOCATED_BYTES, (uint64_t) (bytes))
+        #define TENSORMATH_COUNT_COPY(bytes) ::TensorMath::Instrument::add(::TensorMath::Instrument::COPIES, 1), \
+            ::TensorMath::Instrument::add(::TensorMath::Instrument::COPIED_BYTES, (uint64_t) (bytes))
+        #define TENSORMATH_COUNT_FLOPS(flops) ::TensorMath::Instrument::add(::TensorMath::Instrument::FLOPS, (uint64_t) (flops))
+        #define TENSORMATH_TIME(category) ::TensorMath::Instrument::Timer tensormath_timer(::TensorMath::InstrumentCategory::category)
+    #else
+        #define TENSORMATH_COUNT_ALLOCATION(bytes) ((void) 0)
+        #define TENSORMATH_COUNT_COPY(bytes) ((void) 0)
+        #define TENSORMATH_COUNT_FLOPS(flops) ((void) 0)
+        #define TENSORMATH_TIME(category) ((void) 0)
+    #endif
+
+    constexpr bool isInstrumentEnabled() {
+        #ifdef TENSORMATH_INSTRUMENT
+            return true;
+        #else
+            return false;
+        #endif
+    } //check if the library was built with TENSORMATH_INSTRUMENT
+
+    inline InstrumentSnapshot getInstrumentSnapshot() {
+        InstrumentSnapshot out;
+        std::lock_guard<std::mutex> lock(Instrument::registryMutex());
+        for (const std::unique_ptr<Instrument::ThreadCounters> &counters: Instrument::registry()) {
+            out = Instrument::read(*counters, out);
+        }
+        return out;
+    } //counters of all threads added up, all zero when instrumentation is off
+
+    inline InstrumentSnapshot getThreadInstrumentSnapshot() {
+        if (!isInstrumentEnabled()) { return InstrumentSnapshot(); }
+        return Instrument::read(Instrument::local(), InstrumentSnapshot());
+    } //counters of the calling thread
+
+}
+
+#endif //TENSORMATH_INSTRUMENT_HPP
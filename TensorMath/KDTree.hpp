@@ -0,0 +1,204 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_KDTREE_HPP
+#define TENSORMATH_KDTREE_HPP
+
+#include <vector>
+#include <future>
+#include <thread>
+#include <algorithm>
+#include "FixedVector.hpp"
+
+namespace TensorMath {
+
+    //k-d tree over n dimensional points, for nearest neighbor and radius searches
+    //points are split at the median of the widest axis, so the tree is always balanced
+    //points are copied into leaf order so every leaf is one contiguous block of memory
+    //all distances are compared squared, sqrt is never taken
+    template<int dimensions>
+    class KDTree {
+    public:
+        struct Neighbor {
+            int index; //index of the point in the vector the tree was built from
+            double distance_squared; //squared distance to the query point
+            bool operator<(const Neighbor &other) const { return distance_squared < other.distance_squared; }
+        };
+
+        //CONSTRUCTORS
+            explicit KDTree(const std::vector<FixedVector<dimensions>> &points, int leaf_size = 8) {
+                assert(leaf_size > 0); //leaves need at least one point
+                int count = (int) points.size();
+                m_leaf_size = leaf_size;
+                m_indices.resize(count);
+                for (int i = 0; i < count; ++i) { m_indices[i] = i; }
+                if (count > 0) {
+                    m_nodes.reserve(2 * count / leaf_size + 1);
+                    build(points, m_nodes, 0, count, 0);
+                }
+                m_points.resize(count);
+                for (int i = 0; i < count; ++i) { m_points[i] = points[m_indices[i]]; } //copy into leaf order
+            } //build a tree over points. Points are referred to by their index in the vector.
+
+        //SETTERS AND GETTERS
+            int getSize() const { return (int) m_points.size(); } //get number of points
+            int getNodeCount() const { return (int) m_nodes.size(); } //get number of nodes
+            static constexpr int getDim() { return dimensions; } //get num dimensions
+
+        //QUERIES
+            std::vector<Neighbor> nearest(const FixedVector<dimensions> &query, int k) const {
+                std::vector<Neighbor> heap; //max heap, the worst neighbor found so far is on top
+                heap.reserve(k + 1);
+                if (k > 0 && !m_nodes.empty()) { searchNearest(0, query, k, heap); }
+                std::sort_heap(heap.begin(), heap.end());
+                return heap;
+            } //get the k closest points, closest first
+            std::vector<Neighbor> radius(const FixedVector<dimensions> &query, double radius) const {
+                std::vector<Neighbor> out;
+                if (!m_nodes.empty()) { searchRadius(0, query, radius * radius, out); }
+                std::sort(out.begin(), out.end());
+                return out;
+            } //get all points within a distance(inclusive), closest first
+            std::vector<std::vector<Neighbor>> nearest(const std::vector<FixedVector<dimensions>> &queries, int k) const {
+                std::vector<std::vector<Neighbor>> out(queries.size());
+                parallelQueries((int) queries.size(), [&](int i) { out[i] = nearest(queries[i], k); });
+                return out;
+            } //k nearest neighbors for many points, split across threads
+            std::vector<std::vector<Neighbor>> radius(const std::vector<FixedVector<dimensions>> &queries, double radius) const {
+                std::vector<std::vector<Neighbor>> out(queries.size());
+                parallelQueries((int) queries.size(), [&](int i) { out[i] = this->radius(queries[i], radius); });
+                return out;
+            } //radius search for many points, split across threads
+
+    private:
+        struct Node {
+            double split; //inner: split position along axis
+            int axis; //inner: split axis, leaf: -1
+            int offset; //leaf: first point, inner: index of right child(left child is the next node)
+            int count; //leaf: number of points
+        };
+
+        static constexpr int PARALLEL_THRESHOLD = 65536; //smallest subtree that is built on its own thread
+        static constexpr int QUERY_CHUNK = 256; //smallest number of queries worth a thread
+
+        std::vector<Node> m_nodes; //flattened tree, depth first
+        std::vector<FixedVector<dimensions>> m_points; //points in leaf order
+        std::vector<int> m_indices; //original index of each point in leaf order
+        int m_leaf_size;
+
+        void build(const std::vector<FixedVector<dimensions>> &points, std::vector<Node> &nodes, int begin, int end,
+                   int level) {
+            int node_index = (int) nodes.size();
+            nodes.push_back(Node{0, -1, begin, end - begin});
+            int count = end - begin;
+            if (count <= m_leaf_size) { return; }
+            //split the widest axis at the median
+            FixedVector<dimensions> low = points[m_indices[begin]];
+            FixedVector<dimensions> high = low;
+            for (int i = begin + 1; i < end; ++i) {
+                low = low.min(points[m_indices[i]]);
+                high = high.max(points[m_indices[i]]);
+            }
+            FixedVector<dimensions> spread = high - low;
+            int axis = 0;
+            for (int i = 1; i < dimensions; ++i) { if (spread[i] > spread[axis]) { axis = i; }}
+            int middle = begin + count / 2;
+            std::nth_element(m_indices.begin() + begin, m_indices.begin() + middle, m_indices.begin() + end,
+                             [&](int a, int b) { return points[a][axis] < points[b][axis]; });
+            nodes[node_index].axis = axis;
+            nodes[node_index].split = points[m_indices[middle]][axis];
+            //the ranges are disjoint, so big subtrees can be built at the same time into their own node lists
+            if (count >= PARALLEL_THRESHOLD && (1 << level) < (int) std::thread::hardware_concurrency()) {
+                std::vector<Node> left_nodes;
+                std::future<void> left = std::async(std::launch::async, [&] {
+                    build(points, left_nodes, begin, middle, level + 1);
+                });
+                std::vector<Node> right_nodes;
+                build(points, right_nodes, middle, end, level + 1);
+                left.get();
+                append(nodes, left_nodes);
+                nodes[node_index].offset = (int) nodes.size();
+                append(nodes, right_nodes);
+            } else {
+                build(points, nodes, begin, middle, level + 1);
+                nodes[node_index].offset = (int) nodes.size();
+                build(points, nodes, middle, end, level + 1);
+            }
+        } //recursively build node for point range [begin, end), partitioning the index list
+
+        static void append(std::vector<Node> &nodes, const std::vector<Node> &subtree) {
+            int base = (int) nodes.size();
+            for (Node node: subtree) {
+                if (node.axis >= 0) { node.offset += base; } //child indices were relative to the subtree
+                nodes.push_back(node);
+            }
+        } //move a separately built subtree to the end of the node list
+
+        void searchNearest(int index, const FixedVector<dimensions> &query, int k, std::vector<Neighbor> &heap) const {
+            const Node &node = m_nodes[index];
+            if (node.axis < 0) {
+                for (int i = node.offset; i < node.offset + node.count; ++i) {
+                    double distance = query.distanceSquared(m_points[i]);
+                    if ((int) heap.size() < k) {
+                        heap.push_back(Neighbor{m_indices[i], distance});
+                        std::push_heap(heap.begin(), heap.end());
+                    } else if (distance < heap.front().distance_squared) {
+                        std::pop_heap(heap.begin(), heap.end());
+                        heap.back() = Neighbor{m_indices[i], distance};
+                        std::push_heap(heap.begin(), heap.end());
+                    }
+                }
+                return;
+            }
+            double difference = query[node.axis] - node.split;
+            int near = difference < 0 ? index + 1 : node.offset;
+            int far = difference < 0 ? node.offset : index + 1;
+            searchNearest(near, query, k, heap);
+            //the other side can only help if the splitting plane is closer than the worst neighbor
+            if ((int) heap.size() < k || difference * difference < heap.front().distance_squared) {
+                searchNearest(far, query, k, heap);
+            }
+        } //recursive k nearest search, near side first
+
+        void searchRadius(int index, const FixedVector<dimensions> &query, double radius_squared,
+                          std::vector<Neighbor> &out) const {
+            const Node &node = m_nodes[index];
+            if (node.axis < 0) {
+                for (int i = node.offset; i < node.offset + node.count; ++i) {
+                    double distance = query.distanceSquared(m_points[i]);
+                    if (distance <= radius_squared) { out.push_back(Neighbor{m_indices[i], distance}); }
+                }
+                return;
+            }
+            double difference = query[node.axis] - node.split;
+            if (difference < 0 || difference * difference <= radius_squared) {
+                searchRadius(index + 1, query, radius_squared, out);
+            }
+            if (difference >= 0 || difference * difference <= radius_squared) {
+                searchRadius(node.offset, query, radius_squared, out);
+            }
+        } //recursive radius search, skipping sides further than the radius
+
+        template<class Function>
+        static void parallelQueries(int count, Function function) {
+            int threads = std::max(1, std::min((int) std::thread::hardware_concurrency(), count / QUERY_CHUNK));
+            if (threads == 1) {
+                for (int i = 0; i < count; ++i) { function(i); }
+                return;
+            }
+            std::vector<std::thread> workers;
+            for (int t = 0; t < threads; ++t) {
+                workers.emplace_back([=] {
+                    int begin = (int) ((long long) count * t / threads); //the product passes INT_MAX for large counts
+                    int end = (int) ((long long) count * (t + 1) / threads);
+                    for (int i = begin; i < end; ++i) { function(i); }
+                });
+            }
+            for (std::thread &worker: workers) { worker.join(); }
+        } //run function(i) for every query, in contiguous chunks per thread
+    };
+
+}
+
+#endif //TENSORMATH_KDTREE_HPP
@@ -0,0 +1,364 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+//kernel bodies, included once per instruction set by Dispatch.hpp(no include guard on purpose)
+//the includer defines TENSORMATH_KERNEL_NAMESPACE and switches the compiler target around the include
+//every kernel uses the same operation order on every instruction set and none of them use fused multiply add,
+//so all paths give bit identical results, only the width of the generated SIMD code changes
+
+namespace TENSORMATH_KERNEL_NAMESPACE {
+
+    constexpr int GEMM_REGISTER_VALUES = 64; //values of c the small gemm kernels keep in registers
+
+    inline void add(const double *TENSORMATH_RESTRICT a, const double *TENSORMATH_RESTRICT b,
+                    double *TENSORMATH_RESTRICT out, int count) {
+        TENSORMATH_NO_CONTRACT
+        for (int i = 0; i < count; ++i) { out[i] = a[i] + b[i]; }
+    } //out = a + b
+
+    inline void subtract(const double *TENSORMATH_RESTRICT a, const double *TENSORMATH_RESTRICT b,
+                         double *TENSORMATH_RESTRICT out, int count) {
+        TENSORMATH_NO_CONTRACT
+        for (int i = 0; i < count; ++i) { out[i] = a[i] - b[i]; }
+    } //out = a - b
+
+    inline void multiply(const double *TENSORMATH_RESTRICT a, const double *TENSORMATH_RESTRICT b,
+                         double *TENSORMATH_RESTRICT out, int count) {
+        TENSORMATH_NO_CONTRACT
+        for (int i = 0; i < count; ++i) { out[i] = a[i] * b[i]; }
+    } //out = a * b, component wise
+
+    inline void scale(const double *TENSORMATH_RESTRICT a, double scalar, double *TENSORMATH_RESTRICT out, int count) {
+        TENSORMATH_NO_CONTRACT
+        for (int i = 0; i < count; ++i) { out[i] = a[i] * scalar; }
+    } //out = a * scalar
+
+    inline double dot(const double *TENSORMATH_RESTRICT a, const double *TENSORMATH_RESTRICT b, int count) {
+        TENSORMATH_NO_CONTRACT
+        double sums[8] = {0, 0, 0, 0, 0, 0, 0, 0}; //independent sums, so the loop vectorizes without reordering
+        int i = 0;
+        for (; i + 8 <= count; i += 8) {
+            for (int j = 0; j < 8; ++j) { sums[j] += a[i + j] * b[i + j]; }
+        }
+        for (; i < count; ++i) { sums[i & 7] += a[i] * b[i]; }
+        return ((sums[0] + sums[1]) + (sums[2] + sums[3])) + ((sums[4] + sums[5]) + (sums[6] + sums[7]));
+    } //a . b
+
+    inline void gemv(const double *TENSORMATH_RESTRICT a, int lda, int rows, int columns,
+                     const double *TENSORMATH_RESTRICT x, double *TENSORMATH_RESTRICT y) {
+        TENSORMATH_NO_CONTRACT
+        for (int c = 0; c < columns; ++c) { y[c] = dot(a + (long long) c * lda, x, rows); }
+    } //y[c] = column c of a . x, for a column major rows x columns matrix with column stride lda
+
+    inline void gemm(int m, int n, int k, const double *TENSORMATH_RESTRICT a, int lda,
+                     const double *TENSORMATH_RESTRICT b, int ldb, double *TENSORMATH_RESTRICT c, int ldc) {
+        TENSORMATH_NO_CONTRACT
+        constexpr int BLOCK_M = 128; //rows of a kept in cache
+        constexpr int BLOCK_K = 256; //columns of a kept in cache
+        for (int j = 0; j < n; ++j) {
+            for (int i = 0; i < m; ++i) { c[i + (long long) j * ldc] = 0; }
+        }
+        for (int p_start = 0; p_start < k; p_start += BLOCK_K) {
+            int p_end = p_start + BLOCK_K < k ? p_start + BLOCK_K : k;
+            for (int i_start = 0; i_start < m; i_start += BLOCK_M) {
+                int i_end = i_start + BLOCK_M < m ? i_start + BLOCK_M : m;
+                for (int j = 0; j < n; ++j) {
+                    double *TENSORMATH_RESTRICT c_column = c + (long long) j * ldc;
+                    for (int p = p_start; p < p_end; ++p) {
+                        const double b_value = b[p + (long long) j * ldb];
+                        const double *TENSORMATH_RESTRICT a_column = a + (long long) p * lda;
+                        for (int i = i_start; i < i_end; ++i) { c_column[i] += a_column[i] * b_value; }
+                    }
+                }
+            }
+        }
+    } //c = a * b, all column major. a is m x k, b is k x n, c is m x n. Every c value sums over k in order.
+
+    template<int M, int COLUMNS>
+    TENSORMATH_NO_LOOP_VECTORIZE inline void gemmColumns(int k, const double *TENSORMATH_RESTRICT a, int lda, const double *TENSORMATH_RESTRICT b,
+                            int ldb, double *TENSORMATH_RESTRICT c, int ldc) {
+        TENSORMATH_NO_CONTRACT
+        double sums[COLUMNS][M]; //COLUMNS columns of c, kept in registers
+        for (int j = 0; j < COLUMNS; ++j) {
+            for (int i = 0; i < M; ++i) { sums[j][i] = 0; }
+        }
+        for (int p = 0; p < k; ++p) {
+            const double *TENSORMATH_RESTRICT a_column = a + (long long) p * lda;
+            for (int j = 0; j < COLUMNS; ++j) {
+                const double b_value = b[p + (long long) j * ldb];
+                TENSORMATH_UNROLL
+                for (int i = 0; i < M; ++i) { sums[j][i] += a_column[i] * b_value; }
+            }
+        }
+        for (int j = 0; j < COLUMNS; ++j) {
+            for (int i = 0; i < M; ++i) { c[i + (long long) j * ldc] = sums[j][i]; }
+        }
+    } //COLUMNS columns of c for a compile time number of rows, same sum order as gemm(the unrolled rows are still SIMD)
+
+    template<int M>
+    inline void gemmRows(int n, int k, const double *TENSORMATH_RESTRICT a, int lda,
+                         const double *TENSORMATH_RESTRICT b, int ldb, double *TENSORMATH_RESTRICT c, int ldc) {
+        //enough columns at once for independent sums to hide add latency, without running out of registers
+        constexpr int COLUMNS = M >= GEMM_REGISTER_VALUES ? 1 : GEMM_REGISTER_VALUES / M;
+        int j = 0;
+        for (; j + COLUMNS <= n; j += COLUMNS) {
+            gemmColumns<M, COLUMNS>(k, a, lda, b + (long long) j * ldb, ldb, c + (long long) j * ldc, ldc);
+        }
+        for (; j < n; ++j) {
+            gemmColumns<M, 1>(k, a, lda, b + (long long) j * ldb, ldb, c + (long long) j * ldc, ldc);
+        }
+    } //gemm for a compile time number of rows
+
+    inline void gemmBatch(int m, int n, int k, const double *a, int lda, long long stride_a, const double *b, int ldb,
+                          long long stride_b, double *c, int ldc, long long stride_c, int count) {
+        for (int item = 0; item < count; ++item) {
+            const double *a_item = a + item * stride_a;
+            const double *b_item = b + item * stride_b;
+            double *c_item = c + item * stride_c;
+            switch (m) { //common small sizes get fully unrolled columns
+                case 4: gemmRows<4>(n, k, a_item, lda, b_item, ldb, c_item, ldc); break;
+                case 8: gemmRows<8>(n, k, a_item, lda, b_item, ldb, c_item, ldc); break;
+                case 16: gemmRows<16>(n, k, a_item, lda, b_item, ldb, c_item, ldc); break;
+                case 32: gemmRows<32>(n, k, a_item, lda, b_item, ldb, c_item, ldc); break;
+                default: gemm(m, n, k, a_item, lda, b_item, ldb, c_item, ldc);
+            }
+        }
+    } //count independent gemm products, item i starts i * stride values after the first one of each array
+
+    inline void transform(const double *TENSORMATH_RESTRICT matrix, int width, int height,
+                          const double *TENSORMATH_RESTRICT in, double *TENSORMATH_RESTRICT out, int count) {
+        TENSORMATH_NO_CONTRACT
+        for (int v = 0; v < count; ++v) {
+            gemv(matrix, height, height, width, in + (long long) v * height, out + (long long) v * width);
+        }
+    } //gemv for count packed vectors of size height, writing count packed vectors of size width
+
+    //ELEMENTWISE FUNCTIONS
+    //branch free polynomial versions of the math functions, so whole blocks vectorize like the kernels above
+    //every function is also called with out == in, so values go through a local block that can not alias
+
+    constexpr int FUNCTION_BLOCK = 256; //values per local block
+    constexpr double ROUND_SHIFT = 6755399441055744.0; //1.5 * 2^52, adding it rounds to an integer kept in the low bits
+    constexpr uint64_t ROUND_SHIFT_BITS = 0x4338000000000000ULL; //bits of ROUND_SHIFT
+    constexpr double LN2_HI = 6.93147180369123816490e-01; //ln(2) in two parts, n * LN2_HI is exact for |n| < 2^11
+    constexpr double LN2_LO = 1.90821492927058770002e-10;
+    constexpr double LOG2_E = 1.44269504088896338700e+00;
+    constexpr double PIO2_1 = 1.57079632673412561417e+00; //pi/2 in three parts, n * part is exact for |n| < 2^20
+    constexpr double PIO2_2 = 6.07710050630396597660e-11;
+    constexpr double PIO2_3 = 2.02226624871116645580e-21;
+    constexpr double TWO_OVER_PI = 6.36619772367581382433e-01;
+    constexpr double TRIG_LIMIT = 1e5; //sin and cos of larger arguments use std::sin and std::cos
+
+    inline double fromBits(uint64_t bits) {
+        double value;
+        std::memcpy(&value, &bits, sizeof(double));
+        return value;
+    } //reinterpret bits as a double
+    inline uint64_t toBits(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(double));
+        return bits;
+    } //reinterpret a double as bits
+
+    inline double expReduced(double r) {
+        double p = 1.0 / 6227020800.0; //Taylor series to r^13, truncation error below 2^-57 for |r| <= ln(2)/2
+        p = 1.0 / 479001600.0 + r * p;
+        p = 1.0 / 39916800.0 + r * p;
+        p = 1.0 / 3628800.0 + r * p;
+        p = 1.0 / 362880.0 + r * p;
+        p = 1.0 / 40320.0 + r * p;
+        p = 1.0 / 5040.0 + r * p;
+        p = 1.0 / 720.0 + r * p;
+        p = 1.0 / 120.0 + r * p;
+        p = 1.0 / 24.0 + r * p;
+        p = 1.0 / 6.0 + r * p;
+        p = 0.5 + r * p;
+        p = 1.0 + r * p;
+        return r * p;
+    } //e^r - 1, for |r| <= ln(2)/2
+
+    //ranges and special cases are handled by selecting results at the end, never by branching around arithmetic,
+    //so the compiler can turn each function into straight vector code
+
+    inline double expValue(double x) {
+        double shifted = x * LOG2_E + ROUND_SHIFT;
+        double n = shifted - ROUND_SHIFT; //x = n * ln(2) + r
+        //exponent arithmetic is unsigned: it wraps(defined) for inf, NaN and huge x, whose results are selected below
+        uint64_t k = toBits(shifted) - ROUND_SHIFT_BITS; //n, two's complement
+        double r = (x - n * LN2_HI) - n * LN2_LO;
+        //2^k in two factors, so results in the subnormal range are rounded once
+        uint64_t k_1 = ((k + 2048) >> 1) - 1024;
+        uint64_t k_2 = k - k_1;
+        double scaled = (1.0 + expReduced(r)) * fromBits((k_1 + 1023) << 52);
+        double result = scaled * fromBits((k_2 + 1023) << 52);
+        result = x > 710.0 ? HUGE_VAL : result; //past the overflow and underflow points, NaN stays NaN
+        return x < -746.0 ? 0.0 : result;
+    } //e^x
+
+    inline double logValue(double x) {
+        constexpr double LG1 = 6.666666666666735130e-01, LG2 = 3.999999999940941908e-01,
+                LG3 = 2.857142874366239149e-01, LG4 = 2.222219843214978396e-01, LG5 = 1.818357216161805012e-01,
+                LG6 = 1.531383769920937332e-01, LG7 = 1.479819860511658591e-01; //minimax for log(1+f), fdlibm
+        bool subnormal = x < 2.2250738585072014e-308;
+        double scaled = x * 18014398509481984.0; //subnormals are scaled by 2^54
+        uint64_t bits = toBits(subnormal ? scaled : x);
+        //x = m * 2^e with m in [sqrt(2)/2, sqrt(2))
+        long long e = (long long) ((bits >> 52) & 0x7FF) - (subnormal ? 1023 + 54 : 1023);
+        double m = fromBits((bits & 0x000FFFFFFFFFFFFFULL) | 0x3FF0000000000000ULL);
+        bool high = m > 1.41421356237309504880;
+        double half = m * 0.5;
+        m = high ? half : m;
+        e = high ? e + 1 : e;
+        double exponent = fromBits(ROUND_SHIFT_BITS + (uint64_t) e) - ROUND_SHIFT; //exact conversion
+        double f = m - 1.0;
+        double s = f / (2.0 + f);
+        double z = s * s;
+        double series = z * (LG1 + z * (LG2 + z * (LG3 + z * (LG4 + z * (LG5 + z * (LG6 + z * LG7))))));
+        double half_square = 0.5 * f * f;
+        double result = exponent * LN2_HI - ((half_square - (s * (half_square + series) + exponent * LN2_LO)) - f);
+        result = x > 0.0 ? result : (x == 0.0 ? -HUGE_VAL : std::numeric_limits<double>::quiet_NaN());
+        return x == HUGE_VAL ? HUGE_VAL : result;
+    } //natural logarithm, NaN below zero
+
+    inline double sinReduced(double r) {
+        constexpr double S1 = -1.66666666666666324348e-01, S2 = 8.33333333332248946124e-03,
+                S3 = -1.98412698298579493134e-04, S4 = 2.75573137070700676789e-06, S5 = -2.50507602534068634195e-08,
+                S6 = 1.58969099521155010221e-10; //minimax, fdlibm
+        double z = r * r;
+        return r + r * z * (S1 + z * (S2 + z * (S3 + z * (S4 + z * (S5 + z * S6)))));
+    } //sin(r), for |r| <= pi/4
+    inline double cosReduced(double r) {
+        constexpr double C1 = 4.16666666666666019037e-02, C2 = -1.38888888888741095749e-03,
+                C3 = 2.48015872894767294178e-05, C4 = -2.75573143513906633035e-07, C5 = 2.08757232129817482790e-09,
+                C6 = -1.13596475577881948265e-11; //minimax, fdlibm
+        double z = r * r;
+        double half = 0.5 * z;
+        double w = 1.0 - half;
+        return w + (((1.0 - w) - half) + z * z * (C1 + z * (C2 + z * (C3 + z * (C4 + z * (C5 + z * C6))))));
+    } //cos(r), for |r| <= pi/4
+
+    inline double sinValue(double x, uint64_t quarter_offset) {
+        double shifted = x * TWO_OVER_PI + ROUND_SHIFT;
+        double n = shifted - ROUND_SHIFT; //x = n * pi/2 + r
+        uint64_t quarter = toBits(shifted) - ROUND_SHIFT_BITS + quarter_offset;
+        double r = ((x - n * PIO2_1) - n * PIO2_2) - n * PIO2_3;
+        double sin_r = sinReduced(r);
+        double cos_r = cosReduced(r);
+        double value = (quarter & 1) ? cos_r : sin_r;
+        return (quarter & 2) ? -value : value;
+    } //sin(x + offset * pi/2) for |x| <= TRIG_LIMIT
+
+    inline double tanhValue(double x) {
+        double a = std::fabs(x);
+        //e^(2a) - 1 without cancellation, 2a = n * ln(2) + r
+        double shifted = 2.0 * a * LOG2_E + ROUND_SHIFT;
+        double n = shifted - ROUND_SHIFT;
+        uint64_t k = toBits(shifted) - ROUND_SHIFT_BITS; //unsigned, wraps(defined) for a > 20, selected below
+        double r = (2.0 * a - n * LN2_HI) - n * LN2_LO;
+        double power = fromBits((k + 1023) << 52);
+        double e = power * expReduced(r) + (power - 1.0);
+        double result = e / (e + 2.0);
+        result = a > 20.0 ? 1.0 : result; //tanh(20) rounds to 1, NaN stays NaN
+        return std::copysign(result, x);
+    } //tanh(x) = (e^2x - 1) / (e^2x + 1)
+
+    inline double sigmoidValue(double x) {
+        double e = expValue(-std::fabs(x)); //never overflows
+        double s = 1.0 / (1.0 + e);
+        return x >= 0.0 ? s : e * s;
+    } //1 / (1 + e^-x), accurate for large negative x too
+
+    template<class Function>
+    inline void mapBlocks(const double *in, double *out, int count, Function function) {
+        double block[FUNCTION_BLOCK];
+        for (int start = 0; start < count; start += FUNCTION_BLOCK) {
+            int size = count - start < FUNCTION_BLOCK ? count - start : FUNCTION_BLOCK;
+            for (int i = 0; i < size; ++i) { block[i] = function(in[start + i]); }
+            for (int i = 0; i < size; ++i) { out[start + i] = block[i]; }
+        }
+    } //out = function(in) block by block, out may be in
+
+    inline void exp(const double *in, double *out, int count) {
+        TENSORMATH_NO_CONTRACT
+        mapBlocks(in, out, count, [](double x) { return expValue(x); });
+    } //out = e^in, within 1.2 ulp. out may be in.
+
+    inline void log(const double *in, double *out, int count) {
+        TENSORMATH_NO_CONTRACT
+        mapBlocks(in, out, count, [](double x) { return logValue(x); });
+    } //out = ln(in), within 1 ulp. out may be in.
+
+    inline void sqrt(const double *in, double *out, int count) {
+        mapBlocks(in, out, count, [](double x) { return std::sqrt(x); });
+    } //out = sqrt(in), correctly rounded. Vectorized when built with -fno-math-errno. out may be in.
+
+    template<class Exact>
+    inline void trigonometric(const double *in, double *out, int count, uint64_t quarter_offset, Exact exact) {
+        double block[FUNCTION_BLOCK];
+        for (int start = 0; start < count; start += FUNCTION_BLOCK) {
+            int size = count - start < FUNCTION_BLOCK ? count - start : FUNCTION_BLOCK;
+            for (int i = 0; i < size; ++i) { block[i] = sinValue(in[start + i], quarter_offset); }
+            for (int i = 0; i < size; ++i) { //rare large arguments(and inf, NaN) are redone outside the vector loop
+                if (!(std::fabs(in[start + i]) <= TRIG_LIMIT)) { block[i] = exact(in[start + i]); }
+            }
+            for (int i = 0; i < size; ++i) { out[start + i] = block[i]; }
+        }
+    } //mapBlocks for sin and cos
+
+    inline void sin(const double *in, double *out, int count) {
+        TENSORMATH_NO_CONTRACT
+        trigonometric(in, out, count, 0, [](double x) { return std::sin(x); });
+    } //out = sin(in), within 2.5 ulp for |in| <= 1e5, std::sin beyond. out may be in.
+
+    inline void cos(const double *in, double *out, int count) {
+        TENSORMATH_NO_CONTRACT
+        trigonometric(in, out, count, 1, [](double x) { return std::cos(x); });
+    } //out = cos(in), within 2.5 ulp for |in| <= 1e5, std::cos beyond. out may be in.
+
+    inline void tanh(const double *in, double *out, int count) {
+        TENSORMATH_NO_CONTRACT
+        mapBlocks(in, out, count, [](double x) { return tanhValue(x); });
+    } //out = tanh(in), within 3.5 ulp. out may be in.
+
+    inline void sigmoid(const double *in, double *out, int count) {
+        TENSORMATH_NO_CONTRACT
+        mapBlocks(in, out, count, [](double x) { return sigmoidValue(x); });
+    } //out = 1 / (1 + e^-in), within 3 ulp. out may be in.
+
+    inline void relu(const double *in, double *out, int count) {
+        mapBlocks(in, out, count, [](double x) { return x < 0.0 ? 0.0 : x; });
+    } //out = max(in, 0), NaN stays NaN. out may be in.
+
+    //RANDOM NUMBERS
+    inline uint64_t rotateLeft(uint64_t x, int bits) { return (x << bits) | (x >> (64 - bits)); }
+
+    inline void randomStep(uint64_t *TENSORMATH_RESTRICT s0, uint64_t *TENSORMATH_RESTRICT s1,
+                           uint64_t *TENSORMATH_RESTRICT s2, uint64_t *TENSORMATH_RESTRICT s3,
+                           double *TENSORMATH_RESTRICT out) {
+        for (int j = 0; j < RANDOM_LANES; ++j) {
+            uint64_t result = rotateLeft(s1[j] * 5, 7) * 9;
+            uint64_t t = s1[j] << 17;
+            s2[j] ^= s0[j];
+            s3[j] ^= s1[j];
+            s1[j] ^= s2[j];
+            s0[j] ^= s3[j];
+            s2[j] ^= t;
+            s3[j] = rotateLeft(s3[j], 45);
+            out[j] = fromBits(0x3FF0000000000000ULL | (result >> 12)) - 1.0; //top 52 bits as [1, 2), minus 1
+        }
+    } //one xoshiro256** step of every generator, one value each
+
+    inline void random(uint64_t *TENSORMATH_RESTRICT state, double *TENSORMATH_RESTRICT out, int count) {
+        uint64_t *s0 = state, *s1 = state + RANDOM_LANES, *s2 = state + 2 * RANDOM_LANES, *s3 = state + 3 * RANDOM_LANES;
+        int start = 0;
+        for (; start + RANDOM_LANES <= count; start += RANDOM_LANES) { randomStep(s0, s1, s2, s3, out + start); }
+        if (start < count) {
+            double block[RANDOM_LANES];
+            randomStep(s0, s1, s2, s3, block);
+            for (int i = 0; start + i < count; ++i) { out[start + i] = block[i]; }
+        }
+    } //out = uniform values in [0, 1), value i from generator i % RANDOM_LANES. state is 4 words per generator,
+      //word w of generator j at state[w * RANDOM_LANES + j], and is advanced.
+
+}
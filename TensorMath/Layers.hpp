@@ -0,0 +1,115 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_LAYERS_HPP
+#define TENSORMATH_LAYERS_HPP
+
+#include "Functions.hpp"
+
+//fused dense layer: out = activation(weights * input + bias), and the matching backward pass
+//samples are columns: input is inputs x samples, weights is outputs x inputs, out is outputs x samples
+//the output is made a tile of samples at a time: the product, bias and activation all run while the tile is in cache,
+//so a layer is one pass over the output instead of three, and writes into memory the caller already owns
+//fastest when every matrix is column major(the default), other layouts are packed first
+
+namespace TensorMath {
+
+    //activation function applied after the bias
+    enum class Activation {
+        None, //out = x
+        Relu, //out = max(x, 0)
+        Sigmoid, //out = 1 / (1 + e^-x)
+        Tanh //out = tanh(x)
+    };
+
+    namespace Layers {
+        constexpr int TILE_SAMPLES = 32; //samples per output tile, kept in cache from the product to the activation
+
+        inline void activate(VectorView values, Activation activation) {
+            switch (activation) {
+                case Activation::Relu: relu(values, values); break;
+                case Activation::Sigmoid: sigmoid(values, values); break;
+                case Activation::Tanh: tanh(values, values); break;
+                default: break;
+            }
+        } //apply an activation in place
+
+        inline double derivative(double output, Activation activation) {
+            switch (activation) {
+                case Activation::Relu: return output > 0 ? 1.0 : 0.0;
+                case Activation::Sigmoid: return output * (1.0 - output);
+                case Activation::Tanh: return 1.0 - output * output;
+                default: return 1.0;
+            }
+        } //slope of an activation, from its output
+    }
+
+    inline void linearForward(const ConstMatrixView &weights, const ConstMatrixView &input, const ConstVectorView &bias,
+                              Activation activation, MatrixView out) {
+        assert(weights.getWidth() == input.getHeight()); //weights need one column per input
+        assert(bias.getDim() == weights.getHeight()); //one bias per output
+        assert(out.getWidth() == input.getWidth() && out.getHeight() == weights.getHeight()); //output must be result size
+        TENSORMATH_TIME(Layers);
+        TENSORMATH_TRACE_SCOPE("linearForward", weights.getHeight(), input.getWidth(), weights.getWidth(),
+                               2 * (uint64_t) weights.getHeight() * input.getWidth() * weights.getWidth());
+        std::vector<double> weight_storage;
+        ConstMatrixView packed_weights = packColumnMajor(weights, weight_storage); //once, not for every tile
+        int outputs = weights.getHeight(), inputs = weights.getWidth();
+        parallelFor((size_t) input.getWidth(), [&](size_t begin, size_t end) {
+            for (int start = (int) begin; start < (int) end; start += Layers::TILE_SAMPLES) {
+                int samples = std::min(Layers::TILE_SAMPLES, (int) end - start);
+                MatrixView tile = out.block(start, 0, samples, outputs);
+                multiply(packed_weights, input.block(start, 0, samples, inputs), tile);
+                for (int x = 0; x < samples; ++x) { //epilogue while the tile is still in cache
+                    VectorView column = tile.column(x);
+                    column += bias;
+                    Layers::activate(column, activation);
+                }
+            }
+        }, (size_t) outputs * inputs);
+    } //out = activation(weights * input + bias). out must not overlap the other arguments.
+
+    inline void activationBackward(const ConstMatrixView &output, const ConstMatrixView &gradient,
+                                   Activation activation, MatrixView out) {
+        assert(gradient.getWidth() == output.getWidth() && gradient.getHeight() == output.getHeight()); //must be same size
+        assert(out.getWidth() == output.getWidth() && out.getHeight() == output.getHeight()); //output must be same size
+        TENSORMATH_TIME(Layers);
+        parallelFor((size_t) output.getWidth(), [&](size_t begin, size_t end) {
+            for (int x = (int) begin; x < (int) end; ++x) {
+                for (int y = 0; y < output.getHeight(); ++y) {
+                    out.atUnchecked(x, y) = gradient.atUnchecked(x, y) * Layers::derivative(output.atUnchecked(x, y), activation);
+                }
+            }
+        }, (size_t) output.getHeight());
+    } //out = gradient * activation'(output), from the output linearForward wrote. out may be gradient.
+
+    inline void linearBackward(const ConstMatrixView &weights, const ConstMatrixView &input,
+                               const ConstMatrixView &output, MatrixView gradient, Activation activation,
+                               MatrixView weight_gradient, VectorView bias_gradient) {
+        assert(weights.getWidth() == input.getHeight()); //weights need one column per input
+        assert(output.getWidth() == input.getWidth() && output.getHeight() == weights.getHeight()); //output of the layer
+        assert(gradient.getWidth() == output.getWidth() && gradient.getHeight() == output.getHeight()); //one per output
+        assert(weight_gradient.getWidth() == weights.getWidth() && weight_gradient.getHeight() == weights.getHeight()); //one per weight
+        assert(bias_gradient.getDim() == weights.getHeight()); //one per output
+        TENSORMATH_TIME(Layers);
+        TENSORMATH_TRACE_SCOPE("linearBackward", weights.getHeight(), input.getWidth(), weights.getWidth(),
+                               2 * (uint64_t) weights.getHeight() * input.getWidth() * weights.getWidth());
+        activationBackward(output, gradient, activation, gradient); //gradient before the activation
+        multiply(gradient, input.transposed(), weight_gradient);
+        bias_gradient = 0.0;
+        for (int x = 0; x < gradient.getWidth(); ++x) { bias_gradient += gradient.column(x); } //sum over samples
+    } //weight and bias gradients of a linearForward layer, summed over samples. gradient(of the loss by output)
+      //is overwritten with the gradient before the activation.
+
+    inline void linearBackward(const ConstMatrixView &weights, const ConstMatrixView &input,
+                               const ConstMatrixView &output, MatrixView gradient, Activation activation,
+                               MatrixView weight_gradient, VectorView bias_gradient, MatrixView input_gradient) {
+        assert(input_gradient.getWidth() == input.getWidth() && input_gradient.getHeight() == input.getHeight()); //one per input
+        TENSORMATH_TIME(Layers);
+        linearBackward(weights, input, output, gradient, activation, weight_gradient, bias_gradient);
+        multiply(weights.transposed(), gradient, input_gradient);
+    } //linearBackward, plus the gradient of the loss by the input for the layer before
+}
+
+#endif //TENSORMATH_LAYERS_HPP
@@ -0,0 +1,410 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_LAZY_HPP
+#define TENSORMATH_LAZY_HPP
+
+#include "Functions.hpp"
+
+//lazy evaluation of matrix expressions
+//operations on Expressions only record nodes in an ExpressionGraph, nothing is computed until evaluate()
+//evaluate() then plans the whole expression at once:
+//  - chains of elementwise operations are fused into one pass that reads every input once and writes the result once,
+//    a block of each column at a time so all temporaries stay in cache
+//  - a product whose only use is such a chain is computed a tile of columns at a time straight into the destination,
+//    and the chain runs on each tile while it is still in cache(the epilogue), so the product has no buffer of its own
+//  - everything else that needs a whole matrix(products, operands of products, values used twice) gets a buffer from
+//    a pool, and a buffer goes back to the pool after its last use, so later steps reuse it
+//the pool, the plan and the per thread scratch space keep their memory across reset(), so once they have grown to fit,
+//repeated evaluations of the same shapes into an existing destination do not allocate
+//inputs are views, not copies: their memory must stay valid and unchanged until evaluate()
+
+namespace TensorMath {
+
+    class ExpressionGraph;
+
+    //handle to a node of an expression graph, cheap to copy
+    struct Expression {
+        ExpressionGraph *graph;
+        int index; //node in the graph
+    };
+
+    namespace Lazy {
+        constexpr int BLOCK = 512; //values of a column a fused pass evaluates at once
+        constexpr int TILE = 16; //columns of a fused product computed before its epilogue runs on them
+
+        //recorded operations
+        enum class Operation {
+            Input, Multiply, Add, Subtract, Hadamard, Scale, AddBias, Exp, Log, Sqrt, Sin, Cos, Tanh, Sigmoid, Relu
+        };
+
+        //one recorded operation
+        struct Node {
+            Operation operation;
+            int a, b; //input nodes, -1 if unused
+            int width, height;
+            double scalar; //factor for Scale
+            ConstMatrixView input; //values of an Input(views can not be rebound, so set when recorded)
+        };
+
+        //one instruction of a fused pass, operands are earlier steps
+        struct Step {
+            Operation operation; //Input for a value read from memory
+            int a, b; //operand steps
+            int node; //node read by an Input step
+            bool broadcast; //read column 0 for every column(bias)
+            double scalar;
+        };
+
+        //one node computed into memory, in the order they run
+        struct Task {
+            int node;
+            int fused; //product computed into this task's destination tile by tile, -1 if none
+            int first, steps; //fused pass, the steps from first in the graph's step list. None for a plain product.
+        };
+
+        //scratch space of a fused pass, one per thread
+        struct Workspace {
+            std::vector<double> slots; //BLOCK values per step
+            std::vector<const double *> values; //where each step's values are
+        };
+
+        inline Workspace &workspace(int steps) {
+            thread_local Workspace buffers;
+            if ((int) buffers.values.size() < steps) {
+                buffers.values.resize(steps);
+                buffers.slots.resize((size_t) steps * BLOCK);
+            }
+            return buffers;
+        } //scratch space kept between passes, so repeated passes do not allocate
+
+        inline Functions::Kernel functionKernel(Operation operation) {
+            const KernelTable &table = kernels();
+            switch (operation) {
+                case Operation::Exp: return table.exp;
+                case Operation::Log: return table.log;
+                case Operation::Sqrt: return table.sqrt;
+                case Operation::Sin: return table.sin;
+                case Operation::Cos: return table.cos;
+                case Operation::Tanh: return table.tanh;
+                case Operation::Sigmoid: return table.sigmoid;
+                default: return table.relu;
+            }
+        } //kernel of an elementwise function
+    }
+
+    //recording of matrix operations, evaluated on demand
+    class ExpressionGraph {
+    public:
+        //CONSTRUCTORS
+            explicit ExpressionGraph(int nodes = 0) { m_nodes.reserve(nodes); } //graph with room for nodes operations
+            ExpressionGraph(const ExpressionGraph &other) = delete; //Expressions point to their graph
+            ExpressionGraph &operator=(const ExpressionGraph &other) = delete;
+
+        //SETTERS AND GETTERS
+            int getNodeCount() const { return (int) m_nodes.size(); } //get number of recorded operations
+            int getWidth(const Expression &expression) const { return m_nodes[expression.index].width; } //get result width
+            int getHeight(const Expression &expression) const { return m_nodes[expression.index].height; } //get result height
+            int getBufferCount() const { return (int) m_buffers.size(); } //get number of buffers in the pool
+            size_t getPeakBytes() const { return m_peak_bytes; } //get most buffer bytes in use at once by the last evaluation
+
+        //RECORDING
+            Expression input(const ConstMatrixView &value) {
+                m_nodes.push_back({Lazy::Operation::Input, -1, -1, value.getWidth(), value.getHeight(), 0, value});
+                return {this, (int) m_nodes.size() - 1};
+            } //record a matrix or view without copying it. It must stay valid until evaluate().
+            Expression input(const ConstVectorView &value) {
+                return input(ConstMatrixView(value.data(), 1, value.getDim(), value.getDim() * value.getStride(), value.getStride()));
+            } //record a vector, as one column
+            Expression record(Lazy::Operation operation, int a, int b, int width, int height, double scalar = 0) {
+                m_nodes.push_back({operation, a, b, width, height, scalar, ConstMatrixView(nullptr, 0, 0, 0, 0)});
+                return {this, (int) m_nodes.size() - 1};
+            } //record an operation, used by the Expression operations
+            void reset() {
+                m_nodes.clear();
+            } //forget all operations, keeping the buffer pool
+
+        //EVALUATING
+            void evaluate(const Expression &result, MatrixView out) {
+                assert(result.graph == this); //expression from another graph
+                const Lazy::Node &node = m_nodes[result.index];
+                assert(out.getWidth() == node.width && out.getHeight() == node.height); //output must be result size
+                TENSORMATH_TRACE_SCOPE("evaluate", node.width, node.height, 0, 0);
+                if (node.operation == Lazy::Operation::Input) { //nothing to compute
+                    out = node.input;
+                    return;
+                }
+                plan(result.index);
+                m_free.assign(m_buffers.size(), 1);
+                m_in_use = 0;
+                m_peak_bytes = 0;
+                for (int task = 0; task < (int) m_tasks.size(); ++task) {
+                    int index = m_tasks[task].node;
+                    if (index == result.index && out.isColumnMajor()) {
+                        m_data[index] = out.data();
+                        m_stride[index] = out.getColumnStride();
+                    } else { //intermediate, or a result that is not column major
+                        acquire(index);
+                    }
+                    run(m_tasks[task]);
+                    for (int used = 0; used < result.index; ++used) {
+                        if (m_last_use[used] == task && m_buffer[used] >= 0) { release(used); }
+                    }
+                }
+                if (!out.isColumnMajor()) {
+                    out = value(result.index);
+                    release(result.index);
+                }
+            } //compute an expression into out. out must not overlap the inputs.
+            Matrix evaluate(const Expression &result) {
+                Matrix out(getWidth(result), getHeight(result));
+                evaluate(result, out.view());
+                return out;
+            } //compute an expression into a new matrix
+
+    private:
+        std::vector<Lazy::Node> m_nodes;
+        std::vector<std::vector<double>> m_buffers; //pool of intermediate buffers
+        std::vector<char> m_free; //buffers not in use
+        size_t m_in_use = 0, m_peak_bytes = 0; //buffer bytes in use, most at once
+        //plan of the last evaluation, one entry per node
+        std::vector<int> m_uses; //times a node is read
+        std::vector<char> m_materialized; //computed into memory, not fused into the pass that reads it
+        std::vector<int> m_last_use; //last task that reads a node, -1 for none
+        std::vector<int> m_buffer; //pool buffer of a node, -1 for none
+        std::vector<double *> m_data; //values of a computed node, column major
+        std::vector<int> m_stride; //column stride of them
+        std::vector<char> m_reachable; //read by the result
+        std::vector<int> m_task_of; //task computing a node, -1 for none
+        std::vector<Lazy::Task> m_tasks;
+        std::vector<Lazy::Step> m_steps; //programs of all tasks
+        std::vector<double> m_a_storage, m_b_storage; //product operands packed column major
+
+        ConstMatrixView value(int index) const {
+            const Lazy::Node &node = m_nodes[index];
+            if (node.operation == Lazy::Operation::Input) { return node.input; }
+            return ConstMatrixView(m_data[index], node.width, node.height, m_stride[index], 1);
+        } //values of an input or a computed node
+
+        void plan(int result) {
+            using Lazy::Operation;
+            int count = result + 1; //nodes only read earlier nodes
+            m_uses.assign(count, 0);
+            m_materialized.assign(count, 0);
+            m_last_use.assign(count, -1);
+            m_buffer.assign(count, -1);
+            m_data.assign(count, nullptr);
+            m_stride.assign(count, 0);
+            m_tasks.clear();
+            m_steps.clear();
+            std::vector<char> &reachable = m_reachable;
+            reachable.assign(count, 0);
+            reachable[result] = 1;
+            for (int i = result; i >= 0; --i) {
+                if (!reachable[i]) { continue; }
+                const Lazy::Node &node = m_nodes[i];
+                if (node.a >= 0) { reachable[node.a] = 1; m_uses[node.a]++; }
+                if (node.b >= 0) { reachable[node.b] = 1; m_uses[node.b]++; }
+                m_materialized[i] |= node.operation == Operation::Input || node.operation == Operation::Multiply ||
+                                     m_uses[i] > 1 || i == result;
+                if (node.operation == Operation::Multiply) { m_materialized[node.a] = m_materialized[node.b] = 1; }
+                if (node.operation == Operation::AddBias) { m_materialized[node.b] = 1; }
+            } //uses are final before a node is reached, every reader comes later
+            std::vector<int> &task_of = m_task_of;
+            task_of.assign(count, -1);
+            for (int i = 0; i < count; ++i) {
+                if (!reachable[i] || !m_materialized[i] || m_nodes[i].operation == Operation::Input) { continue; }
+                Lazy::Task task{i, -1, (int) m_steps.size(), 0};
+                if (m_nodes[i].operation != Operation::Multiply) { task.steps = compile(i, i, false, task.first) + 1; }
+                for (int s = task.first; s < task.first + task.steps; ++s) { //fuse a product read only here into this pass
+                    const Lazy::Step &step = m_steps[s];
+                    const Lazy::Node &read = m_nodes[step.node];
+                    if (step.operation == Operation::Input && !step.broadcast && read.operation == Operation::Multiply &&
+                        m_uses[step.node] == 1 && task.fused < 0) {
+                        task.fused = step.node;
+                        m_tasks[task_of[step.node]].node = -1; //no separate task
+                    }
+                }
+                task_of[i] = (int) m_tasks.size();
+                m_tasks.push_back(task);
+            }
+            m_tasks.erase(std::remove_if(m_tasks.begin(), m_tasks.end(), [](const Lazy::Task &task) { return task.node < 0; }),
+                          m_tasks.end());
+            for (int t = 0; t < (int) m_tasks.size(); ++t) {
+                const Lazy::Task &task = m_tasks[t];
+                for (int s = task.first; s < task.first + task.steps; ++s) {
+                    if (m_steps[s].operation == Operation::Input) { m_last_use[m_steps[s].node] = t; }
+                }
+                for (int product: {task.steps == 0 ? task.node : -1, task.fused}) {
+                    if (product >= 0) { m_last_use[m_nodes[product].a] = m_last_use[m_nodes[product].b] = t; }
+                }
+            }
+        } //choose what is computed into memory, what is fused, and when buffers are last read
+
+        int compile(int index, int root, bool broadcast, int first) {
+            const Lazy::Node &node = m_nodes[index];
+            Lazy::Step step{node.operation, -1, -1, index, broadcast, node.scalar};
+            if (index != root && m_materialized[index]) {
+                step.operation = Lazy::Operation::Input; //read from memory
+            } else {
+                step.a = compile(node.a, root, false, first);
+                if (node.b >= 0) { step.b = compile(node.b, root, node.operation == Lazy::Operation::AddBias, first); }
+            }
+            m_steps.push_back(step);
+            return (int) m_steps.size() - 1 - first;
+        } //add the steps computing a node to the pass starting at step first, returns the step holding it
+
+        void acquire(int index) {
+            size_t size = (size_t) m_nodes[index].width * m_nodes[index].height;
+            int best = -1;
+            for (int i = 0; i < (int) m_buffers.size(); ++i) {
+                if (m_free[i] && m_buffers[i].size() >= size && (best < 0 || m_buffers[i].size() < m_buffers[best].size())) {
+                    best = i;
+                }
+            }
+            if (best < 0) { //none fits, grow the largest free one(so the pool settles on the sizes it needs) or add one
+                for (int i = 0; i < (int) m_buffers.size(); ++i) {
+                    if (m_free[i] && (best < 0 || m_buffers[i].size() > m_buffers[best].size())) { best = i; }
+                }
+                if (best < 0) {
+                    best = (int) m_buffers.size();
+                    m_buffers.emplace_back();
+                    m_free.push_back(1);
+                }
+                m_buffers[best].resize(size);
+            }
+            m_free[best] = 0;
+            m_buffer[index] = best;
+            m_data[index] = m_buffers[best].data();
+            m_stride[index] = m_nodes[index].height;
+            m_in_use += size * sizeof(double);
+            m_peak_bytes = std::max(m_peak_bytes, m_in_use);
+        } //give a node the smallest free buffer that fits
+
+        void release(int index) {
+            m_free[m_buffer[index]] = 1;
+            m_buffer[index] = -1;
+            m_in_use -= (size_t) m_nodes[index].width * m_nodes[index].height * sizeof(double);
+        } //return a node's buffer to the pool
+
+        void run(const Lazy::Task &task) {
+            const Lazy::Node &node = m_nodes[task.node];
+            MatrixView out(m_data[task.node], node.width, node.height, m_stride[task.node], 1);
+            const Lazy::Step *program = m_steps.data() + task.first;
+            int steps = task.steps;
+            if (steps == 0) { //plain product
+                multiply(packColumnMajor(value(node.a), m_a_storage), packColumnMajor(value(node.b), m_b_storage), out);
+                return;
+            }
+            if (task.fused < 0) {
+                parallelFor((size_t) node.width, [&](size_t begin, size_t end) {
+                    pass(program, steps, out, (int) begin, (int) end, Lazy::workspace(steps));
+                }, (size_t) node.height * steps);
+                return;
+            }
+            const Lazy::Node &product = m_nodes[task.fused];
+            m_data[task.fused] = out.data(); //the product lives in the destination
+            m_stride[task.fused] = out.getColumnStride();
+            ConstMatrixView a = packColumnMajor(value(product.a), m_a_storage); //once, not for every tile
+            ConstMatrixView b = packColumnMajor(value(product.b), m_b_storage);
+            int inner = a.getWidth();
+            parallelFor((size_t) node.width, [&](size_t begin, size_t end) {
+                Lazy::Workspace &workspace = Lazy::workspace(steps);
+                for (int start = (int) begin; start < (int) end; start += Lazy::TILE) {
+                    int columns = std::min(Lazy::TILE, (int) end - start);
+                    multiply(a, b.block(start, 0, columns, inner), out.block(start, 0, columns, node.height));
+                    pass(program, steps, out, start, start + columns, workspace); //epilogue while the tile is still in cache
+                }
+            }, (size_t) node.height * inner);
+        } //compute one node into its destination, the product operands are packed once so no tile copies them
+
+        void pass(const Lazy::Step *program, int steps, MatrixView out, int begin, int end, Lazy::Workspace &workspace) const {
+            using Lazy::Operation;
+            const double **values = workspace.values.data();
+            double *slots = workspace.slots.data();
+            const KernelTable &table = kernels();
+            for (int x = begin; x < end; ++x) {
+                for (int y = 0; y < out.getHeight(); y += Lazy::BLOCK) {
+                    int count = std::min(Lazy::BLOCK, out.getHeight() - y);
+                    for (int s = 0; s < steps; ++s) {
+                        const Lazy::Step &step = program[s];
+                        double *slot = s + 1 == steps ? &out.atUnchecked(x, y) : slots + (size_t) s * Lazy::BLOCK;
+                        const double *a = step.a >= 0 ? values[step.a] : nullptr;
+                        const double *b = step.b >= 0 ? values[step.b] : nullptr;
+                        switch (step.operation) {
+                            case Operation::Input: {
+                                ConstMatrixView source = value(step.node);
+                                int column = step.broadcast ? 0 : x;
+                                if (source.isColumnMajor() && source.data() != out.data()) { //read in place
+                                    slot = (double *) &source.atUnchecked(column, y);
+                                    break;
+                                }
+                                for (int i = 0; i < count; ++i) { slot[i] = source.atUnchecked(column, y + i); }
+                                break; //strided, or the fused product in the destination(kernels must not alias)
+                            }
+                            case Operation::Add: case Operation::AddBias: table.add(a, b, slot, count); break;
+                            case Operation::Subtract: table.subtract(a, b, slot, count); break;
+                            case Operation::Hadamard: table.multiply(a, b, slot, count); break;
+                            case Operation::Scale: table.scale(a, step.scalar, slot, count); break;
+                            default: Lazy::functionKernel(step.operation)(a, slot, count); break;
+                        }
+                        values[s] = slot;
+                    }
+                }
+            }
+        } //run a fused pass of steps steps over columns begin to end of out, a block of each column at a time
+    };
+
+    //OPERATIONS
+    inline Expression operator+(const Expression &a, const Expression &b) {
+        assert(a.graph == b.graph); //expressions from different graphs
+        assert(a.graph->getWidth(a) == b.graph->getWidth(b) && a.graph->getHeight(a) == b.graph->getHeight(b)); //must be same size
+        return a.graph->record(Lazy::Operation::Add, a.index, b.index, a.graph->getWidth(a), a.graph->getHeight(a));
+    } //a + b
+    inline Expression operator-(const Expression &a, const Expression &b) {
+        assert(a.graph == b.graph); //expressions from different graphs
+        assert(a.graph->getWidth(a) == b.graph->getWidth(b) && a.graph->getHeight(a) == b.graph->getHeight(b)); //must be same size
+        return a.graph->record(Lazy::Operation::Subtract, a.index, b.index, a.graph->getWidth(a), a.graph->getHeight(a));
+    } //a - b
+    inline Expression operator*(const Expression &a, const Expression &b) {
+        assert(a.graph == b.graph); //expressions from different graphs
+        assert(a.graph->getWidth(a) == b.graph->getHeight(b)); //number of columns in a must be equal to # of rows in b
+        return a.graph->record(Lazy::Operation::Multiply, a.index, b.index, b.graph->getWidth(b), a.graph->getHeight(a));
+    } //matrix product a * b
+    inline Expression operator*(const Expression &a, double scalar) {
+        return a.graph->record(Lazy::Operation::Scale, a.index, -1, a.graph->getWidth(a), a.graph->getHeight(a), scalar);
+    } //a * scalar
+    inline Expression operator*(double scalar, const Expression &a) { return a * scalar; } //scalar * a
+    inline Expression operator-(const Expression &a) { return a * -1.0; } //-a
+    inline Expression hadamard(const Expression &a, const Expression &b) {
+        assert(a.graph == b.graph); //expressions from different graphs
+        assert(a.graph->getWidth(a) == b.graph->getWidth(b) && a.graph->getHeight(a) == b.graph->getHeight(b)); //must be same size
+        return a.graph->record(Lazy::Operation::Hadamard, a.index, b.index, a.graph->getWidth(a), a.graph->getHeight(a));
+    } //component wise product
+    inline Expression addBias(const Expression &a, const Expression &bias) {
+        assert(a.graph == bias.graph); //expressions from different graphs
+        assert(bias.graph->getWidth(bias) == 1 && bias.graph->getHeight(bias) == a.graph->getHeight(a)); //one value per row
+        return a.graph->record(Lazy::Operation::AddBias, a.index, bias.index, a.graph->getWidth(a), a.graph->getHeight(a));
+    } //add a column to every column of a
+
+    //every elementwise function records the same way
+    #define TENSORMATH_LAZY_ELEMENTWISE(name, operation) \
+        inline Expression name(const Expression &a) { \
+            return a.graph->record(Lazy::Operation::operation, a.index, -1, a.graph->getWidth(a), a.graph->getHeight(a)); \
+        }
+
+    TENSORMATH_LAZY_ELEMENTWISE(exp, Exp) //e^x
+    TENSORMATH_LAZY_ELEMENTWISE(log, Log) //natural logarithm
+    TENSORMATH_LAZY_ELEMENTWISE(sqrt, Sqrt) //square root
+    TENSORMATH_LAZY_ELEMENTWISE(sin, Sin) //sine, radians
+    TENSORMATH_LAZY_ELEMENTWISE(cos, Cos) //cosine, radians
+    TENSORMATH_LAZY_ELEMENTWISE(tanh, Tanh) //hyperbolic tangent
+    TENSORMATH_LAZY_ELEMENTWISE(sigmoid, Sigmoid) //1 / (1 + e^-x)
+    TENSORMATH_LAZY_ELEMENTWISE(relu, Relu) //max(x, 0)
+
+    #undef TENSORMATH_LAZY_ELEMENTWISE
+
+}
+
+#endif //TENSORMATH_LAZY_HPP
@@ -5,74 +5,108 @@
 #ifndef TENSOR_MATRIX_HPP
 #define TENSOR_MATRIX_HPP
 
+#include <algorithm>
 #include "Vector.hpp"
+#include "View.hpp"
+#include "Strassen.hpp"
 
 namespace TensorMath {
+    inline void multiplyInto(const ConstMatrixView& a, const ConstMatrixView& b, MatrixView out) {
+        int cutoff = getStrassenCutoff();
+        if(cutoff > 0){
+            multiplyStrassen(a, b, out, cutoff);
+        }else{
+            multiply(a, b, out);
+        }
+    } //product used by Matrix operators, classic unless setStrassenCutoff() opted in
+
     //matrix library for doubles
+    //values are stored in one block, either one column after another(column major, the default) or one row after
+    //another(row major), so columns, rows and the whole matrix can be handed out as views without copying
+    //all operations work on any mix of layouts, and are fastest when the operands share one
     //Contains assertions for things like mismatched vector sizes(Make sure define NDEBUG for max performance)
     class Matrix {
     public:
         //CONSTRUCTORS
-            explicit Matrix(int w, int h) : m_width(w) , m_height(h){
+            explicit Matrix(int w, int h, Layout layout = Layout::ColumnMajor) : m_width(w) , m_height(h), m_layout(layout){
                 initialize();
             } //matrix of width and height, zero initialized
-            explicit Matrix(int w): m_width(w) , m_height(w) {
+            explicit Matrix(int w, Layout layout = Layout::ColumnMajor): m_width(w) , m_height(w), m_layout(layout) {
                 initialize();
             }   //square matrix
-            Matrix(const Vector&vec){
+            Matrix(const Vector&vec) : m_layout(Layout::ColumnMajor){
                 m_width = vec.getDim();
                 m_height = 1;//flat
                 initialize();
                 for (int x = 0; x < m_width; ++x) {
-                    setValue(x,0,vec[x]); //copy over
+                    atUnchecked(x,0) = vec.atUnchecked(x); //copy over
                 }
             } //create flat matrix from vector(for conversions)
-            Matrix(const Matrix &other) : Matrix(other.m_width, other.m_height){
-                for (int y = 0; y < m_height; ++y) {
-                    for (int x = 0; x < m_width; ++x) {
-                        setValue(x,y,other.getValue(x,y));
-                    }
-                }
+            Matrix(const Matrix &other) : Matrix(other.m_width, other.m_height, other.m_layout){
+                TENSORMATH_COUNT_COPY(getSize() * sizeof(double));
+                parallelCopy(other.m_data, m_data, getSize());
             }   //copy constructor
+            explicit Matrix(const ConstMatrixView &view, Layout layout = Layout::ColumnMajor) : Matrix(view.getWidth(), view.getHeight(), layout){
+                this->view() = view;
+            }   //copy the values of a view into a new matrix
             ~Matrix(){
-                for (int i = 0; i < m_width; ++i) {
-                    delete m_data[i]; //clean up vectors
-                }
                 delete[] m_data;
             }   //destructor for clean up
 
         //SETTERS AND GETTERS
             double getValue(int x, int y) const{
-                assert(x < m_width && y < m_height);//check if in bounds
-                return m_data[x]->getValue(y);
-            }//get a double value at coordinates
+                TENSORMATH_CHECK_INDEX(x, m_width);//check if in bounds
+                TENSORMATH_CHECK_INDEX(y, m_height);
+                return m_data[index(x,y)];
+            }//get a double value at coordinates, checked by the bounds policy(see Bounds.hpp)
             void setValue(int x, int y, double value) {
-                assert(x < m_width && y < m_height);//check if in bounds
-                (*(m_data[x]))[y] = value;
-            } //set a double value at coordinates
+                TENSORMATH_CHECK_INDEX(x, m_width);//check if in bounds
+                TENSORMATH_CHECK_INDEX(y, m_height);
+                m_data[index(x,y)] = value;
+            } //set a double value at coordinates, checked by the bounds policy
+            double at(int x, int y) const{
+                Bounds::check(x, m_width);
+                Bounds::check(y, m_height);
+                return m_data[index(x,y)];
+            } //get a value, throws std::out_of_range for bad coordinates
+            double &at(int x, int y){
+                Bounds::check(x, m_width);
+                Bounds::check(y, m_height);
+                return m_data[index(x,y)];
+            } //get or set a value, throws std::out_of_range for bad coordinates
+            double atUnchecked(int x, int y) const{ return m_data[index(x,y)]; } //get a value without any check, for hot loops
+            double &atUnchecked(int x, int y){ return m_data[index(x,y)]; } //get or set a value without any check, for hot loops
             void setZero(){
-                for (int y = 0; y < m_height; ++y) {
-                    for (int x = 0; x < m_width; ++x) {
-                        setValue(x,y,0);
-                    }
-                }
+                parallelFill(m_data, getSize(), 0);
             }  //create a null matrix, all zero values
             void setIdentity(){
                 for (int y = 0; y < m_height; ++y) {
                     for (int x = 0; x < m_width; ++x) {
-                        if(x == y){
-                            setValue(x,y,1);
-                        }else{
-                            setValue(x,y,0);
-                        }
+                        atUnchecked(x,y) = x == y ? 1 : 0;
                     }
                 }
             }   //create an identity matrix, diagonal 1 values with others being zero
+            void randomFill(double min, double max, uint64_t seed) {
+                uniformFill(data(), getSize(), min, max, seed);
+            } //fill the matrix with uniform values in [min, max), same seed gives the same values
+            void randomFill(double min, double max) {
+                randomFill(min, max, nextRandomSeed());
+            } //fill the matrix with uniform values in [min, max), seeded from the global sequence(see setRandomSeed())
+            void randomNormalFill(double mean, double deviation, uint64_t seed) {
+                normalFill(data(), getSize(), mean, deviation, seed);
+            } //fill the matrix with normally distributed values, same seed gives the same values
+            void randomNormalFill(double mean = 0, double deviation = 1) {
+                randomNormalFill(mean, deviation, nextRandomSeed());
+            } //fill the matrix with normally distributed values, seeded from the global sequence
             void fillArray(std::vector<double> data){
+                if(m_layout == Layout::RowMajor){ //already in storage order
+                    std::copy(data.begin(), data.begin() + std::min(data.size(), getSize()), m_data);
+                    return;
+                }
                 int counter = 0;
                 for (int y = 0; y < m_height; ++y) { //go one row at a time
                     for (int x = 0; x < m_width; ++x) { //fill in values left to right
-                        setValue(x,y,data[counter]);
+                        atUnchecked(x,y) = data[counter];
                         counter++;
                         if(counter == data.size()){
                             return; //fill as much as possible, then stop
@@ -81,85 +115,82 @@ namespace TensorMath {
                 }
             }      //fill the matrix from an array in standard left right then next row fashion
             std::vector<double> getArray(){
+                TENSORMATH_COUNT_COPY(getSize() * sizeof(double));
+                if(m_layout == Layout::RowMajor){ //already in storage order
+                    return std::vector<double>(m_data, m_data + getSize());
+                }
                 std::vector<double> output;
                 for (int y = 0; y < m_height; ++y) {
                     for (int x = 0; x < m_width; ++x) {
-                        output.push_back(getValue(x,y));
+                        output.push_back(atUnchecked(x,y));
                     }
                 }
                 return output;
             }   //get array, inverse of fill array. Useful for serialization.
             Vector getColumn(int x)const{
-                assert(x < m_width); //check bounds
-                return *m_data[x];
-            }    //get a vector from matrix
+                return column(x).toVector();
+            }    //get a copy of a column
             Vector getRow(int y)const{
-                assert(y < m_height); //check bounds
-                Vector out (m_width); //new vector since data is stored in other ordination
-                for (int x = 0; x < m_width; ++x) {
-                    out[x] = getValue(x, y); //fill vector
-                }
-                return out;
-            }   //get a vector of the row rather than column
+                return row(y).toVector();
+            }   //get a copy of a row
+            VectorView column(int x){ return view().column(x); } //view a column, no copy(strided in row major)
+            ConstVectorView column(int x) const { return view().column(x); } //read only view of a column
+            VectorView row(int y){ return view().row(y); } //view a row, no copy(strided in column major)
+            ConstVectorView row(int y) const { return view().row(y); } //read only view of a row
+            MatrixView view(){ return MatrixView::ofLayout(m_data, m_width, m_height, m_layout); } //view the whole matrix
+            ConstMatrixView view() const { return ConstMatrixView::ofLayout(m_data, m_width, m_height, m_layout); } //read only view of the whole matrix
+            operator MatrixView(){ return view(); } //pass a matrix where a view is wanted
+            operator ConstMatrixView() const { return view(); } //pass a matrix where a read only view is wanted
+            double* data(){ return m_data; } //get the values, in storage order
+            const double* data() const { return m_data; } //get the values, in storage order
+            double* begin(){ return m_data; } //first value, for range for and standard algorithms(storage order)
+            double* end(){ return m_data + getSize(); } //past the last value
+            const double* begin() const { return m_data; } //first value(read only)
+            const double* end() const { return m_data + getSize(); } //past the last value(read only)
+            size_t size() const { return getSize(); } //number of values
+            LineRange<double> columns(){ return view().columns(); } //every column as a view, for range for
+            LineRange<const double> columns() const { return view().columns(); } //every column as a read only view
+            LineRange<double> rows(){ return view().rows(); } //every row as a view, for range for
+            LineRange<const double> rows() const { return view().rows(); } //every row as a read only view
             int getHeight() const {return m_height;} //get matrix height(# of rows)
             int getWidth() const {return m_width;} //get matrix width
+            Layout getLayout() const {return m_layout;} //get the storage order
             Matrix &operator=(const Matrix &other) { //assign from other Matrix
                 if (this != &other) {//handle self assignment
-                    assert(other.m_width == m_width); //can not assign different dimensional matrix
-                    for (int i = 0; i < m_width; ++i) {
-                        *m_data[i] = other[i];
+                    assert(other.m_width == m_width && other.m_height == m_height); //can not assign different dimensional matrix
+                    if(other.m_layout == m_layout){
+                        parallelCopy(other.m_data, m_data, getSize());
+                    }else{
+                        view() = other.view(); //reorder
                     }
                 }
                 return *this;
             }
 
        //COMPARISON
-            bool equals(const Matrix& other, double epsilon  = std::numeric_limits<double>::epsilon()*10) const {
-                if(m_width != other.getWidth() || m_height != other.getHeight()){
-                    return false; //different dimensions
-                }
-                for (int x = 0; x < m_width; ++x) {
-                    if(!other[x].equals(getColumn(x), epsilon)){ //compare vectors
-                        return false;
-                    };
-                }
-                return true;
+            bool equals(const ConstMatrixView& other, double epsilon  = std::numeric_limits<double>::epsilon()*10) const {
+                return view().equals(other, epsilon);
             } //compare two matrices based on an epsilon for floating point values
 
         //OPERATORS
-            //allows matrix[x][y] to work, returns a vector
-            Vector operator[](int x) const {  assert(x < m_width); //check if in bounds
-                return *m_data[x]; } //get vector using brackets
-            Vector &operator[](int x) {  assert(x < m_width); //check if in bounds
-                return *m_data[x]; } //modify vector with brackets
-            Matrix operator * (const Matrix& other) const {
-                assert(m_width == other.m_height); //number of columns in a must be equal to # of rows in b
-                Matrix out(other.getWidth(),m_height); //create new matrix to output
-                for (int x = 0; x < out.m_width; ++x) {
-                    for (int y = 0; y < out.m_height; ++y) {
-                        Vector a = getRow(y);
-                        Vector b = other[x];
-                        out[x][y] = a.dotProduct(b); //set new matrix value to dot product of row and column
-                    }
-                }
+            //allows matrix[x][y] to work, the column is a view so nothing is copied
+            ConstVectorView operator[](int x) const { return column(x); } //get column using brackets
+            VectorView operator[](int x) { return column(x); } //modify column with brackets
+            Matrix operator * (const ConstMatrixView& other) const {
+                Matrix out(other.getWidth(),m_height,m_layout); //create new matrix to output
+                multiplyInto(view(), other, out.view());
                 return out;
-            }   //multiply two matrices todo optimize this https://coffeebeforearch.github.io/2020/06/23/mmul.html#:~:text=Matrix%20multiplication%20is%20an%20incredibly,multi%2Dcore%20CPU%20or%20GPU.
-            Matrix operator + (const Matrix& other) const {
-                assert(m_width == other.m_width && other.m_height == m_height); //must be same size
-                Matrix out(m_width,m_height); //output matrix
-                for (int x = 0; x < out.m_width; ++x) {
-                    out[x] = getColumn(x) + other[x] ; //add the vectors
-                }
+            }   //multiply by a matrix or view, using the fastest gemm kernel the cpu supports(or Strassen-Winograd if enabled)
+            Matrix operator + (const ConstMatrixView& other) const {
+                Matrix out(m_width,m_height,m_layout); //output matrix
+                add(view(), other, out.view());
                 return out;
-            }    //add two matrices
-            Matrix operator - (const Matrix& other) const {
-                assert(m_width == other.m_width && m_height == other.m_height); //must be same size
-                Matrix out(m_width,m_height); //output matrix
-                for (int x = 0; x < out.m_width; ++x) {
-                    out[x] =  getColumn(x) - other[x]; //subtract the vectors
-                }
+            }    //add a matrix or view
+            Matrix operator - (const ConstMatrixView& other) const {
+                Matrix out(m_width,m_height,m_layout); //output matrix
+                subtract(view(), other, out.view());
                 return out;
-            }   //subtract two matrices
+            }   //subtract a matrix or view
             bool operator == (const Matrix& other) const {
                 return equals(other);
             } //equality operator
@@ -173,21 +204,31 @@ namespace TensorMath {
 
 
        Matrix resized(int w, int h) const{
-            Matrix new_matrix(w,h); //create new matrix of size
+            Matrix new_matrix(w,h,m_layout); //create new matrix of size
            for (int x = 0; x < std::min(m_width, w); ++x) { //use the smallest size
                for (int y = 0; y < std::min(m_height, h); ++y) {
-                   new_matrix[x][y] = getValue(x,y); //copy over data
+                   new_matrix.atUnchecked(x,y) = atUnchecked(x,y); //copy over data
                }
            }
            return new_matrix;
         } //get a smaller or bigger version of the matrix. New values are set to 0.
+       Matrix transposed() const{
+            Matrix out(m_height, m_width, m_layout == Layout::RowMajor ? Layout::ColumnMajor : Layout::RowMajor);
+            std::copy(m_data, m_data + getSize(), out.m_data); //column major data is the row major data of the transpose
+            return out;
+        } //get the transpose. The values are copied in order and the layout is flipped, so nothing is shuffled.
+       Matrix toLayout(Layout layout) const{
+            return Matrix(view(), layout);
+        } //get a copy stored in another order
        //PRINTING
             std::string toString() const {
                 std::string out = "";
+                out.reserve(getSize() * 12 + (size_t) m_height * 4);
                 for (int y = 0; y < m_height; ++y) {
                     out +=  "[ ";
                     for (int x = 0; x < m_width; ++x) {
-                        out += std::to_string(getValue(x,y)) + " ";
+                        Text::appendFixed(out, atUnchecked(x,y));
+                        out += ' ';
                     }
                     out += "]\n";
                 }
@@ -198,17 +239,41 @@ namespace TensorMath {
     private:
         int m_width;   //dimensions
         int m_height;
-        Vector **m_data;  //actual data(contained in multiple vector pointers) each column is a vector(top down)
+        Layout m_layout; //storage order
+        double *m_data;  //actual data, in storage order
 
         void initialize(){
-            m_data = new Vector*[m_width];
-            for (int i = 0; i < m_width; ++i) {
-                m_data[i] = new Vector(m_height); //create vectors(columns)
-                //vectors are 0 initialized by default
-            }
-        }  //initialize the matrix with vectors
+            m_data = new double[getSize()];
+            TENSORMATH_COUNT_ALLOCATION(getSize() * sizeof(double));
+            parallelFill(m_data, getSize(), 0); //zero initialized, first touch from the threads that will use it
+        }  //allocate the values
+        size_t getSize() const { return (size_t)m_width * m_height; } //number of values
+        size_t index(int x, int y) const {
+            return m_layout == Layout::RowMajor ? (size_t)y * m_width + x : (size_t)x * m_height + y;
+        } //position of a value in storage order
 
     };
 
+    //operations with a view on the left, a matrix on the left uses the members
+    //the result uses the layout of the left side, like the members do
+    inline Layout resultLayout(const ConstMatrixView& a) {
+        return a.isRowMajor() && !a.isColumnMajor() ? Layout::RowMajor : Layout::ColumnMajor;
+    } //pick the output layout from the left view(column major for strided views and single columns)
+    inline Matrix operator * (const ConstMatrixView& a, const ConstMatrixView& b) {
+        Matrix out(b.getWidth(), a.getHeight(), resultLayout(a));
+        multiplyInto(a, b, out.view());
+        return out;
+    } //multiply two views into a new matrix
+    inline Matrix operator + (const ConstMatrixView& a, const ConstMatrixView& b) {
+        Matrix out(a.getWidth(), a.getHeight(), resultLayout(a));
+        add(a, b, out.view());
+        return out;
+    } //add two views into a new matrix
+    inline Matrix operator - (const ConstMatrixView& a, const ConstMatrixView& b) {
+        Matrix out(a.getWidth(), a.getHeight(), resultLayout(a));
+        subtract(a, b, out.view());
+        return out;
+    } //subtract two views into a new matrix
+
 }
-#endif TENSOR_MATRIX_HPP
+#endif //TENSOR_MATRIX_HPP
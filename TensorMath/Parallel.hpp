@@ -0,0 +1,211 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_PARALLEL_HPP
+#define TENSORMATH_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//shared thread pool for large elementwise operations and reductions
+//work is split statically: part t of every operation always runs on thread t, so when memory is first written by
+//parallelFill(first touch) each page lands on the NUMA node of the thread that will keep working on it
+//operations smaller than the parallel threshold run on the calling thread with no synchronization
+//set the environment variable TENSORMATH_THREADS to change the pool size for a whole run(1 turns threading off)
+
+namespace TensorMath {
+
+    //fixed set of worker threads that run one job at a time, the calling thread does part 0 itself
+    class ThreadPool {
+    public:
+        //CONSTRUCTORS
+            explicit ThreadPool(int threads) {
+                assert(threads > 0); //need at least the calling thread
+                for (int i = 1; i < threads; ++i) {
+                    m_workers.emplace_back([this, i] { work(i); });
+                }
+            } //pool with threads threads in total, including the thread that calls run()
+            ThreadPool(const ThreadPool &other) = delete;
+            ThreadPool &operator=(const ThreadPool &other) = delete;
+            ~ThreadPool() {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_stop = true;
+                }
+                m_start.notify_all();
+                for (std::thread &worker: m_workers) { worker.join(); }
+            } //stop and join the workers
+
+        //SETTERS AND GETTERS
+            int getThreadCount() const { return (int) m_workers.size() + 1; } //get number of threads, including the caller
+
+        //RUNNING
+            template<class Function>
+            void run(Function function) {
+                //nested calls, and calls while another thread is using the pool, run serially instead of waiting
+                std::unique_lock<std::mutex> run_lock(m_run_mutex, std::try_to_lock);
+                if (m_workers.empty() || insidePool() || !run_lock.owns_lock()) {
+                    for (int t = 0; t < getThreadCount(); ++t) { function(t); }
+                    return;
+                }
+                Job job{[](const void *part, int t) { (*(const Function *) part)(t); }, &function}; //no allocation
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_job = &job;
+                    m_remaining = (int) m_workers.size();
+                    m_generation++;
+                }
+                m_start.notify_all();
+                insidePool() = true;
+                std::exception_ptr error;
+                try {
+                    function(0);
+                } catch (...) {
+                    error = std::current_exception(); //rethrown once the workers are done with job
+                }
+                insidePool() = false;
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_done.wait(lock, [this] { return m_remaining == 0; });
+                m_job = nullptr;
+                if (!error) { error = m_error; }
+                m_error = nullptr;
+                lock.unlock();
+                if (error) { std::rethrow_exception(error); }
+            } //call function(int t) once for every thread t, t = 0 on the calling thread. Returns when all are done.
+              //if any part throws, the other parts still finish, then the first exception is rethrown here.
+
+            static ThreadPool &global() {
+                static ThreadPool pool(getStartupThreadCount());
+                return pool;
+            } //pool shared by all TensorMath operations
+
+    private:
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex; //guards everything below
+        std::mutex m_run_mutex; //one job at a time
+        std::condition_variable m_start;
+        std::condition_variable m_done;
+        //type erased job, points to the caller's function while run() waits
+        struct Job {
+            void (*call)(const void *function, int t);
+            const void *function;
+        };
+        const Job *m_job = nullptr;
+        unsigned long long m_generation = 0; //increases with every job
+        int m_remaining = 0; //workers still running the current job
+        bool m_stop = false;
+        std::exception_ptr m_error; //first exception a worker threw in the current job
+
+        void work(int index) {
+            insidePool() = true;
+            unsigned long long seen = 0;
+            while (true) {
+                const Job *job;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_start.wait(lock, [&] { return m_stop || m_generation != seen; });
+                    if (m_stop) { return; }
+                    seen = m_generation;
+                    job = m_job;
+                }
+                std::exception_ptr error;
+                try {
+                    job->call(job->function, index);
+                } catch (...) {
+                    error = std::current_exception(); //handed to the caller, a worker must not terminate the program
+                }
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (error && !m_error) { m_error = error; }
+                    m_remaining--;
+                }
+                m_done.notify_one();
+            }
+        } //worker loop, runs part index of every job
+
+        static bool &insidePool() {
+            thread_local bool inside = false;
+            return inside;
+        } //true on pool threads(and the caller while it runs its part)
+
+        static int getStartupThreadCount() {
+            const char *forced = std::getenv("TENSORMATH_THREADS");
+            if (forced != nullptr && std::atoi(forced) > 0) { return std::atoi(forced); }
+            return std::max(1, (int) std::thread::hardware_concurrency());
+        } //pool size, from TENSORMATH_THREADS or the number of hardware threads
+    };
+
+    namespace Parallel {
+        constexpr size_t REDUCTION_CHUNK = 16384; //values per partial sum, fixed so results never depend on thread count
+
+        inline std::atomic<size_t> &threshold() {
+            static std::atomic<size_t> value{1 << 17};
+            return value;
+        } //smallest operation that is split across threads
+    }
+
+    inline size_t getParallelThreshold() {
+        return Parallel::threshold().load(std::memory_order_relaxed);
+    } //get the smallest number of values an operation needs to be split across threads
+
+    inline void setParallelThreshold(size_t count) {
+        Parallel::threshold().store(count, std::memory_order_relaxed);
+    } //set the smallest number of values an operation needs to be split across threads
+
+    template<class Function>
+    inline void parallelFor(size_t count, Function function, size_t cost = 1) {
+        if (count * cost < getParallelThreshold()) {
+            if (count > 0) { function((size_t) 0, count); }
+            return;
+        }
+        ThreadPool &pool = ThreadPool::global();
+        size_t parts = (size_t) pool.getThreadCount();
+        pool.run([&](int t) {
+            size_t begin = count * t / parts;
+            size_t end = count * (t + 1) / parts;
+            if (begin < end) { function(begin, end); }
+        });
+    } //call function(begin, end) on contiguous parts of [0, count), in parallel when count * cost reaches the threshold
+
+    template<class Function>
+    inline double parallelReduce(size_t count, Function function) {
+        size_t chunks = (count + Parallel::REDUCTION_CHUNK - 1) / Parallel::REDUCTION_CHUNK;
+        if (chunks <= 1) { return count > 0 ? function((size_t) 0, count) : 0.0; }
+        std::vector<double> partials(chunks);
+        parallelFor(count, [&](size_t begin, size_t end) {
+            //every part handles the chunks that start inside it, so chunk boundaries do not move with thread count
+            size_t first = (begin + Parallel::REDUCTION_CHUNK - 1) / Parallel::REDUCTION_CHUNK;
+            size_t last = (end + Parallel::REDUCTION_CHUNK - 1) / Parallel::REDUCTION_CHUNK;
+            for (size_t chunk = first; chunk < last; ++chunk) {
+                size_t chunk_begin = chunk * Parallel::REDUCTION_CHUNK;
+                partials[chunk] = function(chunk_begin, std::min(count, chunk_begin + Parallel::REDUCTION_CHUNK));
+            }
+        });
+        double sum = 0;
+        for (double partial: partials) { sum += partial; } //always the same order
+        return sum;
+    } //sum of function(begin, end) over fixed size chunks of [0, count). Same result on any number of threads.
+
+    inline void parallelFill(double *data, size_t count, double value) {
+        parallelFor(count, [=](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) { data[i] = value; }
+        });
+    } //fill with a value. Use on fresh memory so each thread touches its own pages first.
+
+    inline void parallelCopy(const double *from, double *to, size_t count) {
+        parallelFor(count, [=](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) { to[i] = from[i]; }
+        });
+    } //copy values, split the same way as fills so pages stay with their thread
+
+}
+
+#endif //TENSORMATH_PARALLEL_HPP
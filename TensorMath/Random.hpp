@@ -0,0 +1,156 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_RANDOM_HPP
+#define TENSORMATH_RANDOM_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include "Dispatch.hpp"
+#include "Parallel.hpp"
+
+//random numbers: xoshiro256** generators seeded with splitmix64
+//fills are split into fixed size chunks, and every chunk gets its own generators seeded from (seed, chunk index),
+//so a seeded fill gives the same values on any number of threads, and large fills run on the whole thread pool
+//uniform values are made by the random kernel(see Kernels.hpp), normal values with Box-Muller on top of the vectorized
+//log, sqrt, sin and cos kernels
+//fills without a seed take the next seed of a global sequence(see setRandomSeed()), so there is no shared generator
+
+namespace TensorMath {
+
+    //xoshiro256** generator, for single values. Not thread safe, use one per thread(see local()).
+    class Random {
+    public:
+        //CONSTRUCTORS
+            explicit Random(uint64_t seed) {
+                for (uint64_t &word: m_state) { word = splitMix(seed); }
+            } //generator with a seed, same seed gives the same values
+
+        //VALUES
+            uint64_t next() {
+                uint64_t result = rotateLeft(m_state[1] * 5, 7) * 9;
+                uint64_t t = m_state[1] << 17;
+                m_state[2] ^= m_state[0];
+                m_state[3] ^= m_state[1];
+                m_state[1] ^= m_state[2];
+                m_state[0] ^= m_state[3];
+                m_state[2] ^= t;
+                m_state[3] = rotateLeft(m_state[3], 45);
+                return result;
+            } //next 64 random bits
+            double uniform() {
+                return (double) (next() >> 11) * 0x1.0p-53;
+            } //uniform value in [0, 1)
+            double uniform(double min, double max) {
+                return min + uniform() * (max - min);
+            } //uniform value in [min, max)
+            double normal(double mean = 0, double deviation = 1) {
+                double radius = std::sqrt(-2.0 * std::log(1.0 - uniform())); //Box-Muller, 1 - u is never 0
+                return mean + deviation * radius * std::cos(6.283185307179586 * uniform());
+            } //normally distributed value
+
+            static uint64_t splitMix(uint64_t &state) {
+                uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                return z ^ (z >> 31);
+            } //splitmix64, turns a counter into well mixed seeds
+            static Random &local();
+
+    private:
+        uint64_t m_state[4];
+        static uint64_t rotateLeft(uint64_t x, int bits) { return (x << bits) | (x >> (64 - bits)); }
+    };
+
+    namespace Sampling {
+        constexpr size_t CHUNK = 4096; //values per chunk, each chunk has its own generators
+
+        inline std::atomic<uint64_t> &seed() {
+            static std::atomic<uint64_t> value{0x5EED5EED5EED5EEDULL};
+            return value;
+        } //start of the global seed sequence
+        inline std::atomic<uint64_t> &counter() {
+            static std::atomic<uint64_t> value{0};
+            return value;
+        } //seeds taken from the global sequence so far
+
+        inline void seedGenerators(uint64_t seed, uint64_t chunk, uint64_t *state) {
+            uint64_t mix = seed ^ (chunk * 0xD1B54A32D192ED03ULL);
+            Random::splitMix(mix); //separate nearby chunks
+            for (int i = 0; i < 4 * Kernels::RANDOM_LANES; ++i) { state[i] = Random::splitMix(mix); }
+        } //generators of one chunk
+
+        template<class Function>
+        inline void forChunks(size_t count, uint64_t seed, size_t cost, Function function) {
+            size_t chunks = (count + CHUNK - 1) / CHUNK;
+            parallelFor(chunks, [&](size_t begin, size_t end) {
+                uint64_t state[4 * Kernels::RANDOM_LANES];
+                for (size_t chunk = begin; chunk < end; ++chunk) {
+                    seedGenerators(seed, chunk, state);
+                    size_t start = chunk * CHUNK;
+                    function(state, start, (int) std::min(CHUNK, count - start));
+                }
+            }, CHUNK * cost);
+        } //call function(state, start, size) for every chunk, with that chunk's generators
+    }
+
+    inline uint64_t getRandomSeed() {
+        return Sampling::seed().load(std::memory_order_relaxed);
+    } //get the start of the global seed sequence
+
+    inline void setRandomSeed(uint64_t seed) {
+        Sampling::seed().store(seed, std::memory_order_relaxed);
+        Sampling::counter().store(0, std::memory_order_relaxed);
+    } //restart the global seed sequence, so unseeded fills repeat(when made in the same order)
+
+    inline uint64_t nextRandomSeed() {
+        uint64_t state = getRandomSeed() + Sampling::counter().fetch_add(1, std::memory_order_relaxed);
+        return Random::splitMix(state);
+    } //take the next seed of the global sequence, thread safe
+
+    inline Random &Random::local() {
+        thread_local Random generator(nextRandomSeed());
+        return generator;
+    } //generator of the calling thread, seeded from the global sequence
+
+    inline void uniformFill(double *data, size_t count, double min, double max, uint64_t seed) {
+        const KernelTable &table = kernels();
+        Sampling::forChunks(count, seed, 1, [&](uint64_t *state, size_t start, int size) {
+            double *values = data + start;
+            table.random(state, values, size);
+            for (int i = 0; i < size; ++i) { values[i] = min + values[i] * (max - min); }
+        });
+    } //fill with uniform values in [min, max), same seed gives the same values on any number of threads
+
+    inline void normalFill(double *data, size_t count, double mean, double deviation, uint64_t seed) {
+        const KernelTable &table = kernels();
+        Sampling::forChunks(count, seed, 8, [&](uint64_t *state, size_t start, int size) {
+            constexpr int HALF = (int) Sampling::CHUNK / 2;
+            double radius[HALF], angle[HALF], trigonometry[HALF];
+            double *values = data + start;
+            for (int first = 0; first < size; first += 2 * HALF) {
+                int pairs = std::min(HALF, (size - first + 1) / 2);
+                table.random(state, radius, pairs);
+                table.random(state, angle, pairs);
+                for (int i = 0; i < pairs; ++i) { radius[i] = 1.0 - radius[i]; } //(0, 1], log is finite
+                table.log(radius, radius, pairs);
+                for (int i = 0; i < pairs; ++i) { radius[i] = -2.0 * radius[i]; }
+                table.sqrt(radius, radius, pairs);
+                for (int i = 0; i < pairs; ++i) { angle[i] *= 6.283185307179586; }
+                table.cos(angle, trigonometry, pairs);
+                for (int i = 0; i < pairs; ++i) { values[first + i] = mean + deviation * radius[i] * trigonometry[i]; }
+                table.sin(angle, trigonometry, pairs);
+                int second = std::min(pairs, size - first - pairs); //an odd size drops the last sine
+                for (int i = 0; i < second; ++i) {
+                    values[first + pairs + i] = mean + deviation * radius[i] * trigonometry[i];
+                }
+            }
+        });
+    } //fill with normally distributed values, same seed gives the same values on any number of threads
+
+}
+
+#endif //TENSORMATH_RANDOM_HPP
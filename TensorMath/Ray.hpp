@@ -0,0 +1,131 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_RAY_HPP
+#define TENSORMATH_RAY_HPP
+
+#include <cmath>
+#include <limits>
+#include "FixedVector.hpp"
+
+namespace TensorMath {
+
+    //3d ray with a precomputed inverse direction(for fast slab tests)
+    class Ray {
+    public:
+        //CONSTRUCTORS
+            Ray(const Vector3 &origin, const Vector3 &direction) : m_origin(origin), m_direction(direction),
+                                                                   m_inverse_direction(direction.inverse()) {
+            } //create a ray from an origin and a direction(does not need to be normalized)
+
+        //SETTERS AND GETTERS
+            const Vector3 &getOrigin() const { return m_origin; } //get the start of the ray
+            const Vector3 &getDirection() const { return m_direction; } //get the direction of the ray
+            const Vector3 &getInverseDirection() const { return m_inverse_direction; } //get 1.0/direction
+            Vector3 getPoint(double t) const { return m_origin + m_direction * t; } //get the point at distance t along the ray
+
+        //INTERSECTION
+            bool intersectTriangle(const Vector3 &v0, const Vector3 &v1, const Vector3 &v2, double &t, double &u,
+                                   double &v, double t_min = 0,
+                                   double t_max = std::numeric_limits<double>::infinity()) const {
+                Vector3 edge_1 = v1 - v0;
+                Vector3 edge_2 = v2 - v0;
+                Vector3 p = m_direction.crossProduct(edge_2);
+                double determinant = edge_1.dotProduct(p);
+                if (std::fabs(determinant) < std::numeric_limits<double>::epsilon()) { return false; } //parallel to triangle
+                double inverse_determinant = 1.0 / determinant;
+                Vector3 s = m_origin - v0;
+                u = s.dotProduct(p) * inverse_determinant;
+                if (u < 0.0 || u > 1.0) { return false; }
+                Vector3 q = s.crossProduct(edge_1);
+                v = m_direction.dotProduct(q) * inverse_determinant;
+                if (v < 0.0 || u + v > 1.0) { return false; }
+                t = edge_2.dotProduct(q) * inverse_determinant;
+                return t > t_min && t < t_max;
+            } //Moller-Trumbore ray triangle intersection. Sets distance t and barycentric coordinates u and v on hit.
+
+    private:
+        Vector3 m_origin;
+        Vector3 m_direction;
+        Vector3 m_inverse_direction;
+    };
+
+    //a group of rays stored as structure of arrays(one array per component), so a single kernel call can test multiple rays at once
+    //the kernels are written branchless over the lanes, so the compiler can turn them into SIMD instructions
+    template<int size>
+    class RayPacket {
+    public:
+        //CONSTRUCTORS
+            RayPacket() {
+                for (int i = 0; i < size; ++i) {
+                    setRay(i, Ray(Vector3(0, 0, 0), Vector3(0, 0, 1)));
+                    t_max[i] = std::numeric_limits<double>::infinity();
+                }
+            } //create a packet of rays at the origin pointing along z
+            RayPacket(const Ray *rays) {
+                for (int i = 0; i < size; ++i) {
+                    setRay(i, rays[i]);
+                    t_max[i] = std::numeric_limits<double>::infinity();
+                }
+            } //create a packet from an array of size rays
+
+        //SETTERS AND GETTERS
+            void setRay(int i, const Ray &ray) {
+                assert(i >= 0 && i < size); //lane out of range
+                for (int axis = 0; axis < 3; ++axis) {
+                    origin[axis][i] = ray.getOrigin()[axis];
+                    direction[axis][i] = ray.getDirection()[axis];
+                    inverse_direction[axis][i] = ray.getInverseDirection()[axis];
+                }
+            } //set a single lane from a ray
+            Ray getRay(int i) const {
+                assert(i >= 0 && i < size); //lane out of range
+                return Ray(Vector3(origin[0][i], origin[1][i], origin[2][i]),
+                           Vector3(direction[0][i], direction[1][i], direction[2][i]));
+            } //get a single lane as a ray
+            static constexpr int getSize() { return size; } //get number of rays in the packet
+
+        //INTERSECTION
+            int intersectTriangle(const Vector3 &v0, const Vector3 &v1, const Vector3 &v2, double t_min = 0) {
+                const double edge_1[3] = {v1[0] - v0[0], v1[1] - v0[1], v1[2] - v0[2]};
+                const double edge_2[3] = {v2[0] - v0[0], v2[1] - v0[1], v2[2] - v0[2]};
+                int mask = 0;
+                for (int i = 0; i < size; ++i) {
+                    //p = direction x edge_2
+                    double p_x = direction[1][i] * edge_2[2] - direction[2][i] * edge_2[1];
+                    double p_y = direction[2][i] * edge_2[0] - direction[0][i] * edge_2[2];
+                    double p_z = direction[0][i] * edge_2[1] - direction[1][i] * edge_2[0];
+                    double determinant = edge_1[0] * p_x + edge_1[1] * p_y + edge_1[2] * p_z;
+                    double inverse_determinant = 1.0 / determinant;
+                    double s_x = origin[0][i] - v0[0];
+                    double s_y = origin[1][i] - v0[1];
+                    double s_z = origin[2][i] - v0[2];
+                    double u = (s_x * p_x + s_y * p_y + s_z * p_z) * inverse_determinant;
+                    //q = s x edge_1
+                    double q_x = s_y * edge_1[2] - s_z * edge_1[1];
+                    double q_y = s_z * edge_1[0] - s_x * edge_1[2];
+                    double q_z = s_x * edge_1[1] - s_y * edge_1[0];
+                    double v = (direction[0][i] * q_x + direction[1][i] * q_y + direction[2][i] * q_z) * inverse_determinant;
+                    double t = (edge_2[0] * q_x + edge_2[1] * q_y + edge_2[2] * q_z) * inverse_determinant;
+                    bool hit = (std::fabs(determinant) >= std::numeric_limits<double>::epsilon()) & (u >= 0.0) &
+                               (v >= 0.0) & (u + v <= 1.0) & (t > t_min) & (t < t_max[i]);
+                    t_max[i] = hit ? t : t_max[i]; //keep the closest hit
+                    mask |= (int) hit << i;
+                }
+                return mask;
+            } //Moller-Trumbore for every lane. Shortens t_max of lanes that hit. Returns a bit mask of the lanes that hit.
+
+        double origin[3][size]; //origin components, one array per axis
+        double direction[3][size]; //direction components, one array per axis
+        double inverse_direction[3][size]; //1.0/direction components, one array per axis
+        double t_max[size]; //current closest hit per lane, infinity if nothing was hit yet
+    };
+
+    //helper names(common SIMD widths)
+    typedef RayPacket<4> RayPacket4; //4 rays, one AVX2 register per component
+    typedef RayPacket<8> RayPacket8; //8 rays, one AVX-512 register per component
+
+}
+
+#endif //TENSORMATH_RAY_HPP
@@ -0,0 +1,123 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_SERIALIZATION_HPP
+#define TENSORMATH_SERIALIZATION_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+#include "FixedMatrix.hpp"
+
+//bulk binary serialization of arrays of doubles, FixedVectors and FixedMatrices(for files, sockets and shared memory)
+//fixed types are trivially copyable packed doubles(matrices column after column), so an array of them is one block of
+//doubles: in the native byte order it is a single memcpy, otherwise every double is byte swapped on the way
+//large arrays are copied on the thread pool
+
+namespace TensorMath {
+
+    //byte order of serialized data
+    enum class Endian {
+        Little, //x86, ARM, most network formats that are not "network order"
+        Big, //network order
+        #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            Native = Big //byte order of this machine, no conversion
+        #else
+            Native = Little //byte order of this machine, no conversion
+        #endif
+    };
+
+    namespace Serialization {
+        constexpr size_t COST = 1; //a swapped copy costs about as much as an addition per double, for parallelFor
+
+        template<class T>
+        struct Doubles : std::false_type {}; //types that are only packed doubles
+        template<>
+        struct Doubles<double> : std::true_type {};
+        template<int dimensions>
+        struct Doubles<FixedVector<dimensions>> : std::true_type {};
+        template<int width, int height>
+        struct Doubles<FixedMatrix<width, height>> : std::true_type {};
+
+        template<class T>
+        constexpr size_t doublesOf() {
+            static_assert(Doubles<T>::value, "Only doubles, FixedVectors and FixedMatrices can be serialized");
+            static_assert(std::is_trivially_copyable<T>::value && sizeof(T) % sizeof(double) == 0, "Must be packed doubles");
+            return sizeof(T) / sizeof(double);
+        } //doubles in one item
+
+        inline uint64_t swapBytes(uint64_t value) {
+            #if defined(__GNUC__) || defined(__clang__)
+                return __builtin_bswap64(value);
+            #else
+                value = ((value & 0x00FF00FF00FF00FFULL) << 8) | ((value >> 8) & 0x00FF00FF00FF00FFULL);
+                value = ((value & 0x0000FFFF0000FFFFULL) << 16) | ((value >> 16) & 0x0000FFFF0000FFFFULL);
+                return (value << 32) | (value >> 32);
+            #endif
+        } //reverse the bytes of a 64 bit value
+
+        inline void copy(const void *in, void *out, size_t doubles, bool swap) {
+            parallelFor(doubles, [&](size_t begin, size_t end) {
+                const unsigned char *from = (const unsigned char *) in + begin * sizeof(double);
+                unsigned char *to = (unsigned char *) out + begin * sizeof(double);
+                if (!swap) {
+                    std::memcpy(to, from, (end - begin) * sizeof(double));
+                    return;
+                }
+                for (size_t i = 0; i < end - begin; ++i) {
+                    uint64_t bits;
+                    std::memcpy(&bits, from + i * sizeof(double), sizeof(bits));
+                    bits = swapBytes(bits);
+                    std::memcpy(to + i * sizeof(double), &bits, sizeof(bits));
+                }
+            }, COST);
+        } //copy doubles between buffers of any alignment, reversing the bytes of each when swap is set
+    }
+
+    template<class T>
+    constexpr size_t getSerializedSize(size_t count) {
+        return count * Serialization::doublesOf<T>() * sizeof(double);
+    } //bytes needed to serialize count items
+
+    template<class T>
+    void serialize(const T *items, size_t count, void *out, Endian endian = Endian::Little) {
+        TENSORMATH_TRACE_SCOPE("serialize", count, Serialization::doublesOf<T>(), 0, 0);
+        Serialization::copy(items, out, count * Serialization::doublesOf<T>(), endian != Endian::Native);
+    } //write count items to out(getSerializedSize<T>(count) bytes, any alignment) in the given byte order
+
+    template<class T>
+    void deserialize(const void *in, size_t count, T *items, Endian endian = Endian::Little) {
+        TENSORMATH_TRACE_SCOPE("deserialize", count, Serialization::doublesOf<T>(), 0, 0);
+        Serialization::copy(in, items, count * Serialization::doublesOf<T>(), endian != Endian::Native);
+    } //read count items written by serialize() with the same byte order
+
+    template<class T>
+    bool writeBinary(std::ostream &out, const T *items, size_t count, Endian endian = Endian::Little) {
+        if (endian == Endian::Native) { //already in the right order, no copy
+            out.write((const char *) items, (std::streamsize) getSerializedSize<T>(count));
+            return out.good();
+        }
+        constexpr size_t BLOCK = (1 << 16) / getSerializedSize<T>(1) + 1; //items converted at once
+        std::vector<unsigned char> buffer(getSerializedSize<T>(BLOCK));
+        for (size_t start = 0; start < count && out.good(); start += BLOCK) {
+            size_t size = std::min(BLOCK, count - start);
+            serialize(items + start, size, buffer.data(), endian);
+            out.write((const char *) buffer.data(), (std::streamsize) getSerializedSize<T>(size));
+        }
+        return out.good();
+    } //write count items to a stream in the given byte order. false if the stream fails.
+
+    template<class T>
+    bool readBinary(std::istream &in, T *items, size_t count, Endian endian = Endian::Little) {
+        size_t bytes = getSerializedSize<T>(count);
+        in.read((char *) items, (std::streamsize) bytes);
+        if ((size_t) in.gcount() != bytes) { return false; }
+        if (endian != Endian::Native) { deserialize(items, count, items, endian); } //swap in place
+        return true;
+    } //read count items written by writeBinary() with the same byte order. false if there are not enough bytes.
+
+}
+
+#endif //TENSORMATH_SERIALIZATION_HPP
@@ -0,0 +1,268 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_SHARED_HPP
+#define TENSORMATH_SHARED_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <type_traits>
+#include "View.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <sys/file.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define TENSORMATH_SHARED 1
+#endif
+
+//single producer, single consumer ring buffer in POSIX shared memory, for handing results to another process on the host
+//the producer reserves room for a matrix or an array in the ring, writes the values straight into it(multiply into the
+//view, fill the array...), and publishes it. The consumer gets views of the same memory, no copy on either side.
+//handoff is lock free: the producer only moves head and the consumer only moves tail, both atomic counters in the segment
+//messages start on 64 byte boundaries, so values are aligned for SIMD
+//only one producer and one consumer may use a ring at once(threads or processes), messages can be up to half the capacity
+//the creator holds a lock on the segment while it lives. The system drops the lock if it crashes, which is how a
+//leftover segment is told from a live one.
+
+namespace TensorMath {
+
+    namespace Shared {
+        constexpr uint64_t MAGIC = 0x54454E534F525247ULL; //marks a ready segment
+        constexpr size_t ALIGNMENT = 64; //message and counter alignment
+
+        //what a message holds
+        enum class Kind : uint32_t {
+            Padding, //skipped, fills the end of the ring before a wrap
+            Matrix, //width x height doubles, column major
+            Array //count items of item_size bytes
+        };
+
+        //start of the segment
+        struct Header {
+            std::atomic<uint64_t> magic; //MAGIC once the segment is set up
+            uint64_t capacity; //bytes in the ring
+            alignas(ALIGNMENT) std::atomic<uint64_t> head; //bytes ever published, only the producer writes it
+            alignas(ALIGNMENT) std::atomic<uint64_t> tail; //bytes ever released, only the consumer writes it
+        };
+        static_assert(std::atomic<uint64_t>::is_always_lock_free, "Counters must be lock free to work across processes");
+
+        //start of every message in the ring
+        struct alignas(ALIGNMENT) Message {
+            uint64_t bytes; //whole message, header and padding included
+            uint64_t count; //array items
+            Kind kind;
+            uint32_t item_size; //bytes per array item
+            int32_t width, height; //matrix size
+        };
+
+        inline size_t roundUp(size_t bytes) { return (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT; }
+    }
+
+    //message a consumer received, points into the shared segment until it is released
+    class SharedMessage {
+    public:
+        //SETTERS AND GETTERS
+            bool isMatrix() const { return m_message->kind == Shared::Kind::Matrix; } //check if a matrix was sent
+            bool isArray() const { return m_message->kind == Shared::Kind::Array; } //check if an array was sent
+            ConstMatrixView matrix() const {
+                assert(isMatrix()); //not a matrix
+                return ConstMatrixView::columnMajor(values<double>(), m_message->width, m_message->height);
+            } //view the matrix, no copy
+            template<class T>
+            const T *array() const {
+                assert(isArray() && m_message->item_size == sizeof(T)); //not an array of T
+                return values<T>();
+            } //the array items, no copy
+            size_t getCount() const { return m_message->count; } //number of array items
+
+    private:
+        friend class SharedRing;
+        const Shared::Message *m_message = nullptr;
+        template<class T>
+        const T *values() const { return (const T *) (m_message + 1); }
+    };
+
+    //ring buffer in a named shared memory segment
+    class SharedRing {
+    public:
+        //CONSTRUCTORS
+            SharedRing(const std::string &name, size_t capacity) : m_name(name), m_owner(false) {
+                #ifdef TENSORMATH_SHARED
+                    capacity = Shared::roundUp(capacity);
+                    int file = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+                    if (file < 0 && errno == EEXIST && removeStale(name)) { //left by a creator that crashed
+                        file = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+                    }
+                    if (file < 0) { return; } //a live ring has the name, or another creator replaced the stale one first
+                    m_file = file; //the lock is held until this side is destroyed or its process ends
+                    if (flock(file, LOCK_EX | LOCK_NB) != 0 && errno == EWOULDBLOCK) { return; } //being removed as stale
+                    if (!isNamed(name, file)) { return; } //removed as stale before the lock was held, the name is not ours
+                    m_owner = true;
+                    m_size = sizeof(Shared::Header) + capacity;
+                    if (ftruncate(file, (off_t) m_size) == 0) { map(file); }
+                    if (m_header == nullptr) { return; }
+                    new(m_header) Shared::Header();
+                    m_header->capacity = capacity;
+                    m_header->head.store(0, std::memory_order_relaxed);
+                    m_header->tail.store(0, std::memory_order_relaxed);
+                    m_header->magic.store(Shared::MAGIC, std::memory_order_release); //ready for consumers
+                #endif
+            } //create a ring with room for capacity bytes of messages(either side may create it). Check isOpen(), fails while a live ring has the name(one left by a crashed creator is replaced).
+            explicit SharedRing(const std::string &name) : m_name(name), m_owner(false) {
+                #ifdef TENSORMATH_SHARED
+                    int file = shm_open(name.c_str(), O_RDWR, 0600);
+                    if (file < 0) { return; }
+                    struct stat info;
+                    if (fstat(file, &info) == 0 && (size_t) info.st_size >= sizeof(Shared::Header)) {
+                        m_size = (size_t) info.st_size;
+                        map(file);
+                    }
+                    close(file);
+                    if (m_header != nullptr && m_header->magic.load(std::memory_order_acquire) != Shared::MAGIC) { unmap(); }
+                #endif
+            } //open a ring another process created. Check isOpen().
+            SharedRing(const SharedRing &other) = delete;
+            SharedRing &operator=(const SharedRing &other) = delete;
+            ~SharedRing() {
+                unmap();
+                #ifdef TENSORMATH_SHARED
+                    if (m_owner) { shm_unlink(m_name.c_str()); }
+                    if (m_file >= 0) { close(m_file); } //drops the lock after the name is gone
+                #endif
+            } //unmap, and remove the name if this side created it(open mappings stay valid)
+
+        //SETTERS AND GETTERS
+            bool isOpen() const { return m_header != nullptr; } //check if the segment was created or opened
+            size_t getCapacity() const { return m_header == nullptr ? 0 : m_header->capacity; } //bytes of messages the ring holds, 0 if not open
+            static size_t getMatrixSize(int width, int height) {
+                return sizeof(Shared::Message) + Shared::roundUp((size_t) width * height * sizeof(double));
+            } //ring bytes one matrix message takes
+
+        //PRODUCER
+            MatrixView reserveMatrix(int width, int height) {
+                assert(isOpen()); //check isOpen() after creating or opening
+                Shared::Message *message = reserve((size_t) width * height * sizeof(double), Shared::Kind::Matrix);
+                if (message == nullptr) { return MatrixView::columnMajor(nullptr, 0, 0); }
+                message->width = width;
+                message->height = height;
+                return MatrixView::columnMajor((double *) (message + 1), width, height);
+            } //room for a column major matrix to write into, or a view of data() == nullptr while the ring is full
+            template<class T>
+            T *reserveArray(size_t count) {
+                static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be shared");
+                assert(isOpen()); //check isOpen() after creating or opening
+                Shared::Message *message = reserve(count * sizeof(T), Shared::Kind::Array);
+                if (message == nullptr) { return nullptr; }
+                message->count = count;
+                message->item_size = sizeof(T);
+                return new(message + 1) T[count]; //T(FixedVector...) is constructed in the segment
+            } //room for count items to write into, or nullptr while the ring is full
+            void publish() {
+                assert(m_pending != 0); //nothing reserved
+                m_header->head.store(m_pending, std::memory_order_release); //values written before this are visible
+                m_pending = 0;
+            } //hand the reserved message to the consumer
+
+        //CONSUMER
+            bool receive(SharedMessage &message) {
+                assert(isOpen()); //check isOpen() after creating or opening
+                uint64_t tail = m_header->tail.load(std::memory_order_relaxed);
+                while (tail != m_header->head.load(std::memory_order_acquire)) {
+                    const Shared::Message *next = at(tail);
+                    if (next->kind != Shared::Kind::Padding) {
+                        message.m_message = next;
+                        return true;
+                    }
+                    tail += next->bytes;
+                    m_header->tail.store(tail, std::memory_order_release);
+                }
+                return false;
+            } //get the oldest published message, false if there is none. It stays valid until release().
+            void release() {
+                uint64_t tail = m_header->tail.load(std::memory_order_relaxed);
+                assert(tail != m_header->head.load(std::memory_order_acquire)); //nothing received
+                m_header->tail.store(tail + at(tail)->bytes, std::memory_order_release); //room for the producer
+            } //done with the oldest message, its memory is reused
+
+    private:
+        std::string m_name;
+        bool m_owner; //created the segment
+        int m_file = -1; //the segment, kept open by the creator to hold its lock
+        size_t m_size = 0; //mapped bytes
+        Shared::Header *m_header = nullptr; //start of the mapping
+        uint64_t m_pending = 0; //head after the reserved message, 0 for none
+
+        static bool isNamed(const std::string &name, int file) {
+            #ifdef TENSORMATH_SHARED
+                int named = shm_open(name.c_str(), O_RDONLY, 0600);
+                if (named < 0) { return false; }
+                struct stat a, b;
+                bool same = fstat(named, &a) == 0 && fstat(file, &b) == 0 && a.st_dev == b.st_dev && a.st_ino == b.st_ino;
+                close(named);
+                return same;
+            #else
+                return false;
+            #endif
+        } //check if name still refers to the segment open as file
+        static bool removeStale(const std::string &name) {
+            #ifdef TENSORMATH_SHARED
+                int file = shm_open(name.c_str(), O_RDONLY, 0600);
+                if (file < 0) { return errno == ENOENT; } //already removed, try creating again
+                //no creator holds the lock(it crashed, even before the segment was set up), and the name was not reused
+                //meanwhile. Holding the lock until the name is gone keeps another creator from removing a newer ring.
+                bool stale = flock(file, LOCK_EX | LOCK_NB) == 0 && isNamed(name, file);
+                if (stale) { shm_unlink(name.c_str()); }
+                close(file);
+                return stale;
+            #else
+                return false;
+            #endif
+        } //remove a segment left by a creator that no longer runs, true if the name is free now
+        unsigned char *ring() const { return (unsigned char *) (m_header + 1); }
+        Shared::Message *at(uint64_t position) const {
+            return (Shared::Message *) (ring() + position % m_header->capacity);
+        } //message at a counter value
+        Shared::Message *reserve(size_t values, Shared::Kind kind) {
+            assert(m_pending == 0); //publish the last reservation first
+            size_t bytes = sizeof(Shared::Message) + Shared::roundUp(values);
+            size_t capacity = m_header->capacity;
+            assert(2 * bytes <= capacity); //messages up to half the capacity always fit, with room to wrap
+            uint64_t head = m_header->head.load(std::memory_order_relaxed);
+            size_t end = capacity - head % capacity; //bytes before the ring wraps
+            size_t padding = bytes > end ? end : 0; //messages never wrap
+            if (head + padding + bytes - m_header->tail.load(std::memory_order_acquire) > capacity) { return nullptr; }
+            if (padding > 0) {
+                Shared::Message *skip = at(head);
+                skip->kind = Shared::Kind::Padding;
+                skip->bytes = padding;
+            }
+            Shared::Message *message = at(head + padding);
+            *message = Shared::Message{bytes, 0, kind, 0, 0, 0};
+            m_pending = head + padding + bytes;
+            return message;
+        } //claim room for a message after the last one, nullptr if the consumer has not released enough
+        void map(int file) {
+            #ifdef TENSORMATH_SHARED
+                void *memory = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+                m_header = memory == MAP_FAILED ? nullptr : (Shared::Header *) memory;
+            #endif
+        } //map the whole segment
+        void unmap() {
+            #ifdef TENSORMATH_SHARED
+                if (m_header != nullptr) { munmap(m_header, m_size); }
+            #endif
+            m_header = nullptr;
+        } //unmap the segment
+    };
+
+}
+
+#endif //TENSORMATH_SHARED_HPP
@@ -0,0 +1,151 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_STRASSEN_HPP
+#define TENSORMATH_STRASSEN_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include "View.hpp"
+
+//Strassen-Winograd matrix multiplication: 7 half size products and 15 additions per level instead of 8 products,
+//so roughly n^2.81 work instead of n^3. Levels stop at the cutoff size, where the blocked gemm kernel takes over.
+//
+//Error: the classic product has |C - C'| <= k * u * |A| * |B| for every value(u = 2^-53).
+//Strassen-Winograd only has a bound on the largest error, relative to the largest values of A and B:
+//max|C - C'| <= ((k/k0)^log2(18) * (k0^2 + 6 * k0) - 6 * k) * u * max|A| * max|B|, with k0 the size at the cutoff
+//(Higham, Accuracy and Stability of Numerical Algorithms, 23.2). Each level multiplies the worst case by about 18/2,
+//so small values next to large ones lose relative accuracy. Keep it for well scaled data and large products.
+
+namespace TensorMath {
+
+    namespace Strassen {
+        inline std::atomic<int> &cutoff() {
+            static std::atomic<int> value{0};
+            return value;
+        } //cutoff Matrix products use, 0 is off
+
+        inline std::vector<double> &workspace() {
+            thread_local std::vector<double> buffer;
+            return buffer;
+        } //scratch memory kept between products, so repeated products do not allocate
+
+        inline size_t workspaceSize(size_t m, size_t n, size_t k, int levels) {
+            size_t size = 0;
+            for (int level = 0; level < levels; ++level) {
+                m /= 2;
+                n /= 2;
+                k /= 2;
+                size += m * k + k * n + m * n; //X, Y and Z of this level
+            }
+            return size;
+        } //doubles needed by all levels of a product
+
+        inline void recurse(const ConstMatrixView &a, const ConstMatrixView &b, MatrixView c, int levels,
+                            double *scratch) {
+            if (levels == 0) {
+                multiply(a, b, c); //blocked gemm base case
+                return;
+            }
+            int m = a.getHeight() / 2;
+            int k = a.getWidth() / 2;
+            int n = b.getWidth() / 2;
+            ConstMatrixView a11 = a.block(0, 0, k, m), a12 = a.block(k, 0, k, m);
+            ConstMatrixView a21 = a.block(0, m, k, m), a22 = a.block(k, m, k, m);
+            ConstMatrixView b11 = b.block(0, 0, n, k), b12 = b.block(n, 0, n, k);
+            ConstMatrixView b21 = b.block(0, k, n, k), b22 = b.block(n, k, n, k);
+            MatrixView c11 = c.block(0, 0, n, m), c12 = c.block(n, 0, n, m);
+            MatrixView c21 = c.block(0, m, n, m), c22 = c.block(n, m, n, m);
+            //temporaries for this level, the levels below use the rest of the scratch memory
+            MatrixView x = MatrixView::columnMajor(scratch, k, m);
+            MatrixView y = MatrixView::columnMajor(x.data() + (size_t) m * k, n, k);
+            MatrixView z = MatrixView::columnMajor(y.data() + (size_t) k * n, n, m);
+            double *below = z.data() + (size_t) m * n;
+            //the c quadrants hold products until they can be combined, so only x, y and z are extra
+            subtract(a11, a21, x); //S3
+            subtract(b22, b12, y); //T3
+            recurse(x, y, c21, levels - 1, below); //M7 = S3 * T3
+            add(a21, a22, x); //S1
+            subtract(b12, b11, y); //T1
+            recurse(x, y, c22, levels - 1, below); //M5 = S1 * T1
+            x -= a11; //S2 = S1 - A11
+            y *= -1;
+            y += b22; //T2 = B22 - T1
+            recurse(x, y, c12, levels - 1, below); //M6 = S2 * T2
+            x *= -1;
+            x += a12; //S4 = A12 - S2
+            recurse(a11, b11, z, levels - 1, below); //M1
+            c12 += z; //U2 = M1 + M6
+            c21 += c12; //U3 = U2 + M7
+            c12 += c22; //U4 = U2 + M5
+            c22 += c21; //U7 = U3 + M5, done
+            recurse(a12, b21, c11, levels - 1, below); //M2
+            c11 += z; //U1 = M1 + M2, done
+            recurse(x, b22, z, levels - 1, below); //M3 = S4 * B22
+            c12 += z; //U5 = U4 + M3, done
+            y -= b21; //T4 = T2 - B21
+            recurse(a22, y, z, levels - 1, below); //M4 = A22 * T4
+            c21 -= z; //U6 = U3 - M4, done
+        } //one Winograd level, all sizes must be divisible by 2^levels
+    }
+
+    inline int getStrassenCutoff() {
+        return Strassen::cutoff().load(std::memory_order_relaxed);
+    } //get the cutoff Matrix products use, 0 means Strassen-Winograd is off
+
+    inline void setStrassenCutoff(int size) {
+        assert(size >= 0); //negative size
+        Strassen::cutoff().store(size, std::memory_order_relaxed);
+    } //opt in to Strassen-Winograd for Matrix products, halving until products are smaller than 2 * size(try 256). 0 turns it off.
+
+    inline void multiplyStrassen(const ConstMatrixView &a, const ConstMatrixView &b, MatrixView out, int cutoff = 256) {
+        assert(a.getWidth() == b.getHeight()); //number of columns in a must be equal to # of rows in b
+        assert(out.getWidth() == b.getWidth() && out.getHeight() == a.getHeight()); //output must be result size
+        assert(cutoff > 0); //too small cutoff
+        TENSORMATH_TIME(Multiply); //flops are counted by the cutoff sized products
+        TENSORMATH_TRACE_SCOPE("multiplyStrassen", a.getHeight(), b.getWidth(), a.getWidth(), 0);
+        size_t m = a.getHeight(), n = b.getWidth(), k = a.getWidth();
+        int levels = 0;
+        while ((std::min(std::min(m, n), k) >> levels) >= 2 * (size_t) cutoff) { levels++; } //halve down to the cutoff
+        if (levels == 0) {
+            multiply(a, b, out);
+            return;
+        }
+        //round every size up to a multiple of 2^levels, padding with zeros
+        size_t step = (size_t) 1 << levels;
+        size_t padded_m = (m + step - 1) / step * step;
+        size_t padded_n = (n + step - 1) / step * step;
+        size_t padded_k = (k + step - 1) / step * step;
+        bool pad_a = padded_m != m || padded_k != k || !a.isColumnMajor();
+        bool pad_b = padded_k != k || padded_n != n || !b.isColumnMajor();
+        bool pad_c = padded_m != m || padded_n != n || !out.isColumnMajor();
+        size_t scratch = Strassen::workspaceSize(padded_m, padded_n, padded_k, levels);
+        size_t needed = scratch + (pad_a ? padded_m * padded_k : 0) + (pad_b ? padded_k * padded_n : 0) +
+                        (pad_c ? padded_m * padded_n : 0);
+        std::vector<double> &workspace = Strassen::workspace();
+        if (workspace.size() < needed) { workspace.resize(needed); }
+        double *a_padded = workspace.data() + scratch;
+        double *b_padded = a_padded + (pad_a ? padded_m * padded_k : 0);
+        double *c_padded = b_padded + (pad_b ? padded_k * padded_n : 0);
+        if (pad_a) {
+            MatrixView padded = MatrixView::columnMajor(a_padded, (int) padded_k, (int) padded_m);
+            padded = 0.0;
+            padded.block(0, 0, (int) k, (int) m) = a;
+        }
+        if (pad_b) {
+            MatrixView padded = MatrixView::columnMajor(b_padded, (int) padded_n, (int) padded_k);
+            padded = 0.0;
+            padded.block(0, 0, (int) n, (int) k) = b;
+        }
+        ConstMatrixView a_used = pad_a ? ConstMatrixView::columnMajor(a_padded, (int) padded_k, (int) padded_m) : a;
+        ConstMatrixView b_used = pad_b ? ConstMatrixView::columnMajor(b_padded, (int) padded_n, (int) padded_k) : b;
+        MatrixView c_used = pad_c ? MatrixView::columnMajor(c_padded, (int) padded_n, (int) padded_m) : out;
+        Strassen::recurse(a_used, b_used, c_used, levels, workspace.data());
+        if (pad_c) { out = c_used.block(0, 0, (int) n, (int) m); }
+    } //out = a * b with Strassen-Winograd down to cutoff sized gemm products. out must not overlap a or b.
+
+}
+
+#endif //TENSORMATH_STRASSEN_HPP
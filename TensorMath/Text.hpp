@@ -0,0 +1,197 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_TEXT_HPP
+#define TENSORMATH_TEXT_HPP
+
+#include <atomic>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "View.hpp"
+
+//text files of numbers: one row per line, values separated by commas, semicolons, spaces or tabs(CSV and whitespace)
+//reading is streamed in chunks, the lines of a chunk are parsed on the thread pool with std::from_chars(no locale, no
+//allocation per value), and only the values are kept in memory, never the whole file
+//writing formats blocks of rows on the thread pool with std::to_chars and writes each block with one call
+//values are written in the shortest form that reads back to exactly the same double
+
+namespace TensorMath {
+
+    namespace Text {
+        constexpr size_t CHUNK = 1 << 20; //bytes read at once
+        constexpr size_t BLOCK = 1 << 14; //values formatted at once by one thread
+        constexpr int BLOCKS = 16; //blocks formatted before they are written
+        constexpr size_t PARSE_COST = 16; //parsing a value costs about as much as this many additions, for parallelFor
+
+        inline bool isSeparator(char c) {
+            return c == ',' || c == ';' || c == ' ' || c == '\t' || c == '\r';
+        } //characters between values
+
+        inline int parseLine(const char *begin, const char *end, double *out, int limit) {
+            int count = 0;
+            const char *position = begin;
+            while (true) {
+                while (position < end && isSeparator(*position)) { ++position; }
+                if (position == end) { return count; }
+                if (*position == '+') { ++position; } //from_chars does not take a plus sign
+                if (count == limit) { return -1; } //too many values
+                std::from_chars_result result = std::from_chars(position, end, out[count]);
+                if (result.ec == std::errc::invalid_argument || (result.ptr < end && !isSeparator(*result.ptr))) {
+                    return -1; //not a number
+                }
+                if (result.ec == std::errc::result_out_of_range) { //from_chars leaves these unset, strtod gives inf or 0
+                    out[count] = std::strtod(std::string(position, result.ptr).c_str(), nullptr);
+                }
+                position = result.ptr;
+                ++count;
+            }
+        } //parse the values of one line into out, returns how many, or -1 for bad text or more than limit values
+
+        inline bool isBlank(const char *begin, const char *end) {
+            while (begin < end && isSeparator(*begin)) { ++begin; }
+            return begin == end;
+        } //line without values
+
+        inline void appendValue(std::string &out, double value) {
+            char buffer[32];
+            std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            out.append(buffer, result.ptr);
+        } //append the shortest text that reads back to value
+    }
+
+    inline bool readText(std::istream &in, std::vector<double> &values, int &width, int &height) {
+        TENSORMATH_TRACE_SCOPE("readText", 0, 0, 0, 0);
+        values.clear();
+        width = 0;
+        height = 0;
+        std::string buffer;
+        std::vector<std::pair<const char *, const char *>> lines;
+        size_t kept = 0; //start of a line that continues in the next chunk
+        bool finished = false;
+        while (!finished) {
+            buffer.resize(kept + Text::CHUNK);
+            in.read(&buffer[kept], (std::streamsize) Text::CHUNK);
+            size_t size = kept + (size_t) in.gcount();
+            if (in.bad()) { return false; }
+            finished = size < kept + Text::CHUNK;
+            size_t complete = size; //end of the last whole line
+            if (!finished) {
+                size_t last = buffer.rfind('\n', size - 1);
+                if (last == std::string::npos) { //line longer than a chunk, read more of it
+                    kept = size;
+                    continue;
+                }
+                complete = last + 1;
+            }
+            lines.clear();
+            for (const char *position = buffer.data(), *end = buffer.data() + complete; position < end;) {
+                const char *line_end = (const char *) std::memchr(position, '\n', end - position);
+                if (line_end == nullptr) { line_end = end; }
+                if (!Text::isBlank(position, line_end)) { lines.emplace_back(position, line_end); }
+                position = line_end + 1;
+            }
+            if (!lines.empty() && width == 0) { //the first line sets the width
+                std::vector<double> first((lines[0].second - lines[0].first) / 2 + 1);
+                width = Text::parseLine(lines[0].first, lines[0].second, first.data(), (int) first.size());
+                if (width <= 0) { return false; }
+            }
+            size_t start = values.size();
+            values.resize(start + lines.size() * width);
+            std::atomic<bool> failed{false};
+            parallelFor(lines.size(), [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    if (Text::parseLine(lines[i].first, lines[i].second, &values[start + i * width], width) != width) {
+                        failed.store(true, std::memory_order_relaxed);
+                    }
+                }
+            }, (size_t) width * Text::PARSE_COST);
+            if (failed.load()) { return false; }
+            height += (int) lines.size();
+            kept = size - complete;
+            std::memmove(&buffer[0], buffer.data() + complete, kept);
+        }
+        TENSORMATH_TRACE_SIZES(width, height, 0);
+        return height > 0;
+    } //read rows of numbers into values(one row after another), width x height.
+      //false if the text is not numbers, rows have different lengths, there are no values, or the stream fails.
+
+    inline bool readText(std::istream &in, MatrixView out) {
+        std::vector<double> values;
+        int width, height;
+        if (!readText(in, values, width, height) || width != out.getWidth() || height != out.getHeight()) { return false; }
+        out = ConstMatrixView::rowMajor(values.data(), width, height);
+        return true;
+    } //read rows of numbers into a matrix of known size. false if the text is not numbers of exactly that size.
+
+    inline bool readText(std::istream &in, VectorView out) {
+        std::vector<double> values;
+        int width, height;
+        if (!readText(in, values, width, height) || values.size() != (size_t) out.getDim()) { return false; }
+        out = ConstVectorView(values.data(), out.getDim());
+        return true;
+    } //read numbers into a vector of known size, in row order(a row, a column or any shape of that many values)
+
+    inline bool writeText(std::ostream &out, const ConstMatrixView &matrix, char separator = ',') {
+        int width = matrix.getWidth(), height = matrix.getHeight();
+        TENSORMATH_TRACE_SCOPE("writeText", width, height, 0, 0);
+        int rows = (int) std::max((size_t) 1, Text::BLOCK / std::max(width, 1)); //rows per block
+        std::string blocks[Text::BLOCKS];
+        for (int first = 0; first < height && out.good(); first += rows * Text::BLOCKS) {
+            int count = std::min(Text::BLOCKS, (height - first + rows - 1) / rows);
+            parallelFor((size_t) count, [&](size_t begin, size_t end) {
+                for (size_t block = begin; block < end; ++block) {
+                    std::string &text = blocks[block];
+                    text.clear();
+                    int start = first + (int) block * rows, stop = std::min(height, start + rows);
+                    for (int y = start; y < stop; ++y) {
+                        for (int x = 0; x < width; ++x) {
+                            if (x > 0) { text += separator; }
+                            Text::appendValue(text, matrix.atUnchecked(x, y));
+                        }
+                        text += '\n';
+                    }
+                }
+            }, (size_t) rows * width * Text::PARSE_COST);
+            for (int block = 0; block < count; ++block) { out.write(blocks[block].data(), (std::streamsize) blocks[block].size()); }
+        }
+        return out.good();
+    } //write one line per row, values separated by separator. false if the stream fails.
+
+    inline bool writeText(std::ostream &out, const ConstVectorView &vector) {
+        return writeText(out, ConstMatrixView(vector.data(), 1, vector.getDim(), vector.getDim() * vector.getStride(),
+                                              vector.getStride()));
+    } //write one value per line(a column). false if the stream fails.
+
+    inline bool loadText(const std::string &path, std::vector<double> &values, int &width, int &height) {
+        std::ifstream file(path, std::ios::binary);
+        return file.is_open() && readText(file, values, width, height);
+    } //read a text file of rows of numbers, see readText()
+
+    inline bool loadText(const std::string &path, MatrixView out) {
+        std::ifstream file(path, std::ios::binary);
+        return file.is_open() && readText(file, out);
+    } //read a text file into a matrix of known size
+
+    inline bool loadText(const std::string &path, VectorView out) {
+        std::ifstream file(path, std::ios::binary);
+        return file.is_open() && readText(file, out);
+    } //read a text file into a vector of known size
+
+    inline bool saveText(const std::string &path, const ConstMatrixView &matrix, char separator = ',') {
+        std::ofstream file(path, std::ios::binary);
+        return file.is_open() && writeText(file, matrix, separator);
+    } //write a matrix to a text file, one line per row
+
+    inline bool saveText(const std::string &path, const ConstVectorView &vector) {
+        std::ofstream file(path, std::ios::binary);
+        return file.is_open() && writeText(file, vector);
+    } //write a vector to a text file, one value per line
+
+}
+
+#endif //TENSORMATH_TEXT_HPP
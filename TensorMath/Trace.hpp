@@ -0,0 +1,181 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_TRACE_HPP
+#define TENSORMATH_TRACE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//optional tracing of heavy operations(products, batches, layers, text I/O...), exported as Chrome trace JSON
+//open the file in chrome://tracing or https://ui.perfetto.dev to see which call got slow, on which thread, for what sizes
+//define TENSORMATH_TRACE(before including, or -DTENSORMATH_TRACE) to turn it on, otherwise the hooks are empty
+//every thread records into its own fixed size buffer without locks, events past the end are dropped and counted
+
+namespace TensorMath {
+
+    //one finished operation
+    struct TraceEvent {
+        const char *name; //operation, a string literal
+        int64_t start; //nanoseconds since tracing started
+        int64_t duration; //nanoseconds
+        int64_t sizes[3]; //operation sizes, for products m, n and k
+        uint64_t flops; //floating point operations, 0 when not counted
+    };
+
+    namespace Tracing {
+        constexpr size_t CAPACITY = 1 << 16; //events each thread keeps
+
+        //events of one thread, only that thread writes them
+        struct ThreadBuffer {
+            std::vector<TraceEvent> events = std::vector<TraceEvent>(CAPACITY);
+            std::atomic<size_t> count{0}; //events written, published after each event
+            std::atomic<uint64_t> dropped{0}; //events that did not fit
+            int id = 0; //thread number in the trace
+        };
+
+        inline std::chrono::steady_clock::time_point epoch() {
+            static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            return start;
+        } //time 0 of the trace
+
+        inline int64_t now() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch()).count();
+        } //nanoseconds since time 0
+
+        inline std::mutex &registryMutex() {
+            static std::mutex mutex;
+            return mutex;
+        } //guards the registry
+        inline std::vector<std::unique_ptr<ThreadBuffer>> &registry() {
+            static std::vector<std::unique_ptr<ThreadBuffer>> threads;
+            return threads;
+        } //buffers of every thread that traced something, kept after the thread ends
+
+        inline ThreadBuffer &local() {
+            thread_local ThreadBuffer *buffer = []() {
+                epoch(); //start the clock before the first event
+                std::lock_guard<std::mutex> lock(registryMutex());
+                registry().emplace_back(new ThreadBuffer());
+                registry().back()->id = (int) registry().size() - 1;
+                return registry().back().get();
+            }();
+            return *buffer;
+        } //buffer of the calling thread, registered on first use
+
+        //records an event from construction to destruction
+        class Scope {
+        public:
+            Scope(const char *name, int64_t m, int64_t n, int64_t k, uint64_t flops) :
+                    m_event{name, now(), 0, {m, n, k}, flops} {}
+            void setSizes(int64_t m, int64_t n, int64_t k) {
+                m_event.sizes[0] = m;
+                m_event.sizes[1] = n;
+                m_event.sizes[2] = k;
+            } //sizes found out during the operation
+            Scope(const Scope &other) = delete;
+            Scope &operator=(const Scope &other) = delete;
+            ~Scope() {
+                m_event.duration = now() - m_event.start;
+                ThreadBuffer &buffer = local();
+                size_t count = buffer.count.load(std::memory_order_relaxed);
+                if (count == CAPACITY) {
+                    buffer.dropped.store(buffer.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                    return;
+                }
+                buffer.events[count] = m_event;
+                buffer.count.store(count + 1, std::memory_order_release); //event is complete before it is counted
+            }
+
+        private:
+            TraceEvent m_event;
+        };
+    }
+
+    #ifdef TENSORMATH_TRACE
+        #define TENSORMATH_TRACE_SCOPE(name, m, n, k, flops) \
+            ::TensorMath::Tracing::Scope tensormath_trace(name, (int64_t) (m), (int64_t) (n), (int64_t) (k), (uint64_t) (flops))
+    #else
+        #define TENSORMATH_TRACE_SCOPE(name, m, n, k, flops) ((void) 0)
+    #endif
+    #ifdef TENSORMATH_TRACE
+        #define TENSORMATH_TRACE_SIZES(m, n, k) tensormath_trace.setSizes((int64_t) (m), (int64_t) (n), (int64_t) (k))
+    #else
+        #define TENSORMATH_TRACE_SIZES(m, n, k) ((void) 0)
+    #endif
+
+    constexpr bool isTraceEnabled() {
+        #ifdef TENSORMATH_TRACE
+            return true;
+        #else
+            return false;
+        #endif
+    } //check if the library was built with TENSORMATH_TRACE
+
+    inline std::vector<TraceEvent> getTraceEvents(int thread) {
+        std::lock_guard<std::mutex> lock(Tracing::registryMutex());
+        if (thread < 0 || thread >= (int) Tracing::registry().size()) { return {}; }
+        const Tracing::ThreadBuffer &buffer = *Tracing::registry()[thread];
+        size_t count = buffer.count.load(std::memory_order_acquire);
+        return std::vector<TraceEvent>(buffer.events.begin(), buffer.events.begin() + count);
+    } //finished events of one thread so far, in the order they ended
+
+    inline int getTraceThreadCount() {
+        std::lock_guard<std::mutex> lock(Tracing::registryMutex());
+        return (int) Tracing::registry().size();
+    } //threads that recorded events
+
+    inline uint64_t getTraceDropped() {
+        std::lock_guard<std::mutex> lock(Tracing::registryMutex());
+        uint64_t dropped = 0;
+        for (const std::unique_ptr<Tracing::ThreadBuffer> &buffer: Tracing::registry()) {
+            dropped += buffer->dropped.load(std::memory_order_relaxed);
+        }
+        return dropped;
+    } //events that did not fit in their thread's buffer
+
+    inline void clearTrace() {
+        std::lock_guard<std::mutex> lock(Tracing::registryMutex());
+        for (const std::unique_ptr<Tracing::ThreadBuffer> &buffer: Tracing::registry()) {
+            buffer->count.store(0, std::memory_order_relaxed);
+            buffer->dropped.store(0, std::memory_order_relaxed);
+        }
+    } //forget all events. Only while no traced operation is running.
+
+    inline bool writeChromeTrace(std::ostream &out) {
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        char number[64];
+        for (int thread = 0; thread < getTraceThreadCount(); ++thread) {
+            out << (first ? "" : ",") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread
+                << ",\"args\":{\"name\":\"TensorMath " << thread << "\"}}";
+            first = false;
+            for (const TraceEvent &event: getTraceEvents(thread)) {
+                out << ",{\"name\":\"" << event.name << "\",\"cat\":\"TensorMath\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread;
+                snprintf(number, sizeof(number), "%.3f", event.start / 1000.0); //microseconds
+                out << ",\"ts\":" << number;
+                snprintf(number, sizeof(number), "%.3f", event.duration / 1000.0);
+                out << ",\"dur\":" << number << ",\"args\":{\"size\":[" << event.sizes[0] << "," << event.sizes[1] << ","
+                    << event.sizes[2] << "],\"flops\":" << event.flops << "}}";
+            }
+        }
+        out << "]}\n";
+        return out.good();
+    } //write every event as Chrome trace JSON(complete events, one track per thread). false if the stream fails.
+
+    inline bool saveChromeTrace(const std::string &path) {
+        std::ofstream file(path);
+        return file.is_open() && writeChromeTrace(file);
+    } //write the trace to a file, for chrome://tracing or ui.perfetto.dev
+
+}
+
+#endif //TENSORMATH_TRACE_HPP
@@ -6,14 +6,83 @@
 #define TENSOR_VECTOR_HPP
 
 #include <cassert>
+#include <charconv>
 #include <string>
 #include <cstdarg>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
 #include <vector>
 #include <iostream>
+#include "Dispatch.hpp"
+#include "Parallel.hpp"
+#include "Bounds.hpp"
+#include "Instrument.hpp"
+#include "Trace.hpp"
+#include "Random.hpp"
 
 namespace TensorMath {
 
+    //precision of the approximate reciprocal square root used by normalizedFast()
+    //each level is one more Newton step, roughly doubling the number of correct digits
+    enum class Precision {
+        Low = 2,    //relative error around 5e-6, enough for shading directions
+        Medium = 3, //relative error around 3e-11
+        High = 4    //within a few ulp of 1.0/std::sqrt(x)
+    };
+
+    inline double multiplyAdd(double a, double b, double c) {
+        #ifdef FP_FAST_FMA
+            return std::fma(a, b, c);
+        #else
+            return a * b + c;
+        #endif
+    } //a * b + c, fused into one instruction when the target has hardware FMA(-mfma, -march=haswell...)
+
+    namespace Text {
+        inline void appendFixed(std::string &out, double value) {
+            char buffer[320]; //fixed notation of the largest double
+            std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 6);
+            out.append(buffer, result.ptr);
+        } //append value with 6 decimals, the same text as std::to_string without a temporary string(see Text.hpp)
+    }
+
+    inline double fastInverseSqrt(double x, Precision precision = Precision::Medium) {
+        uint64_t bits;
+        std::memcpy(&bits, &x, sizeof(double));
+        bits = 0x5FE6EB50C7B537A9ULL - (bits >> 1); //initial guess, within 3.5%
+        double y;
+        std::memcpy(&y, &bits, sizeof(double));
+        const double half_x = 0.5 * x;
+        for (int i = 0; i < (int) precision; ++i) {
+            y = y * multiplyAdd(-half_x, y * y, 1.5); //Newton step: y * (1.5 - x/2 * y^2)
+        }
+        return y;
+    } //approximate 1.0/std::sqrt(x) without a divide or sqrt, for positive normal x
+
+    inline double dotProduct(const double *a, const double *b, size_t count) {
+        return parallelReduce(count, [&](size_t begin, size_t end) {
+            return kernels().dot(a + begin, b + begin, (int) (end - begin));
+        });
+    } //dot product of two arrays, the dispatched kernel on each fixed size chunk(see parallelReduce)
+
+    inline double distanceSquared(const double *a, const double *b, size_t count) {
+        constexpr int BLOCK = 256; //differences taken at once
+        return parallelReduce(count, [&](size_t begin, size_t end) {
+            double difference[BLOCK];
+            double sum = 0;
+            for (size_t start = begin; start < end; start += BLOCK) {
+                int size = (int) std::min((size_t) BLOCK, end - start);
+                kernels().subtract(a + start, b + start, difference, size);
+                sum += kernels().dot(difference, difference, size);
+            }
+            return sum;
+        });
+    } //squared distance between two arrays, with the dispatched kernels on each fixed size chunk
+
     //n dimensional vector class for doubles
+    //large vectors split elementwise operations and reductions across the shared thread pool(see Parallel.hpp)
     //Contains assertions for things like mismatched vector sizes(Make sure define NDEBUG for max performance)
     class Vector {
 
@@ -23,18 +92,22 @@ namespace TensorMath {
                 assert(dimensions > 0); //too small dimensions
                 m_dimensions = dimensions;
                 m_data = new double[dimensions];
-                setZero();
+                TENSORMATH_COUNT_ALLOCATION(dimensions * sizeof(double));
+                parallelFill(m_data, m_dimensions, 0); //first touch from the threads that will use it
             }   //create a new vector of dimensions n, zero initialized
             Vector(const Vector &other) {
                 m_dimensions = other.m_dimensions;
                 m_data = new double[m_dimensions];
-                for (int i = 0; i < m_dimensions; ++i) { m_data[i] = other[i]; }
+                TENSORMATH_COUNT_ALLOCATION(m_dimensions * sizeof(double));
+                TENSORMATH_COUNT_COPY(m_dimensions * sizeof(double));
+                parallelCopy(other.m_data, m_data, m_dimensions);
             }  //copy constructor
             Vector(std::initializer_list<double> values) {
                 std::vector<double> v(values);
                 m_dimensions = (int) v.size();
                 assert(m_dimensions > 0); //too small dimensions
                 m_data = new double[m_dimensions];
+                TENSORMATH_COUNT_ALLOCATION(m_dimensions * sizeof(double));
                 for (int i = 0; i < v.size(); ++i) { m_data[i] = v[i]; }
             }   //{} initialization constructor
             ~Vector() { delete[] m_data; }  //destructor
@@ -49,10 +122,27 @@ namespace TensorMath {
             void setScalar(double scalar) { for (int i = 0; i < m_dimensions; ++i) { m_data[i] = scalar; }} //set to scalar value
             void setZero() { setScalar(0); }  //set all to zero
             double getValue(int i) const {
-                assert(i < m_dimensions); //index out of vector range
+                TENSORMATH_CHECK_INDEX(i, m_dimensions); //index out of vector range
+                return m_data[i];
+            } //get a value, checked by the bounds policy(see Bounds.hpp)
+            double at(int i) const {
+                Bounds::check(i, m_dimensions);
                 return m_data[i];
-            } //get a value
+            } //get a value, throws std::out_of_range for a bad index
+            double &at(int i) {
+                Bounds::check(i, m_dimensions);
+                return m_data[i];
+            } //get or set a value, throws std::out_of_range for a bad index
+            double atUnchecked(int i) const { return m_data[i]; } //get a value without any check, for hot loops
+            double &atUnchecked(int i) { return m_data[i]; } //get or set a value without any check, for hot loops
             int getDim() const { return m_dimensions; } //get num dimensions
+            double *data() { return m_data; } //get the contiguous components(for kernels and other libraries)
+            const double *data() const { return m_data; } //get the contiguous components(read only)
+            double *begin() { return m_data; } //first value, for range for and standard algorithms(contiguous iterator)
+            double *end() { return m_data + m_dimensions; } //past the last value
+            const double *begin() const { return m_data; } //first value(read only)
+            const double *end() const { return m_data + m_dimensions; } //past the last value(read only)
+            size_t size() const { return (size_t) m_dimensions; } //number of values, for standard code(same as getDim())
             //get by names
             double inline x() const { return getValue(0); }
             double inline y() const { return getValue(1); }
@@ -67,7 +157,7 @@ namespace TensorMath {
             } //compare to scalar value, using epsilon for reliability
             bool equals(const Vector &other, double epsilon = std::numeric_limits<double>::epsilon()*10) const {
                 if (other.m_dimensions != m_dimensions) { return false; }//not same size
-                for (int i = 0; i < m_dimensions; ++i) { if (!doubleEquals(m_data[i], other[i], epsilon)) {
+                for (int i = 0; i < m_dimensions; ++i) { if (!doubleEquals(m_data[i], other.atUnchecked(i), epsilon)) {
                     return false; }}
                 return true;
             } //compare to other vector, using epsilon for reliability
@@ -77,7 +167,7 @@ namespace TensorMath {
             //Getting and setting values
             double operator[](int i) const { return getValue(i); } //getting with brackets
             double &operator[](int i) {
-                assert(i < m_dimensions); //index out of vector range
+                TENSORMATH_CHECK_INDEX(i, m_dimensions); //index out of vector range
                 return m_data[i];
             } //setting with brackets
             Vector &operator=(double scalar) {
@@ -87,9 +177,7 @@ namespace TensorMath {
             Vector &operator=(const Vector &other) { //assign from other vector
                 if (this != &other) {//handle self assignment
                     assert(other.m_dimensions == m_dimensions); //can not assign different dimensional vector
-                    for (int i = 0; i < m_dimensions; ++i) {
-                        m_data[i] = other[i];
-                    }
+                    parallelCopy(other.m_data, m_data, m_dimensions);
                 }
                 return *this;
             }   //set to a scalar value with operator
@@ -100,51 +188,40 @@ namespace TensorMath {
             //Scalar operations
             Vector inline operator+(const double &scalar) const { //adding
                 Vector out(m_dimensions);
-                for (int i = 0; i < m_dimensions; ++i) {
-                    out[i] = m_data[i] + scalar;
-                }
+                forEach([&](int i) { out.m_data[i] = m_data[i] + scalar; });
                 return out;
             }
             void inline operator+=(const double &scalar) {
-                for (int i = 0; i < m_dimensions; ++i) {
-                    m_data[i] = m_data[i] + scalar;
-                }
+                forEach([&](int i) { m_data[i] = m_data[i] + scalar; });
             }
             Vector inline operator-(const double &scalar) const { //subtracting
                 Vector out(m_dimensions);
-                for (int i = 0; i < m_dimensions; ++i) {
-                    out[i] = m_data[i] - scalar;
-                }
+                forEach([&](int i) { out.m_data[i] = m_data[i] - scalar; });
                 return out;
             }
             void inline operator-=(const double &scalar) {  //multiplying
-                for (int i = 0; i < m_dimensions; ++i) {
-                    m_data[i] = m_data[i] - scalar;
-                }
+                forEach([&](int i) { m_data[i] = m_data[i] - scalar; });
             }
             Vector inline operator*(const double &scalar) const {
                 Vector out(m_dimensions);
-                for (int i = 0; i < m_dimensions; ++i) {
-                    out[i] = m_data[i] * scalar;
-                }
+                TENSORMATH_TIME(Elementwise);
+                TENSORMATH_COUNT_FLOPS(m_dimensions);
+                const KernelTable &table = kernels();
+                parallelFor(m_dimensions, [&](size_t begin, size_t end) {
+                    table.scale(m_data + begin, scalar, out.m_data + begin, (int) (end - begin));
+                });
                 return out;
             }
             void inline operator*=(const double &scalar) {
-                for (int i = 0; i < m_dimensions; ++i) {
-                    m_data[i] = m_data[i] * scalar;
-                }
+                forEach([&](int i) { m_data[i] = m_data[i] * scalar; });
             }
             Vector inline operator/(const double &scalar) const { //dividing
                 Vector out(m_dimensions);
-                for (int i = 0; i < m_dimensions; ++i) {
-                    out[i] = m_data[i] / scalar;
-                }
+                forEach([&](int i) { out.m_data[i] = m_data[i] / scalar; });
                 return out;
             }
             void inline operator/=(const double &scalar) {
-                for (int i = 0; i < m_dimensions; ++i) {
-                    m_data[i] = m_data[i] / scalar;
-                }
+                forEach([&](int i) { m_data[i] = m_data[i] / scalar; });
             }
             bool operator==(const double &scalar) const {
                 return equalsScalar(scalar);
@@ -156,65 +233,47 @@ namespace TensorMath {
             Vector inline operator+(const Vector &other) const { //adding
                 assert(other.m_dimensions == m_dimensions); //Not same size vectors
                 Vector out(m_dimensions);
-                for (int i = 0; i < m_dimensions; ++i) {
-                    out[i] = m_data[i] + other[i];
-                }
+                zipKernel(other, out, kernels().add);
                 return out;
             }
             void inline operator+=(const Vector &other) {
                 assert(other.m_dimensions == m_dimensions); //Not same size vectors
-                for (int i = 0; i < m_dimensions; ++i) {
-                    m_data[i] = m_data[i] + other[i];
-                }
+                forEach([&](int i) { m_data[i] = m_data[i] + other.m_data[i]; });
             }
             Vector inline operator-(const Vector &other) const { //subtracting
                 assert(other.m_dimensions == m_dimensions); //Not same size vectors
                 Vector out(m_dimensions);
-                for (int i = 0; i < m_dimensions; ++i) {
-                    out[i] = m_data[i] - other[i];
-                }
+                zipKernel(other, out, kernels().subtract);
                 return out;
             }
             Vector inline operator-() const { //negating
                 Vector out(m_dimensions);
-                for (int i = 0; i < m_dimensions; ++i) {
-                    out[i] = -m_data[i];
-                }
+                forEach([&](int i) { out.m_data[i] = -m_data[i]; });
                 return out;
             }
             void inline operator-=(const Vector &other) {
                 assert(other.m_dimensions == m_dimensions); //Not same size vectors
-                for (int i = 0; i < m_dimensions; ++i) {
-                    m_data[i] = m_data[i] - other[i];
-                }
+                forEach([&](int i) { m_data[i] = m_data[i] - other.m_data[i]; });
             }
             Vector inline operator*(const Vector &other) const { //multiplying
                 assert(other.m_dimensions == m_dimensions); //Not same size vectors
                 Vector out(m_dimensions);
-                for (int i = 0; i < m_dimensions; ++i) {
-                    out[i] = m_data[i] * other[i];
-                }
+                zipKernel(other, out, kernels().multiply);
                 return out;
             }
             void inline operator*=(const Vector &other) {
                 assert(other.m_dimensions == m_dimensions); //Not same size vectors
-                for (int i = 0; i < m_dimensions; ++i) {
-                    m_data[i] = m_data[i] * other[i];
-                }
+                forEach([&](int i) { m_data[i] = m_data[i] * other.m_data[i]; });
             }
             Vector inline operator/(const Vector &other) const { //dividing
                 assert(other.m_dimensions == m_dimensions); //Not same size vectors
                 Vector out(m_dimensions);
-                for (int i = 0; i < m_dimensions; ++i) {
-                    out[i] = m_data[i] / other[i];
-                }
+                forEach([&](int i) { out.m_data[i] = m_data[i] / other.m_data[i]; });
                 return out;
             }
             void inline operator/=(const Vector &other) {
                 assert(other.m_dimensions == m_dimensions); //Not same size vectors
-                for (int i = 0; i < m_dimensions; ++i) {
-                    m_data[i] = m_data[i] / other[i];
-                }
+                forEach([&](int i) { m_data[i] = m_data[i] / other.m_data[i]; });
             }
             bool operator==(const Vector &other) const { //comparison
                 return equals(other);
@@ -225,26 +284,40 @@ namespace TensorMath {
 
 
         //UTILITIES
+            void randomFill(double min, double max, uint64_t seed) {
+                uniformFill(data(), m_dimensions, min, max, seed);
+            } //fill the vector with uniform values in [min, max), same seed gives the same values
+            void randomFill(double min, double max) {
+                randomFill(min, max, nextRandomSeed());
+            } //fill the vector with uniform values in [min, max), seeded from the global sequence(see setRandomSeed())
+            void randomNormalFill(double mean, double deviation, uint64_t seed) {
+                normalFill(data(), m_dimensions, mean, deviation, seed);
+            } //fill the vector with normally distributed values, same seed gives the same values
+            void randomNormalFill(double mean = 0, double deviation = 1) {
+                randomNormalFill(mean, deviation, nextRandomSeed());
+            } //fill the vector with normally distributed values, seeded from the global sequence
+            double lengthSquared() const {
+                TENSORMATH_TIME(Reduction);
+                TENSORMATH_COUNT_FLOPS(2 * (uint64_t) m_dimensions);
+                return TensorMath::dotProduct(m_data, m_data, m_dimensions); //x^2 + y^2 ... == ||v||^2
+            } //squared length of vector, cheaper than length() for comparisons
             double length() const {
-                double sum = 0; //sqrt(x^2 + y^2 ...) == ||v||
-                for (int i = 0; i < m_dimensions; ++i) { sum += std::pow(m_data[i], 2.0); }
-                return std::sqrt(sum);
+                return std::sqrt(lengthSquared()); //sqrt(x^2 + y^2 ...) == ||v||
             } //length of vector, the magnitude
             double dotProduct(const Vector &other) const {
                 assert(other.m_dimensions == m_dimensions); //Not same size vectors
-                double sum = 0; //x1*x2 + y1*y2...
-                for (int i = 0; i < m_dimensions; ++i) {
-                    sum += m_data[i] * other[i];
-                }
-                return sum;
+                TENSORMATH_TIME(Reduction);
+                TENSORMATH_COUNT_FLOPS(2 * (uint64_t) m_dimensions);
+                return TensorMath::dotProduct(m_data, other.m_data, m_dimensions); //x1*x2 + y1*y2...
             } //Get the dot product of two vectors. Combine two vectors into single value.
-            double distance(const Vector &other) const {
+            double distanceSquared(const Vector &other) const {
+                TENSORMATH_TIME(Reduction);
+                TENSORMATH_COUNT_FLOPS(3 * (uint64_t) m_dimensions);
                 assert(other.m_dimensions == m_dimensions); //Not same size vectors
-                double sum = 0; //sqrt((x2-x1)^2 + (y2-y1)^2...)
-                for (int i = 0; i < m_dimensions; ++i) {
-                    sum += std::pow(m_data[i] - other[i], 2.0);
-                }
-                return std::sqrt(sum);
+                return TensorMath::distanceSquared(m_data, other.m_data, m_dimensions); //(x2-x1)^2 + (y2-y1)^2...
+            } //get the squared distance between two vectors, cheaper than distance() for comparisons
+            double distance(const Vector &other) const {
+                return std::sqrt(distanceSquared(other)); //sqrt((x2-x1)^2 + (y2-y1)^2...)
             } //get the distance between two vectors.
 
             Vector inverse() const {
@@ -253,13 +326,27 @@ namespace TensorMath {
                 return one / *this;
             } //get 1.0/vector. Useful for ray tracing.
             Vector normalized() const {
-                return *this / length();  //(1/||v||) * v = unit v
+                return *this * (1.0 / length());  //(1/||v||) * v = unit v
             } //get the normalized(unit) vector. The direction of the vector.
+            Vector normalizedFast(Precision precision = Precision::Medium) const {
+                return *this * fastInverseSqrt(lengthSquared(), precision);
+            } //get the normalized vector using an approximate reciprocal square root. Not for zero length vectors.
+            void normalize() {
+                *this *= 1.0 / length();
+            } //normalize this vector in place
+            static void normalizeBatch(Vector *vectors, int count, Precision precision = Precision::Medium) {
+                for (int i = 0; i < count; ++i) {
+                    vectors[i] *= fastInverseSqrt(vectors[i].lengthSquared(), precision);
+                }
+            } //normalize many vectors in place with normalizedFast()
+            static void lengthSquaredBatch(const Vector *vectors, double *out, int count) {
+                for (int i = 0; i < count; ++i) { out[i] = vectors[i].lengthSquared(); }
+            } //squared lengths of many vectors
             Vector min(const Vector &other) const {
                 assert(other.m_dimensions == m_dimensions); //Not same size vectors
                 Vector out(m_dimensions); //vector to return
                 for (int i = 0; i < m_dimensions; ++i) {
-                    out[i] = std::fmin(m_data[i], other[i]);
+                    out.atUnchecked(i) = std::fmin(m_data[i], other.atUnchecked(i));
                 }
                 return out;
             } //get a new vector with the minimum components from both other vectors(Very useful for bounding boxes)
@@ -267,7 +354,7 @@ namespace TensorMath {
                 assert(other.m_dimensions == m_dimensions); //Not same size vectors
                 Vector out(m_dimensions); //vector to return
                 for (int i = 0; i < m_dimensions; ++i) {
-                    out[i] = std::max(m_data[i], other[i]);
+                    out.atUnchecked(i) = std::max(m_data[i], other.atUnchecked(i));
                 }
                 return out;
             } //get a new vector with the maximum components from both other vectors(Very useful for bounding boxes)
@@ -289,7 +376,7 @@ namespace TensorMath {
             Vector abs() const {
                 Vector out(m_dimensions);
                 for (int i = 0; i < m_dimensions; ++i) {
-                    out[i] = std::abs(m_data[i]);
+                    out.atUnchecked(i) = std::abs(m_data[i]);
                 }
                 return out;
             } //absolute value
@@ -300,7 +387,11 @@ namespace TensorMath {
             } //standard output overload
             std::string toString() const {
                 std::string out = "{";
-                for (int i = 0; i < m_dimensions; ++i) { out += " " + std::to_string(m_data[i]); }
+                out.reserve((size_t) m_dimensions * 12 + 2);
+                for (int i = 0; i < m_dimensions; ++i) {
+                    out += ' ';
+                    Text::appendFixed(out, m_data[i]);
+                }
                 return out + " }";
             }  //make vector into string
 
@@ -310,6 +401,21 @@ namespace TensorMath {
         inline static bool doubleEquals(double a, double b, double epsilon) {
             return (std::fabs(a - b) <= epsilon) || std::fabs(a - b) <= (epsilon * std::fmax(std::fabs(a), std::fabs(b)));
         } //helper function for comparing two floating point values: https://embeddeduse.com/2019/08/26/qt-compare-two-floats/
+        template<class Function>
+        void forEach(Function function) const {
+            TENSORMATH_TIME(Elementwise); //only used by the arithmetic operators, one operation per value
+            TENSORMATH_COUNT_FLOPS(m_dimensions);
+            parallelFor(m_dimensions, [&](size_t begin, size_t end) {
+                for (int i = (int) begin; i < (int) end; ++i) { function(i); }
+            });
+        } //call function(int i) for every index, split across threads for large vectors
+        void zipKernel(const Vector &other, Vector &out, void (*kernel)(const double *, const double *, double *, int)) const {
+            TENSORMATH_TIME(Elementwise);
+            TENSORMATH_COUNT_FLOPS(m_dimensions);
+            parallelFor(m_dimensions, [&](size_t begin, size_t end) {
+                kernel(m_data + begin, other.m_data + begin, out.m_data + begin, (int) (end - begin));
+            });
+        } //out = kernel(this, other), split across threads for large vectors
 
     };
 
@@ -0,0 +1,578 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_VIEW_HPP
+#define TENSORMATH_VIEW_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+#include "Vector.hpp"
+#include "FixedVector.hpp"
+
+namespace TensorMath {
+
+    //random access iterator over values stride doubles apart, what vector views iterate with
+    //T is double, or const double for read only views
+    template<class T>
+    class StridedIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = double;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T *;
+        using reference = T &;
+
+        //CONSTRUCTORS
+            StridedIterator() = default;
+            StridedIterator(T *data, int stride, difference_type index) : m_data(data), m_stride(stride), m_index(index) {
+            } //iterator at value index of a view
+
+        //OPERATORS
+            T &operator*() const { return m_data[m_index * m_stride]; }
+            T *operator->() const { return &**this; }
+            T &operator[](difference_type n) const { return m_data[(m_index + n) * m_stride]; }
+            StridedIterator &operator++() { ++m_index; return *this; }
+            StridedIterator operator++(int) { StridedIterator old = *this; ++m_index; return old; }
+            StridedIterator &operator--() { --m_index; return *this; }
+            StridedIterator operator--(int) { StridedIterator old = *this; --m_index; return old; }
+            StridedIterator &operator+=(difference_type n) { m_index += n; return *this; }
+            StridedIterator &operator-=(difference_type n) { m_index -= n; return *this; }
+            StridedIterator operator+(difference_type n) const { return StridedIterator(m_data, m_stride, m_index + n); }
+            friend StridedIterator operator+(difference_type n, const StridedIterator &i) { return i + n; }
+            StridedIterator operator-(difference_type n) const { return StridedIterator(m_data, m_stride, m_index - n); }
+            difference_type operator-(const StridedIterator &other) const { return m_index - other.m_index; }
+            bool operator==(const StridedIterator &other) const { return m_index == other.m_index; }
+            bool operator!=(const StridedIterator &other) const { return m_index != other.m_index; }
+            bool operator<(const StridedIterator &other) const { return m_index < other.m_index; }
+            bool operator>(const StridedIterator &other) const { return m_index > other.m_index; }
+            bool operator<=(const StridedIterator &other) const { return m_index <= other.m_index; }
+            bool operator>=(const StridedIterator &other) const { return m_index >= other.m_index; }
+
+    private:
+        T *m_data = nullptr; //first value of the view
+        int m_stride = 1;
+        difference_type m_index = 0; //position in the view, so any stride(even 0) works
+    };
+
+
+    //non-owning window over doubles owned by something else(a Vector, a Matrix column, a buffer from another library)
+    //values are stride doubles apart, so a row of a column major matrix can be viewed without copying
+    //T is double for a writable view, or const double for a read only view(ConstVectorView)
+    //a view never allocates or frees, the memory must outlive the view
+    //assigning to a view copies values into the viewed memory, it does not change what the view looks at
+    //Contains assertions for things like mismatched vector sizes(Make sure define NDEBUG for max performance)
+    template<class T>
+    class BasicVectorView {
+    public:
+        //CONSTRUCTORS
+            BasicVectorView(T *data, int dimensions, int stride = 1) : m_data(data), m_dimensions(dimensions),
+                                                                      m_stride(stride) {
+                assert(dimensions >= 0); //too small dimensions
+            } //view dimensions values starting at data, stride values apart
+            BasicVectorView(Vector &vector) : BasicVectorView(vector.data(), vector.getDim()) {
+            } //view a whole vector
+            BasicVectorView(const Vector &vector) : BasicVectorView(vector.data(), vector.getDim()) {
+            } //view a whole vector(only for read only views)
+            template<int dimensions>
+            BasicVectorView(FixedVector<dimensions> &vector) : BasicVectorView(vector.data(), dimensions) {
+            } //view a fixed vector
+            template<int dimensions>
+            BasicVectorView(const FixedVector<dimensions> &vector) : BasicVectorView(vector.data(), dimensions) {
+            } //view a fixed vector(only for read only views)
+            BasicVectorView(const BasicVectorView &other) = default; //copy the view, not the values
+            template<class U>
+            BasicVectorView(const BasicVectorView<U> &other) : BasicVectorView(other.data(), other.getDim(),
+                                                                               other.getStride()) {
+            } //writable view to read only view
+
+        //SETTER AND GETTERS
+            double getValue(int i) const {
+                TENSORMATH_CHECK_INDEX(i, m_dimensions); //index out of vector range
+                return m_data[(long long) i * m_stride];
+            } //get a value, checked by the bounds policy(see Bounds.hpp)
+            T &at(int i) const {
+                Bounds::check(i, m_dimensions);
+                return m_data[(long long) i * m_stride];
+            } //get or set a value, throws std::out_of_range for a bad index
+            T &atUnchecked(int i) const {
+                return m_data[(long long) i * m_stride];
+            } //get or set a value without any check, for hot loops
+            int getDim() const { return m_dimensions; } //get num dimensions
+            int getStride() const { return m_stride; } //get distance between values
+            T *data() const { return m_data; } //get the first value
+            bool isContiguous() const { return m_stride == 1; } //check if values are next to each other
+            StridedIterator<T> begin() const {
+                return StridedIterator<T>(m_data, m_stride, 0);
+            } //first value, for range for and standard algorithms
+            StridedIterator<T> end() const {
+                return StridedIterator<T>(m_data, m_stride, m_dimensions);
+            } //past the last value
+            size_t size() const { return (size_t) m_dimensions; } //number of values
+            void setScalar(double scalar) const {
+                for (int i = 0; i < m_dimensions; ++i) { atUnchecked(i) = scalar; }
+            } //set all viewed values to a scalar
+            Vector toVector() const {
+                Vector out(m_dimensions);
+                TENSORMATH_COUNT_COPY(m_dimensions * sizeof(double));
+                for (int i = 0; i < m_dimensions; ++i) { out.atUnchecked(i) = atUnchecked(i); }
+                return out;
+            } //copy the viewed values into a new vector
+            explicit operator Vector() const { return toVector(); } //copy into a vector, only when asked for
+
+        //COMPARISON
+            bool equals(const BasicVectorView<const double> &other,
+                        double epsilon = std::numeric_limits<double>::epsilon() * 10) const {
+                if (other.getDim() != m_dimensions) { return false; } //not same size
+                for (int i = 0; i < m_dimensions; ++i) {
+                    if (!doubleEquals(atUnchecked(i), other.atUnchecked(i), epsilon)) { return false; }
+                }
+                return true;
+            } //compare viewed values in place, using epsilon for reliability
+            bool operator==(const BasicVectorView<const double> &other) const { return equals(other); } //comparison
+            bool operator!=(const BasicVectorView<const double> &other) const { return !equals(other); } //comparison
+
+        //OPERATORS
+            //Getting and setting values
+            T &operator[](int i) const {
+                TENSORMATH_CHECK_INDEX(i, m_dimensions); //index out of vector range
+                return m_data[(long long) i * m_stride];
+            } //getting and setting with brackets
+            BasicVectorView &operator=(double scalar) {
+                setScalar(scalar);
+                return *this;
+            } //set all viewed values to a scalar
+            BasicVectorView &operator=(const BasicVectorView &other) {
+                copyFrom(other);
+                return *this;
+            } //copy values from another view of the same size
+            template<class U>
+            BasicVectorView &operator=(const BasicVectorView<U> &other) {
+                copyFrom(other);
+                return *this;
+            } //copy values from another view of the same size
+            BasicVectorView &operator=(const Vector &other) {
+                copyFrom(BasicVectorView<const double>(other));
+                return *this;
+            } //copy values from a vector of the same size
+            //Scalar operations, in place on the viewed memory
+            void operator+=(double scalar) const { for (int i = 0; i < m_dimensions; ++i) { atUnchecked(i) += scalar; }}
+            void operator-=(double scalar) const { for (int i = 0; i < m_dimensions; ++i) { atUnchecked(i) -= scalar; }}
+            void operator*=(double scalar) const { for (int i = 0; i < m_dimensions; ++i) { atUnchecked(i) *= scalar; }}
+            void operator/=(double scalar) const { for (int i = 0; i < m_dimensions; ++i) { atUnchecked(i) /= scalar; }}
+            //Vector operations, in place on the viewed memory
+            void operator+=(const BasicVectorView<const double> &other) const {
+                assert(other.getDim() == m_dimensions); //Not same size vectors
+                for (int i = 0; i < m_dimensions; ++i) { atUnchecked(i) += other.atUnchecked(i); }
+            }
+            void operator-=(const BasicVectorView<const double> &other) const {
+                assert(other.getDim() == m_dimensions); //Not same size vectors
+                for (int i = 0; i < m_dimensions; ++i) { atUnchecked(i) -= other.atUnchecked(i); }
+            }
+            void operator*=(const BasicVectorView<const double> &other) const {
+                assert(other.getDim() == m_dimensions); //Not same size vectors
+                for (int i = 0; i < m_dimensions; ++i) { atUnchecked(i) *= other.atUnchecked(i); }
+            }
+            void operator/=(const BasicVectorView<const double> &other) const {
+                assert(other.getDim() == m_dimensions); //Not same size vectors
+                for (int i = 0; i < m_dimensions; ++i) { atUnchecked(i) /= other.atUnchecked(i); }
+            }
+            //Operations into a new vector
+            Vector operator+(double scalar) const { return toVector() + scalar; }
+            Vector operator-(double scalar) const { return toVector() - scalar; }
+            Vector operator*(double scalar) const { return toVector() * scalar; }
+            Vector operator/(double scalar) const { return toVector() / scalar; }
+            Vector operator+(const BasicVectorView<const double> &other) const {
+                return zip(other, [](double a, double b) { return a + b; }, kernels().add);
+            }
+            Vector operator-(const BasicVectorView<const double> &other) const {
+                return zip(other, [](double a, double b) { return a - b; }, kernels().subtract);
+            }
+            Vector operator*(const BasicVectorView<const double> &other) const {
+                return zip(other, [](double a, double b) { return a * b; }, kernels().multiply);
+            }
+            Vector operator/(const BasicVectorView<const double> &other) const {
+                return zip(other, [](double a, double b) { return a / b; }, nullptr);
+            }
+
+        //REDUCTIONS
+            double sum() const {
+                double out = 0;
+                for (int i = 0; i < m_dimensions; ++i) { out += atUnchecked(i); }
+                return out;
+            } //sum of all values
+            double dotProduct(const BasicVectorView<const double> &other) const {
+                assert(other.getDim() == m_dimensions); //Not same size vectors
+                TENSORMATH_TIME(Reduction);
+                TENSORMATH_COUNT_FLOPS(2 * (uint64_t) m_dimensions);
+                if (isContiguous() && other.isContiguous()) { return TensorMath::dotProduct(m_data, other.data(), m_dimensions); }
+                double out = 0;
+                for (int i = 0; i < m_dimensions; ++i) { out = multiplyAdd(atUnchecked(i), other.atUnchecked(i), out); }
+                return out;
+            } //Get the dot product of two vectors
+            double lengthSquared() const { return dotProduct(*this); } //squared length of the viewed vector
+            double length() const { return std::sqrt(lengthSquared()); } //length of the viewed vector
+            double distanceSquared(const BasicVectorView<const double> &other) const {
+                assert(other.getDim() == m_dimensions); //Not same size vectors
+                if (isContiguous() && other.isContiguous()) { return TensorMath::distanceSquared(m_data, other.data(), m_dimensions); }
+                double out = 0;
+                for (int i = 0; i < m_dimensions; ++i) {
+                    double difference = atUnchecked(i) - other.atUnchecked(i);
+                    out = multiplyAdd(difference, difference, out);
+                }
+                return out;
+            } //get the squared distance between two vectors
+            double distance(const BasicVectorView<const double> &other) const {
+                return std::sqrt(distanceSquared(other));
+            } //get the distance between two vectors
+
+        //PRINTING
+            friend auto operator<<(std::ostream &os, BasicVectorView const &v) -> std::ostream & {
+                return os << v.toString();
+            } //standard output overload
+            std::string toString() const { return toVector().toString(); } //make view into string
+
+    private:
+        T *m_data; //first value, not owned
+        int m_dimensions; //how many values
+        int m_stride; //distance between values
+
+        inline static bool doubleEquals(double a, double b, double epsilon) {
+            return (std::fabs(a - b) <= epsilon) || std::fabs(a - b) <= (epsilon * std::fmax(std::fabs(a), std::fabs(b)));
+        } //same rule as Vector
+
+        template<class U>
+        void copyFrom(const BasicVectorView<U> &other) {
+            assert(other.getDim() == m_dimensions); //can not assign different dimensional vector
+            for (int i = 0; i < m_dimensions; ++i) { atUnchecked(i) = other.atUnchecked(i); }
+        } //copy values from another view
+
+        template<class Operation>
+        Vector zip(const BasicVectorView<const double> &other, Operation operation,
+                   void (*kernel)(const double *, const double *, double *, int)) const {
+            assert(other.getDim() == m_dimensions); //Not same size vectors
+            Vector out(m_dimensions);
+            if (kernel != nullptr && isContiguous() && other.isContiguous()) {
+                kernel(m_data, other.data(), out.data(), m_dimensions);
+                return out;
+            }
+            for (int i = 0; i < m_dimensions; ++i) { out.atUnchecked(i) = operation(atUnchecked(i), other.atUnchecked(i)); }
+            return out;
+        } //combine two views into a new vector, using a dispatched kernel when both are contiguous
+    };
+
+    //order values of a matrix are stored in
+    enum class Layout {
+        ColumnMajor, //one column after another, (x,y) is at x * height + y
+        RowMajor //one row after another, (x,y) is at y * width + x
+    };
+
+    template<class T>
+    class LineRange;
+
+    //non-owning window over a 2d grid of doubles
+    //value (x,y) is at data[x * column_stride + y * row_stride], so column major data, row major data, transposes
+    //and blocks of a bigger matrix can all be viewed without copying
+    //T is double for a writable view, or const double for a read only view(ConstMatrixView)
+    //assigning to a view copies values into the viewed memory, it does not change what the view looks at
+    template<class T>
+    class BasicMatrixView {
+    public:
+        //CONSTRUCTORS
+            BasicMatrixView(T *data, int width, int height, int column_stride, int row_stride) :
+                    m_data(data), m_width(width), m_height(height), m_column_stride(column_stride),
+                    m_row_stride(row_stride) {
+                assert(width >= 0 && height >= 0); //too small dimensions
+            } //view width by height values, (x,y) is at data[x * column_stride + y * row_stride]
+            BasicMatrixView(const BasicMatrixView &other) = default; //copy the view, not the values
+            template<class U>
+            BasicMatrixView(const BasicMatrixView<U> &other) :
+                    BasicMatrixView(other.data(), other.getWidth(), other.getHeight(), other.getColumnStride(),
+                                    other.getRowStride()) {
+            } //writable view to read only view
+            static BasicMatrixView columnMajor(T *data, int width, int height) {
+                return BasicMatrixView(data, width, height, height, 1);
+            } //view a buffer that stores one column after another
+            static BasicMatrixView rowMajor(T *data, int width, int height) {
+                return BasicMatrixView(data, width, height, 1, width);
+            } //view a buffer that stores one row after another
+            static BasicMatrixView ofLayout(T *data, int width, int height, Layout layout) {
+                return layout == Layout::RowMajor ? rowMajor(data, width, height) : columnMajor(data, width, height);
+            } //view a packed buffer in either layout
+
+        //SETTERS AND GETTERS
+            double getValue(int x, int y) const {
+                TENSORMATH_CHECK_INDEX(x, m_width); //check if in bounds
+                TENSORMATH_CHECK_INDEX(y, m_height);
+                return m_data[index(x, y)];
+            } //get a double value at coordinates, checked by the bounds policy(see Bounds.hpp)
+            void setValue(int x, int y, double value) const {
+                TENSORMATH_CHECK_INDEX(x, m_width); //check if in bounds
+                TENSORMATH_CHECK_INDEX(y, m_height);
+                m_data[index(x, y)] = value;
+            } //set a double value at coordinates, checked by the bounds policy
+            T &at(int x, int y) const {
+                Bounds::check(x, m_width);
+                Bounds::check(y, m_height);
+                return m_data[index(x, y)];
+            } //get or set a value, throws std::out_of_range for bad coordinates
+            T &atUnchecked(int x, int y) const { return m_data[index(x, y)]; } //get or set a value without any check, for hot loops
+            int getWidth() const { return m_width; } //get matrix width
+            int getHeight() const { return m_height; } //get matrix height(# of rows)
+            int getColumnStride() const { return m_column_stride; } //distance between columns
+            int getRowStride() const { return m_row_stride; } //distance between rows
+            T *data() const { return m_data; } //get value (0,0)
+            bool isColumnMajor() const { return m_row_stride == 1; } //columns are contiguous
+            bool isRowMajor() const { return m_column_stride == 1; } //rows are contiguous
+            bool isContiguous() const {
+                return isColumnMajor() && (m_column_stride == m_height || m_width <= 1);
+            } //all values are one column major block with no gaps
+            BasicVectorView<T> column(int x) const {
+                TENSORMATH_CHECK_INDEX(x, m_width); //check bounds
+                return BasicVectorView<T>(m_data + (long long) x * m_column_stride, m_height, m_row_stride);
+            } //view a column
+            BasicVectorView<T> row(int y) const {
+                TENSORMATH_CHECK_INDEX(y, m_height); //check bounds
+                return BasicVectorView<T>(m_data + (long long) y * m_row_stride, m_width, m_column_stride);
+            } //view a row
+            BasicMatrixView block(int x, int y, int width, int height) const {
+                assert(x >= 0 && y >= 0 && x + width <= m_width && y + height <= m_height); //check bounds
+                return BasicMatrixView(m_data + index(x, y), width, height, m_column_stride, m_row_stride);
+            } //view a rectangle of this view
+            LineRange<T> columns() const { return LineRange<T>(*this); } //every column as a vector view, for range for
+            LineRange<T> rows() const { return LineRange<T>(transposed()); } //every row as a vector view, for range for
+            BasicMatrixView transposed() const {
+                return BasicMatrixView(m_data, m_height, m_width, m_row_stride, m_column_stride);
+            } //view with rows and columns swapped, nothing is moved
+            void setScalar(double scalar) const {
+                for (int x = 0; x < m_width; ++x) { column(x).setScalar(scalar); }
+            } //set all viewed values to a scalar
+
+        //COMPARISON
+            bool equals(const BasicMatrixView<const double> &other,
+                        double epsilon = std::numeric_limits<double>::epsilon() * 10) const {
+                if (m_width != other.getWidth() || m_height != other.getHeight()) { return false; } //different dimensions
+                for (int x = 0; x < m_width; ++x) {
+                    if (!column(x).equals(other.column(x), epsilon)) { return false; }
+                }
+                return true;
+            } //compare two matrices based on an epsilon for floating point values
+            bool operator==(const BasicMatrixView<const double> &other) const { return equals(other); } //equality operator
+            bool operator!=(const BasicMatrixView<const double> &other) const { return !equals(other); } //inequality operator
+
+        //OPERATORS
+            BasicVectorView<T> operator[](int x) const { return column(x); } //allows view[x][y] to work
+            BasicMatrixView &operator=(double scalar) {
+                setScalar(scalar);
+                return *this;
+            } //set all viewed values to a scalar
+            BasicMatrixView &operator=(const BasicMatrixView &other) {
+                copyFrom(other);
+                return *this;
+            } //copy values from another view of the same size
+            template<class U>
+            BasicMatrixView &operator=(const BasicMatrixView<U> &other) {
+                copyFrom(other);
+                return *this;
+            } //copy values from another view of the same size
+            void operator+=(const BasicMatrixView<const double> &other) const {
+                assert(m_width == other.getWidth() && m_height == other.getHeight()); //must be same size
+                for (int x = 0; x < m_width; ++x) { column(x) += other.column(x); }
+            } //add in place
+            void operator-=(const BasicMatrixView<const double> &other) const {
+                assert(m_width == other.getWidth() && m_height == other.getHeight()); //must be same size
+                for (int x = 0; x < m_width; ++x) { column(x) -= other.column(x); }
+            } //subtract in place
+            void operator*=(double scalar) const {
+                for (int x = 0; x < m_width; ++x) { column(x) *= scalar; }
+            } //scale in place
+
+        //REDUCTIONS
+            double sum() const {
+                double out = 0;
+                for (int x = 0; x < m_width; ++x) { out += column(x).sum(); }
+                return out;
+            } //sum of all values
+
+        //PRINTING
+            std::string toString() const {
+                std::string out = "";
+                for (int y = 0; y < m_height; ++y) {
+                    out += "[ ";
+                    for (int x = 0; x < m_width; ++x) { out += std::to_string(atUnchecked(x, y)) + " "; }
+                    out += "]\n";
+                }
+                return out;
+            } //make view into string(contains newlines)
+            friend auto operator<<(std::ostream &os, BasicMatrixView const &m) -> std::ostream & { return os << m.toString(); } //standard output overload
+
+    private:
+        T *m_data; //value (0,0), not owned
+        int m_width;
+        int m_height;
+        int m_column_stride; //distance between (x,y) and (x+1,y)
+        int m_row_stride; //distance between (x,y) and (x,y+1)
+
+        long long index(int x, int y) const { return (long long) x * m_column_stride + (long long) y * m_row_stride; }
+
+        template<class U>
+        void copyFrom(const BasicMatrixView<U> &other) {
+            assert(m_width == other.getWidth() && m_height == other.getHeight()); //can not assign different size matrix
+            for (int x = 0; x < m_width; ++x) { column(x) = other.column(x); }
+        } //copy values from another view
+    };
+
+    //the columns of a matrix view(or the rows, as columns of the transpose), each as a vector view
+    //for range for and standard algorithms, the iterators hand out views by value
+    //a view is a proxy, not a reference to a stored line, so the iterators are input iterators(with random access arithmetic)
+    //ranges and iterators hold a pointer and strides, not a view, so assigning them rebinds instead of copying values
+    template<class T>
+    class LineRange {
+    public:
+        //iterator over the lines, hands out a new view at each line
+        class Iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = BasicVectorView<T>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = BasicVectorView<T>; //a new view, not a reference
+
+            Iterator() = default;
+            Iterator(const LineRange &range, int index) : m_range(range), m_index(index) {} //iterator at a line
+            BasicVectorView<T> operator*() const { return m_range[m_index]; }
+            BasicVectorView<T> operator[](difference_type n) const { return m_range[m_index + (int) n]; }
+            Iterator &operator++() { ++m_index; return *this; }
+            Iterator operator++(int) { Iterator old = *this; ++m_index; return old; }
+            Iterator &operator--() { --m_index; return *this; }
+            Iterator operator--(int) { Iterator old = *this; --m_index; return old; }
+            Iterator &operator+=(difference_type n) { m_index += (int) n; return *this; }
+            Iterator &operator-=(difference_type n) { m_index -= (int) n; return *this; }
+            Iterator operator+(difference_type n) const { return Iterator(m_range, m_index + (int) n); }
+            friend Iterator operator+(difference_type n, const Iterator &i) { return i + n; }
+            Iterator operator-(difference_type n) const { return Iterator(m_range, m_index - (int) n); }
+            difference_type operator-(const Iterator &other) const { return m_index - other.m_index; }
+            bool operator==(const Iterator &other) const { return m_index == other.m_index; }
+            bool operator!=(const Iterator &other) const { return m_index != other.m_index; }
+            bool operator<(const Iterator &other) const { return m_index < other.m_index; }
+            bool operator>(const Iterator &other) const { return m_index > other.m_index; }
+            bool operator<=(const Iterator &other) const { return m_index <= other.m_index; }
+            bool operator>=(const Iterator &other) const { return m_index >= other.m_index; }
+
+        private:
+            LineRange m_range; //plain values, copied and assigned freely
+            int m_index = 0; //line of the range
+        };
+
+        LineRange() = default;
+        explicit LineRange(const BasicMatrixView<T> &view) :
+                m_data(view.data()), m_count(view.getWidth()), m_length(view.getHeight()),
+                m_line_stride(view.getColumnStride()), m_stride(view.getRowStride()) {
+        } //the columns of view
+        Iterator begin() const { return Iterator(*this, 0); } //first line
+        Iterator end() const { return Iterator(*this, m_count); } //past the last line
+        size_t size() const { return (size_t) m_count; } //number of lines
+        BasicVectorView<T> operator[](int i) const {
+            TENSORMATH_CHECK_INDEX(i, m_count); //check bounds
+            return BasicVectorView<T>(m_data + (long long) i * m_line_stride, m_length, m_stride);
+        } //a line
+
+    private:
+        T *m_data = nullptr; //first value of the first line, not owned
+        int m_count = 0; //number of lines
+        int m_length = 0; //values in a line
+        int m_line_stride = 0; //distance between lines
+        int m_stride = 1; //distance between values of a line
+    };
+
+    //helper names
+    typedef BasicVectorView<double> VectorView; //writable vector view
+    typedef BasicVectorView<const double> ConstVectorView; //read only vector view
+    typedef BasicMatrixView<double> MatrixView; //writable matrix view
+    typedef BasicMatrixView<const double> ConstMatrixView; //read only matrix view
+
+    //VECTORS WITH VIEWS(the view is read in place, never copied into a temporary Vector)
+    inline Vector operator+(const Vector &a, const ConstVectorView &b) { return ConstVectorView(a) + b; } //a + b
+    inline Vector operator-(const Vector &a, const ConstVectorView &b) { return ConstVectorView(a) - b; } //a - b
+    inline Vector operator*(const Vector &a, const ConstVectorView &b) { return ConstVectorView(a) * b; } //component wise
+    inline Vector operator/(const Vector &a, const ConstVectorView &b) { return ConstVectorView(a) / b; } //component wise
+    inline void operator+=(Vector &a, const ConstVectorView &b) { VectorView(a) += b; } //add in place
+    inline void operator-=(Vector &a, const ConstVectorView &b) { VectorView(a) -= b; } //subtract in place
+    inline void operator*=(Vector &a, const ConstVectorView &b) { VectorView(a) *= b; } //multiply in place
+    inline void operator/=(Vector &a, const ConstVectorView &b) { VectorView(a) /= b; } //divide in place
+    inline double dotProduct(const ConstVectorView &a, const ConstVectorView &b) {
+        return a.dotProduct(b);
+    } //dot product of any mix of vectors, fixed vectors and views
+
+    //OPERATIONS INTO A DESTINATION(no allocation when all views are column major, or all are row major)
+    template<class Operation>
+    inline void zip(const ConstMatrixView &a, const ConstMatrixView &b, MatrixView out,
+                    void (*kernel)(const double *, const double *, double *, int), Operation operation) {
+        assert(a.getWidth() == b.getWidth() && a.getHeight() == b.getHeight()); //must be same size
+        assert(out.getWidth() == a.getWidth() && out.getHeight() == a.getHeight()); //output must be same size
+        TENSORMATH_TIME(Elementwise);
+        bool column_major = a.isColumnMajor() && b.isColumnMajor() && out.isColumnMajor();
+        if (!column_major && a.isRowMajor() && b.isRowMajor() && out.isRowMajor()) {
+            zip(a.transposed(), b.transposed(), out.transposed(), kernel, operation); //rows become contiguous columns
+            return;
+        }
+        TENSORMATH_COUNT_FLOPS((uint64_t) a.getWidth() * a.getHeight());
+        if (a.isContiguous() && b.isContiguous() && out.isContiguous()) { //one flat array, split across threads
+            parallelFor((size_t) a.getWidth() * a.getHeight(), [&](size_t begin, size_t end) {
+                kernel(a.data() + begin, b.data() + begin, out.data() + begin, (int) (end - begin));
+            });
+            return;
+        }
+        for (int x = 0; x < a.getWidth(); ++x) {
+            if (column_major) {
+                kernel(a.column(x).data(), b.column(x).data(), out.column(x).data(), a.getHeight());
+            } else {
+                for (int y = 0; y < a.getHeight(); ++y) { out.atUnchecked(x, y) = operation(a.atUnchecked(x, y), b.atUnchecked(x, y)); }
+            }
+        }
+    } //out = operation(a, b) for every value, using kernel on contiguous columns or rows
+
+    inline void add(const ConstMatrixView &a, const ConstMatrixView &b, MatrixView out) {
+        zip(a, b, out, kernels().add, [](double a_value, double b_value) { return a_value + b_value; });
+    } //out = a + b
+
+    inline void subtract(const ConstMatrixView &a, const ConstMatrixView &b, MatrixView out) {
+        zip(a, b, out, kernels().subtract, [](double a_value, double b_value) { return a_value - b_value; });
+    } //out = a - b
+
+    inline ConstMatrixView packColumnMajor(const ConstMatrixView &view, std::vector<double> &storage) {
+        if (view.isColumnMajor()) { return view; }
+        storage.resize((size_t) view.getWidth() * view.getHeight());
+        MatrixView::columnMajor(storage.data(), view.getWidth(), view.getHeight()) = view;
+        return ConstMatrixView::columnMajor(storage.data(), view.getWidth(), view.getHeight());
+    } //get a column major version of a view, copying into storage only when needed
+
+    inline void multiply(const ConstMatrixView &a, const ConstMatrixView &b, MatrixView out) {
+        assert(a.getWidth() == b.getHeight()); //number of columns in a must be equal to # of rows in b
+        assert(out.getWidth() == b.getWidth() && out.getHeight() == a.getHeight()); //output must be result size
+        TENSORMATH_TIME(Multiply);
+        bool column_major = a.isColumnMajor() && b.isColumnMajor() && out.isColumnMajor();
+        if (!column_major && a.isRowMajor() && b.isRowMajor() && out.isRowMajor()) {
+            //row major data is the column major data of the transpose, and (a * b)^T = b^T * a^T
+            multiply(b.transposed(), a.transposed(), out.transposed());
+            return;
+        }
+        TENSORMATH_COUNT_FLOPS(2 * (uint64_t) a.getHeight() * b.getWidth() * a.getWidth());
+        TENSORMATH_TRACE_SCOPE("multiply", a.getHeight(), b.getWidth(), a.getWidth(),
+                               2 * (uint64_t) a.getHeight() * b.getWidth() * a.getWidth());
+        //mixed layouts pack the odd ones out column major
+        std::vector<double> a_storage, b_storage, out_storage;
+        ConstMatrixView a_packed = packColumnMajor(a, a_storage);
+        ConstMatrixView b_packed = packColumnMajor(b, b_storage);
+        if (!out.isColumnMajor()) { out_storage.resize((size_t) out.getWidth() * out.getHeight()); }
+        MatrixView out_packed = out.isColumnMajor() ? out : MatrixView::columnMajor(out_storage.data(), out.getWidth(),
+                                                                                       out.getHeight());
+        kernels().gemm(a.getHeight(), b.getWidth(), a.getWidth(), a_packed.data(), a_packed.getColumnStride(),
+                       b_packed.data(), b_packed.getColumnStride(), out_packed.data(), out_packed.getColumnStride());
+        if (!out.isColumnMajor()) { out = out_packed; }
+    } //out = a * b. out must not overlap a or b.
+
+}
+
+#endif //TENSORMATH_VIEW_HPP
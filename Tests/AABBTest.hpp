@@ -0,0 +1,102 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_AABBTEST_HPP
+#define TENSORMATH_AABBTEST_HPP
+
+#include "../TensorMath/AABB.hpp"
+#include "gtest/gtest.h"
+
+//tests for bounding boxes and rays
+using namespace TensorMath;
+
+TEST(AABBTest, box_utils){
+    AABB3 box; //empty box
+    EXPECT_TRUE(box.isEmpty());
+    EXPECT_DOUBLE_EQ(box.surfaceArea(), 0);
+    //expand with points
+    box.expand(Vector3(0,0,0));
+    box.expand(Vector3(1,2,3));
+    EXPECT_FALSE(box.isEmpty());
+    EXPECT_EQ(box, AABB3(Vector3(0,0,0),Vector3(1,2,3)));
+    EXPECT_EQ(box.center(), Vector3(0.5,1,1.5));
+    EXPECT_EQ(box.longestAxis(), 2);
+    EXPECT_DOUBLE_EQ(box.volume(), 6);
+    EXPECT_DOUBLE_EQ(box.surfaceArea(), 22); //2(1*2 + 2*3 + 1*3)
+    //contains and overlaps
+    EXPECT_TRUE(box.contains(Vector3(0.5,0.5,0.5)));
+    EXPECT_FALSE(box.contains(Vector3(-0.5,0.5,0.5)));
+    AABB3 other(Vector3(0.5,0.5,0.5),Vector3(4,4,4));
+    EXPECT_TRUE(box.overlaps(other));
+    EXPECT_FALSE(box.overlaps(AABB3(Vector3(2,2,4),Vector3(3,3,5))));
+    EXPECT_EQ(box.merged(other), AABB3(Vector3(0,0,0),Vector3(4,4,4)));
+    //2d box
+    AABB2 flat(Vector2{0,0},Vector2{2,3});
+    EXPECT_DOUBLE_EQ(flat.surfaceArea(), 10); //perimeter
+}
+
+TEST(AABBTest, ray_box){
+    AABB3 box(Vector3(-1,-1,-1),Vector3(1,1,1));
+    double t = 0;
+    //straight hit
+    EXPECT_TRUE(box.intersect(Ray(Vector3(0,0,-5),Vector3(0,0,1)), t));
+    EXPECT_DOUBLE_EQ(t, 4);
+    //miss
+    EXPECT_FALSE(box.intersect(Ray(Vector3(0,3,-5),Vector3(0,0,1)), t));
+    //pointing away
+    EXPECT_FALSE(box.intersect(Ray(Vector3(0,0,-5),Vector3(0,0,-1)), t));
+    //too far
+    EXPECT_FALSE(box.intersect(Ray(Vector3(0,0,-5),Vector3(0,0,1)), t, 0, 3));
+    //starting inside
+    EXPECT_TRUE(box.intersect(Ray(Vector3(0,0,0),Vector3(1,1,0)), t));
+    EXPECT_DOUBLE_EQ(t, 0);
+    //grazing an edge with a zero direction component
+    EXPECT_TRUE(box.intersect(Ray(Vector3(1,0,-5),Vector3(0,0,1)), t));
+}
+
+TEST(AABBTest, ray_packet){
+    AABB3 box(Vector3(-1,-1,-1),Vector3(1,1,1));
+    Ray rays[4] = {Ray(Vector3(0,0,-5),Vector3(0,0,1)), //hit
+                   Ray(Vector3(0,3,-5),Vector3(0,0,1)), //miss
+                   Ray(Vector3(-5,0.5,0),Vector3(1,0,0)), //hit
+                   Ray(Vector3(0,0,-5),Vector3(0,0,-1))}; //away
+    RayPacket4 packet(rays);
+    double t_near[4];
+    int mask = box.intersect(packet, t_near);
+    EXPECT_EQ(mask, 0b0101);
+    EXPECT_DOUBLE_EQ(t_near[0], 4);
+    EXPECT_DOUBLE_EQ(t_near[2], 4);
+    //packet must agree with the single ray test
+    for (int i = 0; i < 4; ++i) {
+        double t = 0;
+        EXPECT_EQ(box.intersect(packet.getRay(i), t), (bool)(mask & (1 << i)));
+    }
+}
+
+TEST(AABBTest, ray_triangle){
+    Vector3 v0(-1,-1,0);
+    Vector3 v1(1,-1,0);
+    Vector3 v2(0,1,0);
+    double t, u, v;
+    //single ray
+    EXPECT_TRUE(Ray(Vector3(0,0,-2),Vector3(0,0,1)).intersectTriangle(v0,v1,v2,t,u,v));
+    EXPECT_DOUBLE_EQ(t, 2);
+    EXPECT_FALSE(Ray(Vector3(2,2,-2),Vector3(0,0,1)).intersectTriangle(v0,v1,v2,t,u,v)); //outside
+    EXPECT_FALSE(Ray(Vector3(0,0,-2),Vector3(1,0,0)).intersectTriangle(v0,v1,v2,t,u,v)); //parallel
+    //packet
+    Ray rays[4] = {Ray(Vector3(0,0,-2),Vector3(0,0,1)),
+                   Ray(Vector3(2,2,-2),Vector3(0,0,1)),
+                   Ray(Vector3(0,0,-2),Vector3(1,0,0)),
+                   Ray(Vector3(0,-0.5,3),Vector3(0,0,-1))};
+    RayPacket4 packet(rays);
+    EXPECT_EQ(packet.intersectTriangle(v0,v1,v2), 0b1001);
+    EXPECT_DOUBLE_EQ(packet.t_max[0], 2);
+    EXPECT_DOUBLE_EQ(packet.t_max[3], 3);
+    //only closer hits replace the current hit
+    EXPECT_EQ(packet.intersectTriangle(v0 + Vector3(0,0,1),v1 + Vector3(0,0,1),v2 + Vector3(0,0,1)), 0b1000);
+    EXPECT_DOUBLE_EQ(packet.t_max[0], 2);
+    EXPECT_DOUBLE_EQ(packet.t_max[3], 2);
+}
+
+#endif //TENSORMATH_AABBTEST_HPP
@@ -0,0 +1,96 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_AUTODIFFTEST_HPP
+#define TENSORMATH_AUTODIFFTEST_HPP
+
+#include "../TensorMath/Autodiff.hpp"
+#include "gtest/gtest.h"
+
+//tests for reverse mode differentiation, compared against finite differences
+using namespace TensorMath;
+
+//small two layer model with every operation, as a function of its parameters
+static Variable autodiffTestModel(Tape &tape, const Matrix &weights, const Vector &bias, const Matrix &data,
+                                  Variable &weights_out, Variable &bias_out, Variable &data_out){
+    weights_out = tape.input(weights);
+    bias_out = tape.input(bias);
+    data_out = tape.input(data);
+    Variable hidden = tanh(addBias(weights_out * data_out, bias_out));
+    Variable mixed = sigmoid(hidden) + relu(hidden) - hadamard(hidden, hidden) * 0.5;
+    Variable positive = exp(sin(mixed)) + sqrt(exp(cos(mixed)));
+    return sum(log(positive)) + mean(-positive);
+}
+
+TEST(AutodiffTest, gradients){
+    Matrix weights(3, 2);
+    weights.fillArray({0.5, -0.3, 0.8, 0.1, 0.7, -0.6});
+    Vector bias{0.1, -0.2};
+    Matrix data(4, 3);
+    data.fillArray({1, 2, -1, 0.5, 0.3, -0.7, 0.2, 1.1, -0.4, 0.9, 0.6, -1.2});
+    Tape tape;
+    Variable w{}, b{}, d{};
+    Variable loss = autodiffTestModel(tape, weights, bias, data, w, b, d);
+    tape.backward(loss);
+    //finite differences of every parameter
+    auto evaluate = [&](const Matrix &weights_value, const Vector &bias_value, const Matrix &data_value) {
+        Tape other;
+        Variable w_other{}, b_other{}, d_other{};
+        return other.scalar(autodiffTestModel(other, weights_value, bias_value, data_value, w_other, b_other, d_other));
+    };
+    double step = 1e-6;
+    for (int x = 0; x < 3; ++x) {
+        for (int y = 0; y < 2; ++y) {
+            Matrix plus = weights, minus = weights;
+            plus.setValue(x, y, weights.getValue(x, y) + step);
+            minus.setValue(x, y, weights.getValue(x, y) - step);
+            double slope = (evaluate(plus, bias, data) - evaluate(minus, bias, data)) / (2 * step);
+            EXPECT_NEAR(tape.gradient(w).getValue(x, y), slope, 1e-7);
+        }
+    }
+    for (int y = 0; y < 2; ++y) {
+        Vector plus = bias, minus = bias;
+        plus[y] += step;
+        minus[y] -= step;
+        double slope = (evaluate(weights, plus, data) - evaluate(weights, minus, data)) / (2 * step);
+        EXPECT_NEAR(tape.gradient(b).getValue(0, y), slope, 1e-7);
+    }
+    for (int x = 0; x < 4; ++x) {
+        for (int y = 0; y < 3; ++y) {
+            Matrix plus = data, minus = data;
+            plus.setValue(x, y, data.getValue(x, y) + step);
+            minus.setValue(x, y, data.getValue(x, y) - step);
+            double slope = (evaluate(weights, bias, plus) - evaluate(weights, bias, minus)) / (2 * step);
+            EXPECT_NEAR(tape.gradient(d).getValue(x, y), slope, 1e-7);
+        }
+    }
+}
+
+TEST(AutodiffTest, reuse){
+    //gradient descent on a linear fit, the tape stops growing after the first step
+    Matrix data(8, 2);
+    Matrix target(8, 1);
+    for (int x = 0; x < 8; ++x) {
+        data.setValue(x, 0, x * 0.25);
+        data.setValue(x, 1, 1);
+        target.setValue(x, 0, 3 * x * 0.25 - 1);
+    }
+    Matrix weights(2, 1);
+    Tape tape;
+    size_t arena_size = 0;
+    for (int step = 0; step < 500; ++step) {
+        tape.reset();
+        Variable w = tape.input(weights);
+        Variable error = w * tape.input(data) - tape.input(target);
+        Variable loss = mean(hadamard(error, error));
+        tape.backward(loss);
+        for (int x = 0; x < 2; ++x) { weights.setValue(x, 0, weights.getValue(x, 0) - 0.5 * tape.gradient(w).getValue(x, 0)); }
+        if (step == 0) { arena_size = tape.getArenaSize(); }
+        EXPECT_EQ(tape.getArenaSize(), arena_size);
+    }
+    EXPECT_NEAR(weights.getValue(0, 0), 3, 1e-6);
+    EXPECT_NEAR(weights.getValue(1, 0), -1, 1e-6);
+}
+
+#endif //TENSORMATH_AUTODIFFTEST_HPP
@@ -0,0 +1,113 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_BVHTEST_HPP
+#define TENSORMATH_BVHTEST_HPP
+
+#include "../TensorMath/BVH.hpp"
+#include "gtest/gtest.h"
+
+//tests for bounding volume hierarchy
+using namespace TensorMath;
+
+//random triangle soup for testing
+static std::vector<Vector3> bvhTestTriangles(int count){
+    srand(42);
+    std::vector<Vector3> vertices;
+    for (int i = 0; i < count; ++i) {
+        Vector3 center(rand() % 200 - 100, rand() % 200 - 100, rand() % 200 - 100);
+        for (int v = 0; v < 3; ++v) {
+            vertices.push_back(center + Vector3(rand() % 50 / 10.0, rand() % 50 / 10.0, rand() % 50 / 10.0));
+        }
+    }
+    return vertices;
+}
+
+TEST(BVHTest, structure){
+    std::vector<Vector3> vertices = bvhTestTriangles(1000);
+    std::vector<AABB3> boxes;
+    for (int i = 0; i < 1000; ++i) {
+        AABB3 box(vertices[i * 3]);
+        box.expand(vertices[i * 3 + 1]);
+        box.expand(vertices[i * 3 + 2]);
+        boxes.push_back(box);
+    }
+    BVH bvh(boxes);
+    //every primitive is in exactly one leaf, and inside that leaf's box
+    std::vector<int> seen(boxes.size(), 0);
+    for (const BVH::Node& node : bvh.getNodes()) {
+        if (!node.isLeaf()) { continue; }
+        for (int i = node.offset; i < node.offset + node.count; ++i) {
+            int primitive = bvh.getIndices()[i];
+            seen[primitive]++;
+            EXPECT_TRUE(node.bounds.merged(boxes[primitive]) == node.bounds);
+        }
+    }
+    for (int count : seen) { EXPECT_EQ(count, 1); }
+    EXPECT_GT(bvh.getDepth(), 1);
+    EXPECT_LT(bvh.getDepth(), 64);
+    //empty hierarchy
+    BVH empty(std::vector<AABB3>{});
+    EXPECT_EQ(empty.getNodeCount(), 0);
+}
+
+TEST(BVHTest, ray_queries){
+    const int count = 2000;
+    std::vector<Vector3> vertices = bvhTestTriangles(count);
+    std::vector<AABB3> boxes;
+    for (int i = 0; i < count; ++i) {
+        AABB3 box(vertices[i * 3]);
+        box.expand(vertices[i * 3 + 1]);
+        box.expand(vertices[i * 3 + 2]);
+        boxes.push_back(box);
+    }
+    BVH bvh(boxes);
+    auto intersect = [&](int primitive, const Ray& ray, double t_max, double& t){
+        double u, v;
+        return ray.intersectTriangle(vertices[primitive * 3], vertices[primitive * 3 + 1], vertices[primitive * 3 + 2], t, u, v, 0, t_max);
+    };
+    //compare against brute force
+    for (int r = 0; r < 200; ++r) {
+        Ray ray(Vector3(rand() % 100 - 50, rand() % 100 - 50, -200), Vector3(rand() % 10 / 100.0, rand() % 10 / 100.0, 1));
+        double expected_t = std::numeric_limits<double>::infinity();
+        int expected_primitive = -1;
+        for (int i = 0; i < count; ++i) {
+            double t;
+            if (intersect(i, ray, expected_t, t)) {
+                expected_t = t;
+                expected_primitive = i;
+            }
+        }
+        double t;
+        int primitive = -1;
+        bool hit = bvh.closestHit(ray, t, primitive, intersect);
+        EXPECT_EQ(hit, expected_primitive >= 0);
+        EXPECT_EQ(bvh.anyHit(ray, intersect), expected_primitive >= 0);
+        if (hit) {
+            EXPECT_EQ(primitive, expected_primitive);
+            EXPECT_DOUBLE_EQ(t, expected_t);
+            EXPECT_FALSE(bvh.anyHit(ray, intersect, expected_t * 0.999)); //nothing closer
+        }
+    }
+}
+
+TEST(BVHTest, overlap_query){
+    std::vector<AABB3> boxes;
+    for (int x = 0; x < 10; ++x) {
+        for (int y = 0; y < 10; ++y) {
+            boxes.emplace_back(Vector3(x, y, 0), Vector3(x + 0.5, y + 0.5, 0.5));
+        }
+    }
+    BVH bvh(boxes, 2);
+    AABB3 query(Vector3(2.2, 2.2, 0), Vector3(4.1, 3.1, 1));
+    std::vector<int> found;
+    bvh.overlapping(query, [&](int primitive){ found.push_back(primitive); });
+    std::vector<int> expected;
+    for (int i = 0; i < (int)boxes.size(); ++i) { if (boxes[i].overlaps(query)) { expected.push_back(i); } }
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found, expected);
+    EXPECT_EQ(found.size(), 6u); //x from 2 to 4, y from 2 to 3
+}
+
+#endif //TENSORMATH_BVHTEST_HPP
@@ -0,0 +1,50 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_BATCHTEST_HPP
+#define TENSORMATH_BATCHTEST_HPP
+
+#include "../TensorMath/Batch.hpp"
+#include "../TensorMath/Matrix.hpp"
+#include "gtest/gtest.h"
+
+//tests for batched matrix products, compared against one Matrix product at a time
+using namespace TensorMath;
+
+TEST(BatchTest, strided){
+    size_t old_threshold = getParallelThreshold();
+    setParallelThreshold(1); //split the batch across threads
+    for (int size : {5, 8, 16, 64}) { //general and specialized sizes
+        int m = size, n = size + 3, k = size - 1, count = 20;
+        std::vector<double> a((size_t) m * k * count), b((size_t) k * n * count), out((size_t) m * n * count);
+        for (size_t i = 0; i < a.size(); ++i) { a[i] = std::sin(i * 0.3); }
+        for (size_t i = 0; i < b.size(); ++i) { b[i] = std::cos(i * 0.7); }
+        multiplyBatch(m, n, k, a.data(), b.data(), out.data(), count);
+        for (int item = 0; item < count; ++item) {
+            Matrix expected = Matrix(ConstMatrixView::columnMajor(a.data() + (size_t) item * m * k, k, m)) *
+                              ConstMatrixView::columnMajor(b.data() + (size_t) item * k * n, n, k);
+            EXPECT_TRUE(expected.equals(ConstMatrixView::columnMajor(out.data() + (size_t) item * m * n, n, m), 0));
+        }
+    }
+    setParallelThreshold(old_threshold);
+}
+
+TEST(BatchTest, views){
+    //different sizes and layouts in one batch
+    Matrix a1(3, 8), b1(5, 3), a2(4, 4, Layout::RowMajor), b2(4, 4);
+    a1.fillArray({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24});
+    b1.fillArray({2, 0, 1, 3, 1, 1, 0, 2, 1, 1, 5, 4, 3, 2, 1});
+    a2.fillArray({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16});
+    b2.setIdentity();
+    b2.setValue(3, 0, 2);
+    Matrix out1(5, 8), out2(4, 4);
+    ConstMatrixView a[2] = {a1, a2};
+    ConstMatrixView b[2] = {b1, b2};
+    MatrixView out[2] = {out1, out2};
+    multiplyBatch(a, b, out, 2);
+    EXPECT_EQ(out1, a1 * b1);
+    EXPECT_EQ(out2, a2 * b2);
+}
+
+#endif //TENSORMATH_BATCHTEST_HPP
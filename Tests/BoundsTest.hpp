@@ -0,0 +1,72 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_BOUNDSTEST_HPP
+#define TENSORMATH_BOUNDSTEST_HPP
+
+#include <stdexcept>
+#include "../TensorMath/Matrix.hpp"
+#include "../TensorMath/FixedMatrix.hpp"
+#include "gtest/gtest.h"
+
+//tests for checked and unchecked access
+using namespace TensorMath;
+
+TEST(BoundsTest, at){
+    Vector vector{1, 2, 3};
+    EXPECT_EQ(vector.at(2), 3);
+    vector.at(0) = 5;
+    EXPECT_EQ(vector.atUnchecked(0), 5);
+    EXPECT_THROW(vector.at(3), std::out_of_range);
+    EXPECT_THROW(vector.at(-1), std::out_of_range); //negative indices too
+
+    Matrix matrix(3, 2, Layout::RowMajor);
+    matrix.at(2, 1) = 7;
+    EXPECT_EQ(matrix.getValue(2, 1), 7);
+    EXPECT_EQ(matrix.atUnchecked(2, 1), 7);
+    EXPECT_THROW(matrix.at(3, 0), std::out_of_range);
+    EXPECT_THROW(matrix.at(0, -1), std::out_of_range);
+
+    FixedVector<3> fixed(1, 2, 3);
+    fixed.atUnchecked(1) = 4;
+    EXPECT_EQ(fixed.at(1), 4);
+    EXPECT_THROW(fixed.at(-1), std::out_of_range);
+    FixedMatrix<2, 2> fixed_matrix;
+    fixed_matrix.at(1, 0) = 3;
+    EXPECT_EQ(fixed_matrix.getValue(1, 0), 3);
+    EXPECT_THROW(fixed_matrix.at(2, 0), std::out_of_range);
+
+    MatrixView view = matrix.view().block(1, 0, 2, 2);
+    EXPECT_EQ(view.at(1, 1), 7);
+    EXPECT_THROW(view.at(2, 1), std::out_of_range);
+    EXPECT_EQ(view.column(1).at(1), 7);
+    EXPECT_THROW(view.column(1).at(2), std::out_of_range);
+
+    try {
+        vector.at(4);
+        FAIL(); //must throw
+    } catch (const std::out_of_range &error) {
+        EXPECT_STREQ(error.what(), "TensorMath: index 4 is out of range [0, 3)");
+    }
+}
+
+TEST(BoundsTest, policy){
+    Vector vector(4);
+    EXPECT_THROW(vector.at(4), std::out_of_range); //at() throws under every policy
+    EXPECT_NO_THROW(vector.at(3));
+    EXPECT_FALSE(Bounds::inRange(-1, 4)); //what every checked accessor tests
+    EXPECT_FALSE(Bounds::inRange(4, 4));
+    EXPECT_TRUE(Bounds::inRange(0, 4));
+    if (TENSORMATH_BOUNDS == TENSORMATH_BOUNDS_THROW) { //checked accessors throw too
+        EXPECT_THROW(vector.getValue(4), std::out_of_range);
+        EXPECT_THROW(vector[-1], std::out_of_range);
+        Matrix matrix(2, 2);
+        EXPECT_THROW(matrix.setValue(0, 2, 1), std::out_of_range);
+        EXPECT_THROW(matrix[2], std::out_of_range);
+    }
+    vector[3] = 2; //in range is never affected
+    EXPECT_EQ(vector.getValue(3), 2);
+}
+
+#endif //TENSORMATH_BOUNDSTEST_HPP
@@ -0,0 +1,44 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_CHAINTEST_HPP
+#define TENSORMATH_CHAINTEST_HPP
+
+#include "../TensorMath/Chain.hpp"
+#include "gtest/gtest.h"
+
+//tests for chains of products, compared against left to right products
+using namespace TensorMath;
+
+TEST(ChainTest, plan){
+    Matrix a(100, 10), b(5, 100), c(50, 5);
+    ChainPlan plan = planChain({a, b, c});
+    EXPECT_EQ(plan.cost, 7500); //10x100 * 100x5 first, not 75000
+    EXPECT_EQ(plan.toString(), "((0 1) 2)");
+    plan = planChain({Matrix(35, 30), Matrix(15, 35), Matrix(5, 15), Matrix(10, 5), Matrix(20, 10), Matrix(25, 20)});
+    EXPECT_EQ(plan.cost, 15125); //textbook example(Cormen et al., 15.2)
+    EXPECT_EQ(plan.toString(), "((0 (1 2)) ((3 4) 5))");
+}
+
+TEST(ChainTest, multiply){
+    Matrix a(3, 40), b(60, 3, Layout::RowMajor), c(2, 60), d(70, 2), e(5, 70), f(8, 5);
+    a.randomFill(-1, 1, 1);
+    b.randomFill(-1, 1, 2);
+    c.randomFill(-1, 1, 3);
+    d.randomFill(-1, 1, 4);
+    e.randomFill(-1, 1, 5);
+    f.randomFill(-1, 1, 6);
+    Matrix expected = ((((a * b) * c) * d) * e) * f;
+    Matrix out = multiplyChain({a, b, c, d, e, f});
+    EXPECT_EQ(out.getWidth(), 8);
+    EXPECT_EQ(out.getHeight(), 40);
+    EXPECT_TRUE(out.equals(expected, 1e-9));
+    Matrix row_major(8, 40, Layout::RowMajor); //any output, views too
+    multiplyChain({a.view(), b, c, d, e, f}, row_major);
+    EXPECT_TRUE(row_major.equals(out, 0));
+    EXPECT_TRUE(multiplyChain({a, b}).equals(a * b, 0));
+    EXPECT_TRUE(multiplyChain({a}).equals(a, 0));
+}
+
+#endif //TENSORMATH_CHAINTEST_HPP
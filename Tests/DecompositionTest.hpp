@@ -0,0 +1,117 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_DECOMPOSITIONTEST_HPP
+#define TENSORMATH_DECOMPOSITIONTEST_HPP
+
+#include "../TensorMath/Decomposition.hpp"
+#include "gtest/gtest.h"
+
+//tests for eigen and singular value decompositions, checked by rebuilding the matrix
+using namespace TensorMath;
+
+//largest difference between a and vectors * diagonal(values) * other^T
+static double decompositionTestError(const ConstMatrixView &a, const ConstMatrixView &vectors, const ConstVectorView &values,
+                                     const ConstMatrixView &other){
+    double error = 0;
+    for (int x = 0; x < a.getWidth(); ++x) {
+        for (int y = 0; y < a.getHeight(); ++y) {
+            double sum = 0;
+            for (int i = 0; i < values.getDim(); ++i) { sum += vectors.getValue(i, y) * values[i] * other.getValue(i, x); }
+            error = std::max(error, std::abs(sum - a.getValue(x, y)));
+        }
+    }
+    return error;
+}
+
+//largest difference between columns^T * columns and the identity
+static double decompositionTestOrthogonality(const ConstMatrixView &columns){
+    Matrix product = columns.transposed() * columns;
+    double error = 0;
+    for (int x = 0; x < product.getWidth(); ++x) {
+        for (int y = 0; y < product.getHeight(); ++y) { error = std::max(error, std::abs(product.getValue(x, y) - (x == y))); }
+    }
+    return error;
+}
+
+TEST(DecompositionTest, symmetricEigen){
+    Matrix random(60, 60);
+    random.randomNormalFill(0, 1, 3);
+    Matrix a = random + random.transposed();
+    Eigensystem eigen = symmetricEigen(a);
+    EXPECT_TRUE(eigen.converged);
+    EXPECT_LT(decompositionTestError(a, eigen.vectors, eigen.values, eigen.vectors), 1e-12);
+    EXPECT_LT(decompositionTestOrthogonality(eigen.vectors), 1e-13);
+    for (int i = 1; i < 60; ++i) { EXPECT_LE(eigen.values[i - 1], eigen.values[i]); }
+    Matrix repeated(5, 5); //identity + ones: eigenvalues 1, 1, 1, 1, 6
+    for (int x = 0; x < 5; ++x) { for (int y = 0; y < 5; ++y) { repeated.setValue(x, y, x == y ? 2 : 1); } }
+    Eigensystem repeated_eigen = symmetricEigen(repeated);
+    EXPECT_NEAR(repeated_eigen.values[0], 1, 1e-14);
+    EXPECT_NEAR(repeated_eigen.values[3], 1, 1e-14);
+    EXPECT_NEAR(repeated_eigen.values[4], 6, 1e-14);
+    EXPECT_LT(decompositionTestOrthogonality(repeated_eigen.vectors), 1e-14);
+    Matrix lower = a; //the upper triangle is not read
+    lower.setValue(5, 0, 100);
+    EXPECT_TRUE(Matrix(symmetricEigen(lower).values).equals(Matrix(symmetricEigen(a).values), 0));
+}
+
+TEST(DecompositionTest, svd){
+    Matrix tall(25, 40, Layout::RowMajor);
+    tall.randomNormalFill(0, 1, 4);
+    SingularValueDecomposition decomposition = svd(tall);
+    EXPECT_TRUE(decomposition.converged);
+    EXPECT_EQ(decomposition.u.getWidth(), 25);
+    EXPECT_EQ(decomposition.u.getHeight(), 40);
+    EXPECT_LT(decompositionTestError(tall, decomposition.u, decomposition.values, decomposition.v), 1e-12);
+    EXPECT_LT(decompositionTestOrthogonality(decomposition.u), 1e-13);
+    EXPECT_LT(decompositionTestOrthogonality(decomposition.v), 1e-13);
+    for (int i = 1; i < 25; ++i) { EXPECT_GE(decomposition.values[i - 1], decomposition.values[i]); }
+    Eigensystem eigen = symmetricEigen(tall.transposed() * tall); //squares of the singular values
+    for (int i = 0; i < 25; ++i) { EXPECT_NEAR(eigen.values[24 - i], decomposition.values[i] * decomposition.values[i], 1e-10); }
+    Matrix wide(31, 7); //odd count, wider than high
+    wide.randomNormalFill(0, 1, 5);
+    SingularValueDecomposition wide_decomposition = svd(wide);
+    EXPECT_EQ(wide_decomposition.v.getHeight(), 31);
+    EXPECT_EQ(wide_decomposition.v.getWidth(), 7);
+    EXPECT_LT(decompositionTestError(wide, wide_decomposition.u, wide_decomposition.values, wide_decomposition.v), 1e-12);
+    EXPECT_LT(decompositionTestOrthogonality(wide_decomposition.v), 1e-13);
+    Matrix rank_one(4, 6); //zero singular values
+    for (int x = 0; x < 4; ++x) { for (int y = 0; y < 6; ++y) { rank_one.setValue(x, y, (x + 1) * (y - 2.5)); } }
+    SingularValueDecomposition rank_one_decomposition = svd(rank_one);
+    EXPECT_LT(decompositionTestError(rank_one, rank_one_decomposition.u, rank_one_decomposition.values,
+                                     rank_one_decomposition.v), 1e-12);
+    EXPECT_NEAR(rank_one_decomposition.values[1], 0, 1e-12);
+}
+
+TEST(DecompositionTest, fixed3x3){
+    Matrix random(3, 3);
+    FixedMatrix<3, 3> a;
+    FixedVector<3> values;
+    FixedMatrix<3, 3> vectors;
+    for (int seed = 0; seed < 100; ++seed) {
+        random.randomNormalFill(0, 1, seed);
+        Matrix symmetric = random + random.transposed();
+        for (int x = 0; x < 3; ++x) { for (int y = 0; y < 3; ++y) { a.setValue(x, y, symmetric.getValue(x, y)); } }
+        symmetricEigen(a, values, vectors);
+        Eigensystem expected = symmetricEigen(symmetric);
+        for (int i = 0; i < 3; ++i) { EXPECT_NEAR(values[i], expected.values[i], 1e-12); }
+        ConstMatrixView vector_view = ConstMatrixView::columnMajor(vectors.data(), 3, 3);
+        EXPECT_LT(decompositionTestError(symmetric, vector_view, ConstVectorView(values.data(), 3), vector_view), 1e-12);
+        EXPECT_LT(decompositionTestOrthogonality(vector_view), 1e-13);
+    }
+    double repeated[3][3] = {{3, 1, 1}, {1, 3, 1}, {1, 1, 3}}; //eigenvalues 2, 2, 5
+    for (int x = 0; x < 3; ++x) { for (int y = 0; y < 3; ++y) { a.setValue(x, y, repeated[x][y]); } }
+    symmetricEigen(a, values, vectors);
+    EXPECT_NEAR(values[0], 2, 1e-14);
+    EXPECT_NEAR(values[1], 2, 1e-14);
+    EXPECT_NEAR(values[2], 5, 1e-14);
+    EXPECT_LT(decompositionTestOrthogonality(ConstMatrixView::columnMajor(vectors.data(), 3, 3)), 1e-14);
+    a.setIdentity(); //diagonal and scalar
+    a.setValue(1, 1, -4);
+    symmetricEigen(a, values, vectors);
+    EXPECT_EQ(values[0], -4);
+    EXPECT_EQ(vectors.getValue(0, 1), 1);
+}
+
+#endif //TENSORMATH_DECOMPOSITIONTEST_HPP
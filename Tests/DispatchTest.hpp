@@ -0,0 +1,121 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_DISPATCHTEST_HPP
+#define TENSORMATH_DISPATCHTEST_HPP
+
+#include "../TensorMath/Dispatch.hpp"
+#include "../TensorMath/Matrix.hpp"
+#include "../TensorMath/FixedMatrix.hpp"
+#include "gtest/gtest.h"
+
+//tests for instruction set dispatch. Every path the cpu supports must give bit identical results to the generic path.
+using namespace TensorMath;
+
+//results of every kernel on one set of inputs
+static std::vector<double> dispatchTestRun(int size){
+    std::vector<double> a(size * size), b(size * size), out;
+    for (int i = 0; i < size * size; ++i) {
+        a[i] = std::sin(i * 0.37) * 10;
+        b[i] = std::cos(i * 0.11) + 0.5;
+    }
+    std::vector<double> result(size * size);
+    const KernelTable& table = kernels();
+    table.add(a.data(), b.data(), result.data(), size * size);
+    out.insert(out.end(), result.begin(), result.end());
+    table.subtract(a.data(), b.data(), result.data(), size * size);
+    out.insert(out.end(), result.begin(), result.end());
+    table.multiply(a.data(), b.data(), result.data(), size * size);
+    out.insert(out.end(), result.begin(), result.end());
+    table.scale(a.data(), 1.7, result.data(), size * size);
+    out.insert(out.end(), result.begin(), result.end());
+    out.push_back(table.dot(a.data(), b.data(), size * size));
+    table.gemv(a.data(), size, size, size, b.data(), result.data());
+    out.insert(out.end(), result.begin(), result.begin() + size);
+    table.gemm(size, size, size, a.data(), size, b.data(), size, result.data(), size);
+    out.insert(out.end(), result.begin(), result.end());
+    table.transform(a.data(), 1, size, b.data(), result.data(), size);
+    out.insert(out.end(), result.begin(), result.begin() + size);
+    for (int rows : {3, 4, 8, 16, 32, 64}) { //specialized and general batch kernels
+        if (rows > size) { continue; }
+        int items = size / rows;
+        table.gemmBatch(rows, rows, rows, a.data(), rows, rows, b.data(), rows, rows, result.data(), rows, rows * rows, items);
+        out.insert(out.end(), result.begin(), result.begin() + items * rows * rows);
+    }
+    std::vector<double> positive(size * size); //log and sqrt inputs, so results are never NaN(NaN payloads may differ)
+    for (int i = 0; i < size * size; ++i) { positive[i] = std::fabs(a[i]) * (i + 1); }
+    for (auto kernel : {table.exp, table.log, table.sqrt, table.sin, table.cos, table.tanh, table.sigmoid, table.relu}) {
+        bool needs_positive = kernel == table.log || kernel == table.sqrt;
+        kernel(needs_positive ? positive.data() : a.data(), result.data(), size * size);
+        out.insert(out.end(), result.begin(), result.end());
+    }
+    std::vector<uint64_t> state(4 * Kernels::RANDOM_LANES);
+    for (size_t i = 0; i < state.size(); ++i) { state[i] = 0x9E3779B97F4A7C15ULL * (i + 1); }
+    table.random(state.data(), result.data(), size * size);
+    out.insert(out.end(), result.begin(), result.end());
+    return out;
+}
+
+TEST(DispatchTest, selection){
+    EXPECT_TRUE(isIsaSupported(Isa::Generic));
+    EXPECT_TRUE(isIsaSupported(getBestIsa()));
+    Isa original = getIsa();
+    setIsa(Isa::Generic);
+    EXPECT_EQ(getIsa(), Isa::Generic);
+    EXPECT_STREQ(getIsaName(getIsa()), "generic");
+    setIsa(original);
+    EXPECT_EQ(getIsa(), original);
+}
+
+TEST(DispatchTest, identical_results){
+    Isa original = getIsa();
+    for (int size : {1, 3, 8, 13, 130, 300}) { //covers loop tails and gemm blocking
+        setIsa(Isa::Generic);
+        std::vector<double> expected = dispatchTestRun(size);
+        for (int level = (int)Isa::SSE42; level <= (int)Isa::AVX512; ++level) {
+            if (!isIsaSupported((Isa)level)) { continue; }
+            setIsa((Isa)level);
+            std::vector<double> result = dispatchTestRun(size);
+            ASSERT_EQ(expected.size(), result.size());
+            for (size_t i = 0; i < result.size(); ++i) {
+                ASSERT_EQ(expected[i], result[i]) << getIsaName((Isa)level) << " differs at " << i << " for size " << size;
+            }
+        }
+    }
+    setIsa(original);
+}
+
+TEST(DispatchTest, matrix_paths){
+    //matrix multiply through every path, against a plain triple loop
+    Matrix a(37, 21);
+    Matrix b(19, 37);
+    for (int x = 0; x < 37; ++x) {
+        for (int y = 0; y < 21; ++y) { a.setValue(x, y, x * 0.5 - y); }
+        for (int y = 0; y < 19; ++y) { b.setValue(y, x, x * 0.25 + y * 0.1); }
+    }
+    Matrix expected(19, 21);
+    for (int x = 0; x < 19; ++x) {
+        for (int y = 0; y < 21; ++y) {
+            double sum = 0;
+            for (int k = 0; k < 37; ++k) { sum += a.getValue(k, y) * b.getValue(x, k); }
+            expected.setValue(x, y, sum);
+        }
+    }
+    Isa original = getIsa();
+    for (int level = (int)Isa::Generic; level <= (int)Isa::AVX512; ++level) {
+        if (!isIsaSupported((Isa)level)) { continue; }
+        setIsa((Isa)level);
+        EXPECT_TRUE((a * b).equals(expected, 1e-9)) << getIsaName((Isa)level);
+        //batch transform matches one at a time
+        FixedMatrix<4,4> transform;
+        transform.fillArray({1,2,3,4, 5,6,7,8, 9,10,11,12, 0,0,0,1});
+        FixedVector<4> points[3] = {{1,2,3,1},{-1,0,2,1},{0.5,0.5,0.5,1}};
+        FixedVector<4> transformed[3];
+        transform.transformBatch(points, transformed, 3);
+        for (int i = 0; i < 3; ++i) { EXPECT_EQ(transformed[i], transform * points[i]); }
+    }
+    setIsa(original);
+}
+
+#endif //TENSORMATH_DISPATCHTEST_HPP
@@ -88,7 +88,18 @@ TEST(FixedMatrixTest, matrix_utils){
     FixedMatrix<2,2> of_size;
     EXPECT_EQ(of_size.getWidth(),2);
     EXPECT_EQ(of_size.getHeight(),2);
-
+    //non square, width 2 height 5
+    FixedMatrix<2,5> tall;
+    tall.fillArray({1,2,3,4,5,6,7,8,9,10});
+    EXPECT_EQ(tall.getArray(), (std::vector<double>{1,2,3,4,5,6,7,8,9,10})); //rows, like fillArray
+    EXPECT_EQ(tall.getValue(1,4), 10);
+    tall.setIdentity();
+    EXPECT_EQ(tall.getArray(), (std::vector<double>{1,0,0,1,0,0,0,0,0,0}));
+    tall.setZero();
+    EXPECT_EQ(tall.getArray(), std::vector<double>(10, 0.0));
+    FixedMatrix<5,2> wide;
+    wide.setIdentity();
+    EXPECT_EQ(wide.getArray(), (std::vector<double>{1,0,0,0,0,0,1,0,0,0}));
 }
 
 TEST(FixedMatrixTest, matrix_mul){
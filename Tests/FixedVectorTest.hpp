@@ -170,4 +170,29 @@ using namespace TensorMath;
 
     }
 
+    //test squared and approximate paths
+    TEST(FixedVectorTest, fast_paths){
+        EXPECT_DOUBLE_EQ((Vector2{4, 3}.lengthSquared()), 25.0);
+        EXPECT_DOUBLE_EQ(Vector3(3,2,0).distanceSquared(Vector3(-1,-1,0)), 25.0);
+        //fast normalization, each precision level
+        Vector3 v(1.5, -2.25, 7);
+        Vector3 expected = v.normalized();
+        EXPECT_TRUE(v.normalizedFast(Precision::Low).equals(expected, 1e-5));
+        EXPECT_TRUE(v.normalizedFast(Precision::Medium).equals(expected, 1e-10));
+        EXPECT_TRUE(v.normalizedFast(Precision::High) == expected);
+        //in place and batched(more than one block)
+        Vector3 in_place = v;
+        in_place.normalize();
+        EXPECT_EQ(in_place, expected);
+        std::vector<Vector3> batch;
+        for (int i = 1; i <= 37; ++i) { batch.emplace_back(i, -2.0 * i, 0.5); }
+        Vector3::normalizeBatch(batch.data(), (int)batch.size(), Precision::High);
+        std::vector<double> lengths(batch.size());
+        Vector3::lengthSquaredBatch(batch.data(), lengths.data(), (int)batch.size());
+        for (int i = 0; i < 37; ++i) {
+            EXPECT_EQ(batch[i], Vector3(i + 1, -2.0 * (i + 1), 0.5).normalized());
+            EXPECT_NEAR(lengths[i], 1.0, 1e-14);
+        }
+    }
+
 #endif //TENSOR_FVECTORTEST_HPP
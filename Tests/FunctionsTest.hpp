@@ -0,0 +1,127 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_FUNCTIONSTEST_HPP
+#define TENSORMATH_FUNCTIONSTEST_HPP
+
+#include "../TensorMath/Functions.hpp"
+#include "gtest/gtest.h"
+
+//tests for elementwise math functions, compared against the std versions
+using namespace TensorMath;
+
+//largest difference in units of the last place of the expected value
+static double functionsTestUlps(double value, double expected){
+    if (value == expected || (std::isnan(value) && std::isnan(expected))) { return 0; }
+    double ulp = std::nextafter(std::fabs(expected), HUGE_VAL) - std::fabs(expected);
+    return std::fabs(value - expected) / ulp;
+}
+
+TEST(FunctionsTest, accuracy){
+    Vector in(5000);
+    for (int i = 0; i < in.getDim(); ++i) { in[i] = (i - 2500) * 0.0123 + std::sin(i * 1.7) * 0.01; }
+    double (*sigmoid_std)(double) = [](double x) { return 1.0 / (1.0 + std::exp(-x)); };
+    struct { Vector (*function)(const Vector &); double (*expected)(double); double ulps; } cases[] = {
+            {exp, [](double x) { return std::exp(x); }, 2},
+            {sin, [](double x) { return std::sin(x); }, 3},
+            {cos, [](double x) { return std::cos(x); }, 3},
+            {tanh, [](double x) { return std::tanh(x); }, 4},
+            {sigmoid, sigmoid_std, 4},
+            {relu, [](double x) { return x < 0 ? 0.0 : x; }, 0},
+    };
+    for (auto &test : cases) {
+        Vector out = test.function(in);
+        for (int i = 0; i < in.getDim(); ++i) { ASSERT_LE(functionsTestUlps(out[i], test.expected(in[i])), test.ulps) << in[i]; }
+    }
+    Vector positive = exp(in);
+    Vector logarithm = log(positive);
+    Vector root = sqrt(positive);
+    for (int i = 0; i < in.getDim(); ++i) {
+        ASSERT_LE(functionsTestUlps(logarithm[i], std::log(positive[i])), 2) << positive[i];
+        ASSERT_EQ(root[i], std::sqrt(positive[i]));
+    }
+    //large arguments fall back to std
+    Vector big{1e6, -3e7, 1e300};
+    EXPECT_EQ(sin(big), Vector({std::sin(1e6), std::sin(-3e7), std::sin(1e300)}));
+}
+
+TEST(FunctionsTest, special_values){
+    Vector in{0.0, HUGE_VAL, -HUGE_VAL, NAN, -1, 800, -800, 1e-310};
+    Vector e = exp(in);
+    EXPECT_EQ(e[0], 1);
+    EXPECT_EQ(e[1], HUGE_VAL);
+    EXPECT_EQ(e[2], 0);
+    EXPECT_TRUE(std::isnan(e[3]));
+    EXPECT_EQ(e[5], HUGE_VAL);
+    EXPECT_EQ(e[6], 0);
+    Vector l = log(in);
+    EXPECT_EQ(l[0], -HUGE_VAL);
+    EXPECT_EQ(l[1], HUGE_VAL);
+    EXPECT_TRUE(std::isnan(l[2]) && std::isnan(l[3]) && std::isnan(l[4]));
+    EXPECT_NEAR(l[7], std::log(1e-310), 1e-12); //subnormal
+    Vector t = tanh(in);
+    EXPECT_EQ(t[1], 1);
+    EXPECT_EQ(t[2], -1);
+    EXPECT_EQ(t[7], 1e-310);
+    Vector s = sigmoid(in);
+    EXPECT_EQ(s[0], 0.5);
+    EXPECT_EQ(s[5], 1);
+    EXPECT_EQ(s[6], 0); //underflows instead of NaN
+    EXPECT_GT(sigmoid(Vector{-740})[0], 0); //e^-740 is a subnormal
+}
+
+TEST(FunctionsTest, destinations){
+    //in place, strided views, row major matrices and fixed types all give the same values
+    Matrix m(7, 5);
+    for (int x = 0; x < 7; ++x) { for (int y = 0; y < 5; ++y) { m.setValue(x, y, x * 0.3 - y * 0.7); }}
+    Matrix expected = tanh(m);
+    Matrix in_place = m;
+    tanh(in_place, in_place);
+    EXPECT_TRUE(in_place.equals(expected, 0));
+    Matrix row_major = m.toLayout(Layout::RowMajor);
+    Matrix row_out(7, 5, Layout::RowMajor);
+    tanh(row_major, row_out);
+    EXPECT_TRUE(row_out.equals(expected, 0));
+    Matrix strided(7, 5);
+    tanh(m.view().transposed().transposed(), strided.view().block(0, 0, 7, 5));
+    EXPECT_TRUE(strided.equals(expected, 0));
+    Vector row_values(7);
+    tanh(m.row(2), row_values); //strided input
+    for (int x = 0; x < 7; ++x) { EXPECT_EQ(row_values[x], expected.getValue(x, 2)); }
+    FixedVector<3> fixed{0.5, -1, 2};
+    FixedVector<3> fixed_out = exp(fixed);
+    for (int i = 0; i < 3; ++i) { EXPECT_EQ(fixed_out[i], exp(Vector{fixed[i]})[0]); }
+    FixedMatrix<2, 2> fixed_matrix;
+    fixed_matrix.fillArray({1, -2, 3, -4});
+    FixedMatrix<2, 2> rectified = relu(fixed_matrix);
+    EXPECT_EQ(rectified.getValue(0, 0), 1);
+    EXPECT_EQ(rectified.getValue(1, 0), 0);
+    //large vectors split across threads
+    size_t old_threshold = getParallelThreshold();
+    setParallelThreshold(1);
+    Vector big(10000);
+    for (int i = 0; i < big.getDim(); ++i) { big[i] = i * 0.001; }
+    Vector serial_result = exp(big);
+    setParallelThreshold(old_threshold);
+    Vector single = exp(big);
+    EXPECT_TRUE(serial_result.equals(single, 0));
+}
+
+TEST(FunctionsTest, softmax){
+    Vector in{1, 2, 3, 1000};
+    Vector out = softmax(in);
+    EXPECT_NEAR(out[3], 1, 1e-15); //no overflow
+    Vector small{1, 2, 3};
+    Vector result = softmax(small);
+    double sum = std::exp(1) + std::exp(2) + std::exp(3);
+    for (int i = 0; i < 3; ++i) { EXPECT_NEAR(result[i], std::exp(i + 1) / sum, 1e-15); }
+    EXPECT_NEAR(result[0] + result[1] + result[2], 1, 1e-15);
+    Matrix logits(2, 3);
+    logits.fillArray({1, 5, 2, 5, 3, 5});
+    Matrix probabilities = softmaxColumns(logits);
+    EXPECT_TRUE(Vector(probabilities.getColumn(0)).equals(result, 1e-15));
+    EXPECT_TRUE(Vector(probabilities.getColumn(1)).equals(Vector{1.0 / 3, 1.0 / 3, 1.0 / 3}, 1e-15));
+}
+
+#endif //TENSORMATH_FUNCTIONSTEST_HPP
@@ -0,0 +1,53 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_INSTRUMENTTEST_HPP
+#define TENSORMATH_INSTRUMENTTEST_HPP
+
+#include <thread>
+#include "../TensorMath/Matrix.hpp"
+#include "../TensorMath/Functions.hpp"
+#include "gtest/gtest.h"
+
+//tests for the instrumentation counters(the test build defines TENSORMATH_INSTRUMENT, see CMakeLists.txt)
+using namespace TensorMath;
+
+TEST(InstrumentTest, counters){
+    InstrumentSnapshot start = getThreadInstrumentSnapshot();
+    Vector a(1000);
+    Vector b(a);
+    Vector c = a + b;
+    double dot = c.dotProduct(a);
+    Matrix x(100, 100), y(100, 100);
+    Matrix product = x * y;
+    Vector column = product.getColumn(3);
+    Vector activations = tanh(column);
+    InstrumentSnapshot work = getThreadInstrumentSnapshot() - start;
+    EXPECT_EQ(dot, 0);
+    if (!isInstrumentEnabled()) { //no counting at all
+        EXPECT_EQ(work.allocations, 0);
+        EXPECT_EQ(getInstrumentSnapshot().flops, 0);
+        return;
+    }
+    EXPECT_EQ(work.allocations, 8); //a b c x y product column activations
+    EXPECT_EQ(work.allocated_bytes, (3 * 1000 + 3 * 100 * 100 + 2 * 100) * sizeof(double));
+    EXPECT_EQ(work.copies, 2); //b, column
+    EXPECT_EQ(work.copied_bytes, (1000 + 100) * sizeof(double));
+    EXPECT_EQ(work.flops, 1000 + 2 * 1000 + 2 * 100 * 100 * 100);
+    EXPECT_EQ(work.getCalls(InstrumentCategory::Elementwise), 1);
+    EXPECT_EQ(work.getCalls(InstrumentCategory::Reduction), 1);
+    EXPECT_EQ(work.getCalls(InstrumentCategory::Multiply), 1);
+    EXPECT_EQ(work.getCalls(InstrumentCategory::Functions), 1);
+    EXPECT_GT(work.getSeconds(InstrumentCategory::Multiply), 0);
+    EXPECT_NE(work.toString().find("flops: 2003000"), std::string::npos);
+
+    InstrumentSnapshot before = getInstrumentSnapshot(); //other threads add to the total
+    std::thread other([]() { Vector scratch(10); scratch += 1.0; });
+    other.join();
+    InstrumentSnapshot total = getInstrumentSnapshot() - before;
+    EXPECT_EQ(total.allocations, 1);
+    EXPECT_EQ(total.flops, 10);
+}
+
+#endif //TENSORMATH_INSTRUMENTTEST_HPP
@@ -0,0 +1,92 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_ITERATORTEST_HPP
+#define TENSORMATH_ITERATORTEST_HPP
+
+#include <algorithm>
+#include <numeric>
+#include "../TensorMath/Matrix.hpp"
+#include "../TensorMath/FixedMatrix.hpp"
+#include "gtest/gtest.h"
+
+//tests for iterators and ranges used with standard algorithms
+using namespace TensorMath;
+
+TEST(IteratorTest, contiguous){
+    Vector vector(5);
+    std::iota(vector.begin(), vector.end(), 1.0);
+    EXPECT_EQ(std::reduce(vector.begin(), vector.end()), 15);
+    EXPECT_EQ(vector.size(), 5);
+    Vector squares(5);
+    std::transform(vector.begin(), vector.end(), squares.begin(), [](double value) { return value * value; });
+    EXPECT_EQ(squares[4], 25);
+    double sum = 0;
+    for (double value: squares) { sum += value; }
+    EXPECT_EQ(sum, 55);
+
+    Matrix matrix(3, 2, Layout::RowMajor);
+    std::iota(matrix.begin(), matrix.end(), 0.0); //storage order, so rows here
+    EXPECT_EQ(matrix.getValue(2, 0), 2);
+    EXPECT_EQ(matrix.getValue(0, 1), 3);
+    EXPECT_EQ(matrix.end() - matrix.begin(), 6);
+
+    FixedVector<3> fixed(3, 1, 2);
+    std::sort(fixed.begin(), fixed.end());
+    EXPECT_TRUE(fixed.equals(FixedVector<3>(1, 2, 3)));
+    FixedMatrix<2, 3> fixed_matrix;
+    std::fill(fixed_matrix.begin(), fixed_matrix.end(), 2.0);
+    EXPECT_EQ(fixed_matrix.size(), 6);
+    EXPECT_EQ(std::accumulate(fixed_matrix.begin(), fixed_matrix.end(), 0.0), 12);
+    EXPECT_EQ(fixed_matrix.data()[5], 2);
+}
+
+TEST(IteratorTest, ranges){
+    Matrix matrix(3, 2); //column major, so rows are strided
+    std::iota(matrix.begin(), matrix.end(), 0.0);
+    ConstVectorView row = matrix.row(1);
+    EXPECT_EQ(std::accumulate(row.begin(), row.end(), 0.0), 1 + 3 + 5);
+    EXPECT_EQ(*std::max_element(row.begin(), row.end()), 5);
+    EXPECT_EQ(row.end() - row.begin(), 3);
+    EXPECT_EQ(row.begin()[2], 5);
+
+    for (VectorView column: matrix.columns()) { column *= 2; }
+    for (VectorView line: matrix.rows()) { std::sort(line.begin(), line.end(), std::greater<double>()); }
+    EXPECT_EQ(matrix.getValue(0, 1), 10);
+    EXPECT_EQ(matrix.getValue(2, 0), 0);
+    EXPECT_EQ(matrix.rows().size(), 2);
+    EXPECT_EQ(matrix.columns()[1].getValue(1), 6);
+
+    const Matrix &read_only = matrix;
+    int count = 0;
+    for (ConstVectorView column: read_only.columns()) { count += column.getDim(); }
+    EXPECT_EQ(count, 6);
+    EXPECT_EQ(std::distance(read_only.rows().begin(), read_only.rows().end()), 2);
+}
+
+TEST(IteratorTest, assignment){
+    Matrix a(3, 2), b(3, 2);
+    std::iota(a.begin(), a.end(), 0.0);
+    std::iota(b.begin(), b.end(), 10.0);
+    Matrix a_copy = a, b_copy = b;
+    auto it = a.columns().begin();
+    it = b.columns().begin(); //rebinds, copies no values
+    EXPECT_TRUE(a.equals(a_copy, 0));
+    EXPECT_EQ((*it).getValue(0), 10);
+    auto other = b.columns().begin() + 2;
+    other = it;
+    EXPECT_TRUE(b.equals(b_copy, 0));
+    EXPECT_EQ(other, it);
+    LineRange<double> range = a.rows();
+    range = b.rows();
+    EXPECT_TRUE(a.equals(a_copy, 0));
+    EXPECT_EQ(range[1].getValue(2), 15);
+    EXPECT_EQ(std::find_if(a.columns().begin(), a.columns().end(), [](ConstVectorView column) {
+        return column.getValue(0) == 4;
+    }) - a.columns().begin(), 2);
+    EXPECT_TRUE(a.equals(a_copy, 0));
+    EXPECT_TRUE(b.equals(b_copy, 0));
+}
+
+#endif //TENSORMATH_ITERATORTEST_HPP
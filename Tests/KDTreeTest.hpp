@@ -0,0 +1,79 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_KDTREETEST_HPP
+#define TENSORMATH_KDTREETEST_HPP
+
+#include "../TensorMath/KDTree.hpp"
+#include "gtest/gtest.h"
+
+//tests for k-d tree searches
+using namespace TensorMath;
+
+TEST(KDTreeTest, nearest){
+    srand(7);
+    std::vector<Vector3> points;
+    for (int i = 0; i < 5000; ++i) {
+        points.emplace_back(rand() % 1000 / 10.0, rand() % 1000 / 10.0, rand() % 1000 / 10.0);
+    }
+    KDTree<3> tree(points);
+    EXPECT_EQ(tree.getSize(), 5000);
+    for (int q = 0; q < 50; ++q) {
+        Vector3 query(rand() % 1000 / 10.0, rand() % 1000 / 10.0, rand() % 1000 / 10.0);
+        //brute force
+        std::vector<std::pair<double,int>> expected;
+        for (int i = 0; i < (int)points.size(); ++i) {
+            double distance = query.distance(points[i]);
+            expected.emplace_back(distance * distance, i);
+        }
+        std::sort(expected.begin(), expected.end());
+        std::vector<KDTree<3>::Neighbor> found = tree.nearest(query, 10);
+        ASSERT_EQ(found.size(), 10u);
+        for (int i = 0; i < 10; ++i) {
+            EXPECT_NEAR(found[i].distance_squared, expected[i].first, 1e-9); //ties may swap indices, distances may not
+        }
+        EXPECT_TRUE(found[0].index == expected[0].second || found[0].distance_squared == expected[1].first);
+    }
+    //asking for more than there is
+    KDTree<2> small({Vector2{0,0}, Vector2{1,1}});
+    EXPECT_EQ(small.nearest(Vector2{5,5}, 4).size(), 2u);
+    EXPECT_EQ(small.nearest(Vector2{5,5}, 1)[0].index, 1);
+}
+
+TEST(KDTreeTest, radius){
+    std::vector<Vector2> grid;
+    for (int x = 0; x < 20; ++x) {
+        for (int y = 0; y < 20; ++y) {
+            grid.push_back(Vector2{(double)x,(double)y});
+        }
+    }
+    KDTree<2> tree(grid, 3);
+    std::vector<KDTree<2>::Neighbor> found = tree.radius(Vector2{10,10}, 1.0);
+    ASSERT_EQ(found.size(), 5u); //center and 4 sides, radius is inclusive
+    EXPECT_EQ(found[0].index, 10 * 20 + 10);
+    EXPECT_DOUBLE_EQ(found[0].distance_squared, 0);
+    EXPECT_DOUBLE_EQ(found[4].distance_squared, 1);
+    EXPECT_EQ(tree.radius(Vector2{-5,-5}, 1.0).size(), 0u);
+    EXPECT_EQ(tree.radius(Vector2{0,0}, 1.5).size(), 4u); //corner
+}
+
+TEST(KDTreeTest, batched){
+    std::vector<Vector3> points;
+    for (int i = 0; i < 1000; ++i) { points.emplace_back(i, i % 7, i % 13); }
+    KDTree<3> tree(points);
+    std::vector<Vector3> queries;
+    for (int i = 0; i < 700; ++i) { queries.emplace_back(i * 1.3, i % 5, i % 11); }
+    std::vector<std::vector<KDTree<3>::Neighbor>> nearest = tree.nearest(queries, 3);
+    std::vector<std::vector<KDTree<3>::Neighbor>> within = tree.radius(queries, 4.0);
+    ASSERT_EQ(nearest.size(), queries.size());
+    ASSERT_EQ(within.size(), queries.size());
+    for (int i = 0; i < (int)queries.size(); ++i) {
+        std::vector<KDTree<3>::Neighbor> single = tree.nearest(queries[i], 3);
+        ASSERT_EQ(nearest[i].size(), single.size());
+        for (int n = 0; n < 3; ++n) { EXPECT_DOUBLE_EQ(nearest[i][n].distance_squared, single[n].distance_squared); }
+        EXPECT_EQ(within[i].size(), tree.radius(queries[i], 4.0).size());
+    }
+}
+
+#endif //TENSORMATH_KDTREETEST_HPP
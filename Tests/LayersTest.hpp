@@ -0,0 +1,110 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_LAYERSTEST_HPP
+#define TENSORMATH_LAYERSTEST_HPP
+
+#include "../TensorMath/Layers.hpp"
+#include "gtest/gtest.h"
+
+//tests for fused layers, compared against separate Matrix operations and finite differences
+using namespace TensorMath;
+
+//matrix with deterministic values
+static Matrix layersTestMatrix(int width, int height, double seed){
+    Matrix out(width, height);
+    for (int x = 0; x < width; ++x) {
+        for (int y = 0; y < height; ++y) { out.setValue(x, y, std::sin(seed + x * 1.3 + y * 0.7)); }
+    }
+    return out;
+}
+
+//sum of output * weights, a loss whose gradient by the output is weights
+static double layersTestLoss(const Matrix &weights, const Matrix &input, const Vector &bias, Activation activation,
+                             const Matrix &loss_weights){
+    Matrix out(input.getWidth(), weights.getHeight());
+    linearForward(weights, input, bias, activation, out);
+    double loss = 0;
+    for (int x = 0; x < out.getWidth(); ++x) {
+        for (int y = 0; y < out.getHeight(); ++y) { loss += out.getValue(x, y) * loss_weights.getValue(x, y); }
+    }
+    return loss;
+}
+
+TEST(LayersTest, forward){
+    Matrix weights = layersTestMatrix(6, 5, 0.1);
+    Matrix input = layersTestMatrix(70, 6, 0.2); //more than two tiles of samples
+    Vector bias{0.1, -0.2, 0.3, 0, 0.5};
+    size_t old_threshold = getParallelThreshold();
+    for (size_t threshold : {old_threshold, (size_t) 1}) {
+        setParallelThreshold(threshold);
+        for (Activation activation : {Activation::None, Activation::Relu, Activation::Sigmoid, Activation::Tanh}) {
+            Matrix expected = weights * input;
+            for (int x = 0; x < expected.getWidth(); ++x) { expected[x] += bias; }
+            if (activation == Activation::Relu) { expected = relu(expected); }
+            if (activation == Activation::Sigmoid) { expected = sigmoid(expected); }
+            if (activation == Activation::Tanh) { expected = tanh(expected); }
+            Matrix out(70, 5);
+            linearForward(weights, input, bias, activation, out);
+            EXPECT_TRUE(out.equals(expected, 0));
+            Matrix row_major(70, 5, Layout::RowMajor); //other layouts give the same values
+            linearForward(weights.toLayout(Layout::RowMajor), input, bias, activation, row_major);
+            EXPECT_TRUE(row_major.equals(expected, 0));
+        }
+    }
+    setParallelThreshold(old_threshold);
+}
+
+TEST(LayersTest, backward){
+    Matrix weights = layersTestMatrix(4, 3, 0.3);
+    Matrix input = layersTestMatrix(5, 4, 0.4);
+    Vector bias{0.2, -0.1, 0.05};
+    Matrix loss_weights = layersTestMatrix(5, 3, 0.5);
+    for (Activation activation : {Activation::None, Activation::Sigmoid, Activation::Tanh}) {
+        Matrix out(5, 3);
+        linearForward(weights, input, bias, activation, out);
+        Matrix gradient = loss_weights;
+        Matrix weight_gradient(4, 3), input_gradient(5, 4);
+        Vector bias_gradient(3);
+        linearBackward(weights, input, out, gradient, activation, weight_gradient, bias_gradient, input_gradient);
+        double step = 1e-6;
+        for (int x = 0; x < 4; ++x) {
+            for (int y = 0; y < 3; ++y) {
+                Matrix plus = weights, minus = weights;
+                plus.setValue(x, y, weights.getValue(x, y) + step);
+                minus.setValue(x, y, weights.getValue(x, y) - step);
+                double slope = (layersTestLoss(plus, input, bias, activation, loss_weights) -
+                                layersTestLoss(minus, input, bias, activation, loss_weights)) / (2 * step);
+                EXPECT_NEAR(weight_gradient.getValue(x, y), slope, 1e-7);
+            }
+        }
+        for (int y = 0; y < 3; ++y) {
+            Vector plus = bias, minus = bias;
+            plus[y] += step;
+            minus[y] -= step;
+            double slope = (layersTestLoss(weights, input, plus, activation, loss_weights) -
+                            layersTestLoss(weights, input, minus, activation, loss_weights)) / (2 * step);
+            EXPECT_NEAR(bias_gradient[y], slope, 1e-7);
+        }
+        for (int x = 0; x < 5; ++x) {
+            for (int y = 0; y < 4; ++y) {
+                Matrix plus = input, minus = input;
+                plus.setValue(x, y, input.getValue(x, y) + step);
+                minus.setValue(x, y, input.getValue(x, y) - step);
+                double slope = (layersTestLoss(weights, plus, bias, activation, loss_weights) -
+                                layersTestLoss(weights, minus, bias, activation, loss_weights)) / (2 * step);
+                EXPECT_NEAR(input_gradient.getValue(x, y), slope, 1e-7);
+            }
+        }
+    }
+    //relu passes the gradient only where the output is positive
+    Matrix output(2, 1), gradient(2, 1);
+    output.fillArray({0, 2});
+    gradient.fillArray({5, 7});
+    activationBackward(output, gradient, Activation::Relu, gradient);
+    EXPECT_EQ(gradient.getValue(0, 0), 0);
+    EXPECT_EQ(gradient.getValue(1, 0), 7);
+}
+
+#endif //TENSORMATH_LAYERSTEST_HPP
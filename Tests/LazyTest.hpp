@@ -0,0 +1,119 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_LAZYTEST_HPP
+#define TENSORMATH_LAZYTEST_HPP
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "../TensorMath/Lazy.hpp"
+#include "gtest/gtest.h"
+
+//tests for lazy expressions, compared against the same operations done eagerly
+using namespace TensorMath;
+
+//every heap allocation of the test program, to check evaluations that should not allocate
+static std::atomic<size_t> lazyTestAllocations{0};
+
+void *operator new(size_t size) {
+    lazyTestAllocations.fetch_add(1, std::memory_order_relaxed);
+    void *memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) { throw std::bad_alloc(); }
+    return memory;
+}
+void operator delete(void *memory) noexcept { std::free(memory); }
+void operator delete(void *memory, size_t) noexcept { std::free(memory); }
+
+TEST(LazyTest, fusedProduct){
+    Matrix a(40, 30), b(50, 40, Layout::RowMajor), c(50, 30), d(50, 30);
+    a.randomFill(-1, 1, 1);
+    b.randomFill(-1, 1, 2);
+    c.randomFill(-1, 1, 3);
+    d.randomFill(-1, 1, 4);
+    ExpressionGraph graph;
+    Expression result = graph.input(a) * graph.input(b) + graph.input(c) - graph.input(d);
+    EXPECT_EQ(graph.getWidth(result), 50);
+    EXPECT_EQ(graph.getHeight(result), 30);
+    Matrix out(50, 30);
+    graph.evaluate(result, out);
+    EXPECT_TRUE(out.equals((a * b + c) - d, 1e-12));
+    EXPECT_EQ(graph.getPeakBytes(), 0); //the product is computed straight into out
+    Matrix row_major(50, 30, Layout::RowMajor); //goes through a buffer
+    graph.evaluate(result, row_major);
+    EXPECT_TRUE(row_major.equals(out, 0));
+}
+
+TEST(LazyTest, bufferReuse){
+    Matrix a(20, 20), b(20, 20), c(20, 20), d(20, 20), e(20, 20);
+    a.randomFill(-1, 1, 1);
+    b.randomFill(-1, 1, 2);
+    c.randomFill(-1, 1, 3);
+    d.randomFill(-1, 1, 4);
+    e.randomFill(-1, 1, 5);
+    ExpressionGraph graph;
+    Expression result = (((graph.input(a) * graph.input(b)) * graph.input(c)) * graph.input(d)) * graph.input(e);
+    Matrix out = graph.evaluate(result);
+    EXPECT_TRUE(out.equals((((a * b) * c) * d) * e, 1e-12));
+    EXPECT_EQ(graph.getBufferCount(), 2); //each product only needs the one before it
+    EXPECT_EQ(graph.getPeakBytes(), 2 * 20 * 20 * sizeof(double));
+    graph.reset(); //the pool stays
+    Expression again = (graph.input(a) * graph.input(b)) * graph.input(c);
+    out = graph.evaluate(again);
+    EXPECT_TRUE(out.equals((a * b) * c, 1e-12));
+    EXPECT_EQ(graph.getBufferCount(), 2);
+}
+
+TEST(LazyTest, functions){
+    Matrix weights(6, 4), data(700, 6, Layout::RowMajor);
+    weights.randomFill(-1, 1, 1);
+    data.randomFill(-1, 1, 2);
+    Vector bias{0.1, -0.2, 0.3, -0.4};
+    ExpressionGraph graph;
+    Expression hidden = tanh(addBias(graph.input(weights) * graph.input(data), graph.input(bias)));
+    Expression mixed = sigmoid(hidden) + relu(hidden) - hadamard(hidden, hidden) * 0.5;
+    Expression result = exp(sin(mixed)) + sqrt(exp(cos(-mixed))) + 2.0 * log(exp(mixed));
+    Matrix out = graph.evaluate(result);
+    Matrix expected(700, 4);
+    for (int x = 0; x < 700; ++x) {
+        for (int y = 0; y < 4; ++y) {
+            double sum = bias[y];
+            for (int i = 0; i < 6; ++i) { sum += weights.getValue(i, y) * data.getValue(x, i); }
+            double h = std::tanh(sum);
+            double m = 1 / (1 + std::exp(-h)) + std::max(h, 0.0) - h * h * 0.5;
+            expected.setValue(x, y, std::exp(std::sin(m)) + std::sqrt(std::exp(std::cos(-m))) + 2.0 * m);
+        }
+    }
+    EXPECT_TRUE(out.equals(expected, 1e-12));
+    Matrix row_major(700, 4, Layout::RowMajor); //any output layout
+    graph.evaluate(result, row_major);
+    EXPECT_TRUE(row_major.equals(out, 0));
+    EXPECT_EQ(graph.getPeakBytes(), 2 * 700 * 4 * sizeof(double)); //the shared hidden values and the row major result
+}
+
+TEST(LazyTest, steadyState){
+    Matrix weights(30, 20), data(50, 30, Layout::RowMajor), other(20, 50, Layout::RowMajor);
+    weights.randomFill(-1, 1, 1);
+    data.randomFill(-1, 1, 2);
+    other.randomFill(-1, 1, 3);
+    Vector bias(20);
+    bias.randomFill(-1, 1, 4);
+    ExpressionGraph graph(16);
+    Matrix out(50, 20), row_major(50, 20, Layout::RowMajor);
+    size_t threshold = getParallelThreshold();
+    setParallelThreshold(1); //split across the pool too(TENSORMATH_THREADS), every thread keeps its scratch space
+    for (int i = 0; i < 5; ++i) { //the first evaluations grow the pool, plan and scratch space to fit
+        graph.reset();
+        Expression hidden = tanh(addBias(graph.input(weights) * graph.input(data), graph.input(bias)));
+        Expression result = hidden * graph.input(other) * graph.input(weights) * graph.input(data) + exp(hidden) * 0.5;
+        size_t before = lazyTestAllocations.load();
+        graph.evaluate(result, out);
+        graph.evaluate(result, row_major);
+        if (i >= 2) { EXPECT_EQ(lazyTestAllocations.load() - before, 0); }
+    }
+    setParallelThreshold(threshold);
+    EXPECT_TRUE(row_major.equals(out, 0));
+}
+
+#endif //TENSORMATH_LAZYTEST_HPP
@@ -139,5 +139,43 @@ TEST(MatrixTest, matrix_mul){
     EXPECT_EQ( vector_times_e , from_vector * e);
 }
 
+TEST(MatrixTest, matrix_layout){
+    std::vector<double> data = {1,2,3,4,5,6};
+    Matrix columns(3,2);
+    columns.fillArray(data);
+    Matrix rows(3,2,Layout::RowMajor);
+    rows.fillArray(data);
+    EXPECT_EQ(rows.getLayout(), Layout::RowMajor);
+    EXPECT_DOUBLE_EQ(rows.data()[1], 2); //stored in the order it arrived
+    EXPECT_EQ(columns, rows); //same values, different order
+    EXPECT_EQ(data, rows.getArray());
+    EXPECT_EQ(rows.getRow(1), (Vector{4,5,6}));
+    EXPECT_EQ(rows.getColumn(2), (Vector{3,6}));
+    //transpose flips the layout without moving anything
+    Matrix transposed = columns.transposed();
+    EXPECT_EQ(transposed.getLayout(), Layout::RowMajor);
+    Matrix expected_transpose(2,3);
+    expected_transpose.fillArray({1,4,2,5,3,6});
+    EXPECT_EQ(transposed, expected_transpose);
+    EXPECT_EQ(rows.transposed(), expected_transpose);
+    EXPECT_EQ(rows.toLayout(Layout::ColumnMajor).getLayout(), Layout::ColumnMajor);
+    //operations work on every mix of layouts
+    Matrix other(2,3,Layout::RowMajor);
+    other.fillArray({7,8,9,10,11,12});
+    Matrix product(2,2);
+    product.fillArray({58,64,139,154});
+    EXPECT_EQ(rows * other, product);
+    EXPECT_EQ((rows * other).getLayout(), Layout::RowMajor);
+    EXPECT_EQ((rows.view() * columns.view().transposed()).getLayout(), Layout::RowMajor); //the left side decides
+    EXPECT_EQ((columns.view() * other.view()).getLayout(), Layout::ColumnMajor);
+    EXPECT_EQ((rows.view() + columns.view()).getLayout(), Layout::RowMajor);
+    EXPECT_EQ(columns * other, product);
+    EXPECT_EQ(rows * other.toLayout(Layout::ColumnMajor), product);
+    EXPECT_EQ(rows + rows, columns + columns);
+    EXPECT_EQ(rows - columns, Matrix(3,2));
+    Matrix assigned(3,2);
+    assigned = rows;
+    EXPECT_EQ(assigned, columns);
+}
 
 #endif //TENSORMATH_MATRIXTEST_HPP
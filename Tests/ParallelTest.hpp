@@ -0,0 +1,99 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_PARALLELTEST_HPP
+#define TENSORMATH_PARALLELTEST_HPP
+
+#include <stdexcept>
+#include "../TensorMath/Parallel.hpp"
+#include "../TensorMath/Matrix.hpp"
+#include "gtest/gtest.h"
+
+//tests for the parallel engine. Threaded results must match the single threaded ones exactly.
+using namespace TensorMath;
+
+TEST(ParallelTest, pool){
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.getThreadCount(), 4);
+    std::atomic<int> calls[4] = {};
+    for (int run = 0; run < 10; ++run) {
+        pool.run([&](int t) { calls[t]++; });
+    }
+    for (int t = 0; t < 4; ++t) { EXPECT_EQ(calls[t].load(), 10); } //every part runs once per job
+    //nested jobs run on the calling thread instead of deadlocking
+    std::atomic<int> nested{0};
+    pool.run([&](int) { pool.run([&](int) { nested++; }); });
+    EXPECT_EQ(nested.load(), 16);
+}
+
+TEST(ParallelTest, exceptions){
+    ThreadPool pool(3);
+    std::atomic<int> finished{0};
+    for (int thrower = 0; thrower < 3; ++thrower) { //on the calling thread and on workers
+        finished = 0;
+        EXPECT_THROW(pool.run([&](int t) {
+            if (t == thrower) { throw std::out_of_range("part"); }
+            finished++;
+        }), std::out_of_range);
+        EXPECT_EQ(finished.load(), 2); //the other parts still ran to the end
+    }
+    //the pool still runs jobs in parallel afterwards, not serially on the caller
+    std::thread::id caller = std::this_thread::get_id(), ids[3];
+    pool.run([&](int t) { ids[t] = std::this_thread::get_id(); });
+    EXPECT_EQ(ids[0], caller);
+    EXPECT_NE(ids[1], caller);
+    EXPECT_NE(ids[2], caller);
+}
+
+TEST(ParallelTest, ranges){
+    size_t old_threshold = getParallelThreshold();
+    setParallelThreshold(1);
+    std::vector<int> hits(100003, 0);
+    parallelFor(hits.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) { hits[i]++; }
+    });
+    EXPECT_EQ(std::count(hits.begin(), hits.end(), 1), (long) hits.size()); //every index exactly once
+    //reductions use fixed chunks, so they match the serial result exactly
+    auto sum = [](size_t begin, size_t end) {
+        double out = 0;
+        for (size_t i = begin; i < end; ++i) { out += 1.0 / (double) (i + 1); }
+        return out;
+    };
+    double parallel = parallelReduce(100003, sum);
+    setParallelThreshold(old_threshold);
+    EXPECT_EQ(parallel, parallelReduce(100003, sum));
+}
+
+TEST(ParallelTest, large_operations){
+    const int size = 300000;
+    Vector a(size), b(size);
+    for (int i = 0; i < size; ++i) {
+        a[i] = std::sin(i * 0.01);
+        b[i] = std::cos(i * 0.02) + 2;
+    }
+    //serial results
+    size_t old_threshold = getParallelThreshold();
+    setParallelThreshold(std::numeric_limits<size_t>::max());
+    Vector sum = a + b, quotient = a / b, scaled = a * 3.0;
+    double dot = a.dotProduct(b);
+    Matrix m(600, 500), n(600, 500);
+    m.fillArray(std::vector<double>(a.data(), a.data() + size));
+    n.fillArray(std::vector<double>(b.data(), b.data() + size));
+    Matrix difference = m - n;
+    //threaded results
+    setParallelThreshold(1024);
+    EXPECT_TRUE(Vector(a + b).equals(sum, 0));
+    EXPECT_TRUE(Vector(a / b).equals(quotient, 0));
+    EXPECT_TRUE(Vector(a * 3.0).equals(scaled, 0));
+    EXPECT_EQ(a.dotProduct(b), dot);
+    EXPECT_EQ(ConstVectorView(a).dotProduct(b), dot); //a view of the same data gives the same bits
+    EXPECT_EQ(ConstVectorView(a).lengthSquared(), a.lengthSquared());
+    EXPECT_EQ(ConstVectorView(a).distanceSquared(b), a.distanceSquared(b));
+    EXPECT_TRUE((m - n).equals(difference, 0));
+    Vector zeros(size);
+    EXPECT_TRUE(zeros == 0.0);
+    setParallelThreshold(old_threshold);
+}
+
+#endif //TENSORMATH_PARALLELTEST_HPP
@@ -0,0 +1,83 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_RANDOMTEST_HPP
+#define TENSORMATH_RANDOMTEST_HPP
+
+#include "../TensorMath/Matrix.hpp"
+#include "../TensorMath/FixedMatrix.hpp"
+#include "gtest/gtest.h"
+
+//tests for random fills: repeatable seeds, same values on any number of threads, and the right distributions
+using namespace TensorMath;
+
+TEST(RandomTest, seeds){
+    Vector a(10000), b(10000);
+    a.randomFill(-1, 2.5, 42);
+    b.randomFill(-1, 2.5, 42);
+    EXPECT_EQ(a, b);
+    b.randomFill(-1, 2.5, 43);
+    EXPECT_NE(a, b);
+    size_t old_threshold = getParallelThreshold();
+    setParallelThreshold(1); //every chunk on its own thread
+    Vector parallel(10000), normal(10001), parallel_normal(10001);
+    parallel.randomFill(-1, 2.5, 42);
+    parallel_normal.randomNormalFill(0, 1, 7);
+    setParallelThreshold(old_threshold);
+    normal.randomNormalFill(0, 1, 7);
+    EXPECT_EQ(a, parallel);
+    EXPECT_EQ(normal, parallel_normal);
+
+    uint64_t old_seed = getRandomSeed();
+    setRandomSeed(1234);
+    a.randomFill(0, 1);
+    setRandomSeed(1234);
+    b.randomFill(0, 1);
+    EXPECT_EQ(a, b);
+    setRandomSeed(old_seed);
+
+    FixedMatrix<3, 4> fixed_a, fixed_b;
+    fixed_a.randomFill(-1, 1, 5);
+    fixed_b.randomFill(-1, 1, 5);
+    EXPECT_EQ(fixed_a, fixed_b);
+    Random generator(9), same(9);
+    for (int i = 0; i < 100; ++i) { ASSERT_EQ(generator.next(), same.next()); }
+}
+
+TEST(RandomTest, distributions){
+    Matrix uniform(300, 200, Layout::RowMajor);
+    uniform.randomFill(-1, 3, 11);
+    int size = uniform.getWidth() * uniform.getHeight();
+    double sum = 0;
+    for (int i = 0; i < size; ++i) {
+        double value = uniform.data()[i];
+        ASSERT_TRUE(value >= -1 && value < 3);
+        sum += value;
+    }
+    EXPECT_NEAR(sum / size, 1.0, 0.02); //mean of [-1, 3), standard error 0.005
+
+    Vector normal(60001);
+    normal.randomNormalFill(2, 3, 12);
+    double mean = 0, variance = 0;
+    for (int i = 0; i < normal.getDim(); ++i) { mean += normal[i]; }
+    mean /= normal.getDim();
+    for (int i = 0; i < normal.getDim(); ++i) { variance += (normal[i] - mean) * (normal[i] - mean); }
+    variance /= normal.getDim();
+    EXPECT_NEAR(mean, 2, 0.05); //standard error 0.012
+    EXPECT_NEAR(variance, 9, 0.25); //standard error 0.05
+    int inside = 0; //68.3% within one deviation
+    for (int i = 0; i < normal.getDim(); ++i) { inside += std::fabs(normal[i] - 2) < 3; }
+    EXPECT_NEAR(inside / (double)normal.getDim(), 0.6827, 0.01);
+
+    FixedVector<1000> fixed;
+    fixed.randomNormalFill();
+    for (int i = 0; i < 1000; ++i) { ASSERT_TRUE(std::isfinite(fixed[i])); }
+    Random &generator = Random::local();
+    for (int i = 0; i < 1000; ++i) {
+        double value = generator.uniform(2, 5);
+        ASSERT_TRUE(value >= 2 && value < 5);
+    }
+}
+
+#endif //TENSORMATH_RANDOMTEST_HPP
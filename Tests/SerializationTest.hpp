@@ -0,0 +1,61 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_SERIALIZATIONTEST_HPP
+#define TENSORMATH_SERIALIZATIONTEST_HPP
+
+#include <sstream>
+#include "../TensorMath/Serialization.hpp"
+#include "gtest/gtest.h"
+
+//tests for binary serialization of fixed types
+using namespace TensorMath;
+
+static_assert(std::is_trivially_copyable<FixedVector<7>>::value, "FixedVector must be trivially copyable");
+static_assert(std::is_trivially_copyable<FixedMatrix<2,5>>::value, "FixedMatrix must be trivially copyable");
+
+TEST(SerializationTest, byte_order){
+    double one = 1.0; //0x3FF0000000000000
+    unsigned char little[8], big[8];
+    serialize(&one, 1, little, Endian::Little);
+    serialize(&one, 1, big, Endian::Big);
+    EXPECT_EQ(little[7], 0x3F);
+    EXPECT_EQ(little[0], 0x00);
+    EXPECT_EQ(big[0], 0x3F);
+    EXPECT_EQ(big[1], 0xF0);
+    EXPECT_EQ((getSerializedSize<FixedMatrix<4,3>>(10)), 10 * 12 * sizeof(double));
+
+    FixedMatrix<4,4> copied;
+    copied.randomFill(-1, 1, 8);
+    FixedMatrix<4,4> memory;
+    std::memcpy(&memory, &copied, sizeof(memory)); //plain values
+    EXPECT_EQ(memory, copied);
+}
+
+TEST(SerializationTest, round_trip){
+    size_t old_threshold = getParallelThreshold();
+    setParallelThreshold(1); //copy on every thread
+    std::vector<FixedMatrix<4,4>> transforms(1000);
+    for (size_t i = 0; i < transforms.size(); ++i) { transforms[i].randomNormalFill(0, 1, i); }
+    for (Endian endian : {Endian::Little, Endian::Big}) {
+        std::vector<unsigned char> bytes(getSerializedSize<FixedMatrix<4,4>>(transforms.size()) + 1);
+        serialize(transforms.data(), transforms.size(), bytes.data() + 1, endian); //unaligned
+        std::vector<FixedMatrix<4,4>> result(transforms.size());
+        deserialize(bytes.data() + 1, result.size(), result.data(), endian);
+        for (size_t i = 0; i < result.size(); ++i) { ASSERT_EQ(result[i], transforms[i]); }
+
+        std::stringstream stream;
+        std::vector<Vector3> points(70000); //more than one block
+        for (size_t i = 0; i < points.size(); ++i) { points[i] = Vector3(i, -0.5 * i, 1.0 / (i + 1)); }
+        ASSERT_TRUE(writeBinary(stream, points.data(), points.size(), endian));
+        EXPECT_EQ(stream.str().size(), getSerializedSize<Vector3>(points.size()));
+        std::vector<Vector3> read(points.size());
+        ASSERT_TRUE(readBinary(stream, read.data(), read.size(), endian));
+        for (size_t i = 0; i < read.size(); ++i) { ASSERT_EQ(read[i], points[i]); }
+        EXPECT_FALSE(readBinary(stream, read.data(), 1, endian)); //nothing left
+    }
+    setParallelThreshold(old_threshold);
+}
+
+#endif //TENSORMATH_SERIALIZATIONTEST_HPP
@@ -0,0 +1,174 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_SHAREDTEST_HPP
+#define TENSORMATH_SHAREDTEST_HPP
+
+#include <thread>
+#include "../TensorMath/Shared.hpp"
+#include "../TensorMath/Matrix.hpp"
+#include "gtest/gtest.h"
+
+#ifdef TENSORMATH_SHARED
+#include <sys/wait.h>
+
+//tests for the shared memory ring buffer, between threads and between processes
+using namespace TensorMath;
+
+//wait for room in the ring(a view can not be rebound, so retry in a function)
+static MatrixView sharedTestReserve(SharedRing &ring, int width, int height){
+    while (true) {
+        MatrixView slot = ring.reserveMatrix(width, height);
+        if (slot.data() != nullptr) { return slot; }
+        std::this_thread::yield();
+    }
+}
+
+TEST(SharedTest, threads){
+    SharedRing producer("/tensormath_test_threads", 4096);
+    ASSERT_TRUE(producer.isOpen());
+    SharedRing consumer("/tensormath_test_threads");
+    ASSERT_TRUE(consumer.isOpen());
+    EXPECT_EQ(consumer.getCapacity(), 4096);
+    SharedMessage message;
+    EXPECT_FALSE(consumer.receive(message));
+    const int MESSAGES = 2000; //wraps the ring many times
+    std::thread producing([&]() {
+        for (int i = 0; i < MESSAGES; ++i) {
+            if (i % 2 == 0) {
+                int size = 1 + i % 13;
+                MatrixView slot = sharedTestReserve(producer, size, size + 1);
+                for (int x = 0; x < size; ++x) {
+                    for (int y = 0; y < size + 1; ++y) { slot.setValue(x, y, i + x * 100 + y); }
+                }
+            } else {
+                Vector3 *points = producer.reserveArray<Vector3>(i % 7 + 1);
+                while (points == nullptr) {
+                    std::this_thread::yield();
+                    points = producer.reserveArray<Vector3>(i % 7 + 1);
+                }
+                for (int j = 0; j < i % 7 + 1; ++j) { points[j] = Vector3(i, j, -i); }
+            }
+            producer.publish();
+        }
+    });
+    for (int i = 0; i < MESSAGES; ++i) {
+        while (!consumer.receive(message)) { std::this_thread::yield(); }
+        if (i % 2 == 0) {
+            ASSERT_TRUE(message.isMatrix());
+            ConstMatrixView matrix = message.matrix();
+            int size = 1 + i % 13;
+            ASSERT_EQ(matrix.getWidth(), size);
+            ASSERT_EQ(matrix.getHeight(), size + 1);
+            EXPECT_EQ((uintptr_t) matrix.data() % 64, 0); //aligned for SIMD
+            for (int x = 0; x < size; ++x) {
+                for (int y = 0; y < size + 1; ++y) { ASSERT_EQ(matrix.getValue(x, y), i + x * 100 + y); }
+            }
+        } else {
+            ASSERT_TRUE(message.isArray());
+            ASSERT_EQ(message.getCount(), (size_t) (i % 7 + 1));
+            const Vector3 *points = message.array<Vector3>();
+            for (int j = 0; j < i % 7 + 1; ++j) { ASSERT_EQ(points[j], Vector3(i, j, -i)); }
+        }
+        consumer.release();
+    }
+    producing.join();
+    EXPECT_FALSE(consumer.receive(message));
+}
+
+TEST(SharedTest, processes){
+    SharedRing consumer_side("/tensormath_test_processes", 1 << 20); //created before the fork, so the child can open it
+    ASSERT_TRUE(consumer_side.isOpen());
+    pid_t child = fork();
+    if (child == 0) { //producer process
+        SharedRing producer("/tensormath_test_processes");
+        if (!producer.isOpen()) { _exit(1); }
+        for (int i = 0; i < 50; ++i) {
+            MatrixView slot = sharedTestReserve(producer, 64, 64);
+            for (int x = 0; x < 64; ++x) {
+                for (int y = 0; y < 64; ++y) { slot.setValue(x, y, i * 10000 + x * 64 + y); }
+            }
+            producer.publish();
+        }
+        _exit(0);
+    }
+    ASSERT_GT(child, 0);
+    SharedMessage message;
+    for (int i = 0; i < 50; ++i) {
+        while (!consumer_side.receive(message)) { usleep(100); }
+        ConstMatrixView matrix = message.matrix();
+        ASSERT_EQ(matrix.getWidth(), 64);
+        EXPECT_EQ(matrix.getValue(5, 7), i * 10000 + 5 * 64 + 7);
+        EXPECT_EQ(matrix.getValue(63, 63), i * 10000 + 63 * 64 + 63);
+        consumer_side.release();
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+TEST(SharedTest, names){
+    SharedRing first("/tensormath_test_names", 4096);
+    ASSERT_TRUE(first.isOpen());
+    SharedRing second("/tensormath_test_names", 4096); //the first is alive, so it is not replaced
+    EXPECT_FALSE(second.isOpen());
+    EXPECT_EQ(second.getCapacity(), 0);
+    SharedRing consumer("/tensormath_test_names"); //the failed one did not remove the name either
+    ASSERT_TRUE(consumer.isOpen());
+    first.reserveArray<double>(1)[0] = 5;
+    first.publish();
+    SharedMessage message;
+    ASSERT_TRUE(consumer.receive(message));
+    EXPECT_EQ(message.array<double>()[0], 5);
+
+    pid_t child = fork();
+    if (child == 0) { //creates a ring and exits without removing it, like a crash
+        SharedRing leftover("/tensormath_test_leftover", 4096);
+        _exit(leftover.isOpen() ? 0 : 1);
+    }
+    ASSERT_GT(child, 0);
+    int status = 0;
+    waitpid(child, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    SharedRing replaced("/tensormath_test_leftover", 8192); //its creator is gone, so it is replaced
+    ASSERT_TRUE(replaced.isOpen());
+    EXPECT_EQ(replaced.getCapacity(), 8192);
+
+    int unset = shm_open("/tensormath_test_unset", O_CREAT | O_EXCL | O_RDWR, 0600); //a creator that crashed right away
+    ASSERT_GE(unset, 0);
+    close(unset);
+    SharedRing after_crash("/tensormath_test_unset", 4096);
+    EXPECT_TRUE(after_crash.isOpen());
+}
+
+TEST(SharedTest, replaceRace){
+    //creators race to replace the same leftover segment, only one may win and its ring must keep the name
+    for (int round = 0; round < 10; ++round) {
+        pid_t children[2];
+        for (int c = 0; c < 2; ++c) {
+            children[c] = fork();
+            if (children[c] == 0) {
+                SharedRing ring("/tensormath_test_race", 4096 * (c + 1));
+                if (!ring.isOpen()) { _exit(2); }
+                usleep(20000); //both are running
+                SharedRing named("/tensormath_test_race");
+                _exit(named.isOpen() && named.getCapacity() == (size_t) 4096 * (c + 1) ? 0 : 1); //leaves the name behind
+            }
+        }
+        int winners = 0;
+        for (pid_t child: children) {
+            int status = 0;
+            waitpid(child, &status, 0);
+            ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) != 1); //the name never moved under a live ring
+            winners += WEXITSTATUS(status) == 0;
+        }
+        EXPECT_EQ(winners, 1);
+    }
+    SharedRing last("/tensormath_test_race", 4096); //replaces the last leftover, and removes the name
+    EXPECT_TRUE(last.isOpen());
+}
+
+#endif
+
+#endif //TENSORMATH_SHAREDTEST_HPP
@@ -0,0 +1,57 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_STRASSENTEST_HPP
+#define TENSORMATH_STRASSENTEST_HPP
+
+#include "../TensorMath/Matrix.hpp"
+#include "gtest/gtest.h"
+
+//tests for Strassen-Winograd multiplication, compared against the classic product
+using namespace TensorMath;
+
+static Matrix strassenTestMatrix(int width, int height, double seed, Layout layout = Layout::ColumnMajor){
+    Matrix out(width, height, layout);
+    for (int x = 0; x < width; ++x) {
+        for (int y = 0; y < height; ++y) { out.setValue(x, y, std::sin(seed + x * 0.7 + y * 1.3)); }
+    }
+    return out;
+}
+
+TEST(StrassenTest, matches_classic){
+    //odd sizes are padded, several levels deep
+    int sizes[][3] = {{64, 64, 64}, {67, 45, 53}, {40, 96, 33}};
+    for (auto &size: sizes) {
+        Matrix a = strassenTestMatrix(size[2], size[0], 0.1);
+        Matrix b = strassenTestMatrix(size[1], size[2], 0.2, Layout::RowMajor);
+        Matrix classic = a * b;
+        Matrix fast(size[1], size[0]);
+        multiplyStrassen(a, b, fast.view(), 8);
+        //normwise bound relative to the largest inputs(all inputs are at most 1)
+        double bound = 1e-13 * size[2];
+        EXPECT_TRUE(fast.equals(classic, bound));
+    }
+    //small products fall back to the classic kernel and match exactly
+    Matrix a = strassenTestMatrix(10, 10, 0.3);
+    Matrix fast(10, 10);
+    multiplyStrassen(a, a, fast.view(), 8);
+    EXPECT_TRUE(fast.equals(a * a, 0));
+}
+
+TEST(StrassenTest, matrix_mode){
+    Matrix a = strassenTestMatrix(48, 48, 0.4);
+    Matrix b = strassenTestMatrix(48, 48, 0.5);
+    Matrix classic = a * b;
+    setStrassenCutoff(4);
+    Matrix fast = a * b;
+    size_t workspace = Strassen::workspace().size();
+    Matrix again = a * b; //reuses the same scratch memory
+    EXPECT_EQ(Strassen::workspace().size(), workspace);
+    setStrassenCutoff(0);
+    EXPECT_TRUE(fast.equals(classic, 1e-12));
+    EXPECT_TRUE(again.equals(fast, 0));
+    EXPECT_TRUE((a * b).equals(classic, 0)); //off again
+}
+
+#endif //TENSORMATH_STRASSENTEST_HPP
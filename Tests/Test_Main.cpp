@@ -5,6 +5,28 @@
 #include "MatrixTest.hpp"
 #include "FixedVectorTest.hpp"
 #include "FixedMatrixTest.hpp"
+#include "AABBTest.hpp"
+#include "BVHTest.hpp"
+#include "KDTreeTest.hpp"
+#include "DispatchTest.hpp"
+#include "ViewTest.hpp"
+#include "ParallelTest.hpp"
+#include "StrassenTest.hpp"
+#include "BatchTest.hpp"
+#include "FunctionsTest.hpp"
+#include "LayersTest.hpp"
+#include "AutodiffTest.hpp"
+#include "RandomTest.hpp"
+#include "TextTest.hpp"
+#include "SerializationTest.hpp"
+#include "SharedTest.hpp"
+#include "InstrumentTest.hpp"
+#include "TraceTest.hpp"
+#include "BoundsTest.hpp"
+#include "IteratorTest.hpp"
+#include "LazyTest.hpp"
+#include "ChainTest.hpp"
+#include "DecompositionTest.hpp"
 int main(){
     testing::InitGoogleTest();
     RUN_ALL_TESTS();
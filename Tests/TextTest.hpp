@@ -0,0 +1,84 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_TEXTTEST_HPP
+#define TENSORMATH_TEXTTEST_HPP
+
+#include <cstdio>
+#include <sstream>
+#include "../TensorMath/Text.hpp"
+#include "../TensorMath/Matrix.hpp"
+#include "gtest/gtest.h"
+
+//tests for reading and writing matrices as text
+using namespace TensorMath;
+
+TEST(TextTest, round_trip){
+    size_t old_threshold = getParallelThreshold();
+    setParallelThreshold(1); //parse and format on every thread
+    for (Layout layout : {Layout::ColumnMajor, Layout::RowMajor}) {
+        Matrix a(37, 4000, layout); //more than one read chunk
+        a.randomNormalFill(0, 1e5, 3);
+        a.setValue(0, 0, 1e-310); //subnormal
+        a.setValue(1, 0, -0.0);
+        a.setValue(2, 0, 1.7976931348623157e308);
+        std::stringstream text;
+        ASSERT_TRUE(writeText(text, a));
+        std::vector<double> values;
+        int width, height;
+        ASSERT_TRUE(readText(text, values, width, height));
+        ASSERT_EQ(width, 37);
+        ASSERT_EQ(height, 4000);
+        EXPECT_EQ(a, Matrix(ConstMatrixView::rowMajor(values.data(), width, height))); //exact, shortest round trip text
+        EXPECT_TRUE(std::signbit(values[1]));
+    }
+    Vector long_row(100000); //one line longer than a chunk
+    long_row.randomFill(-1, 1, 4);
+    std::stringstream text;
+    ASSERT_TRUE(writeText(text, ConstMatrixView::rowMajor(long_row.data(), 100000, 1), ' '));
+    Vector result(100000);
+    ASSERT_TRUE(readText(text, result));
+    EXPECT_EQ(long_row, result);
+    setParallelThreshold(old_threshold);
+}
+
+TEST(TextTest, formats){
+    std::stringstream csv("1,2,3\r\n4.5,-5e2,+6\r\n\r\n");
+    Matrix a(3, 2);
+    ASSERT_TRUE(readText(csv, a));
+    Matrix expected(3, 2);
+    expected.fillArray({1, 2, 3, 4.5, -500, 6});
+    EXPECT_EQ(a, expected);
+    std::stringstream spaces("  1 2\t3\n\n4.5 ; -5e2   6"); //no newline at the end
+    ASSERT_TRUE(readText(spaces, a));
+    EXPECT_EQ(a, expected);
+    std::stringstream column("1\n2\n3\n");
+    Vector v(3);
+    ASSERT_TRUE(readText(column, v));
+    EXPECT_EQ(v, Vector({1, 2, 3}));
+    std::stringstream written;
+    writeText(written, a.row(1));
+    EXPECT_EQ(written.str(), "4.5\n-500\n6\n");
+    EXPECT_EQ(a.toString(), "[ 1.000000 2.000000 3.000000 ]\n[ 4.500000 -500.000000 6.000000 ]\n");
+
+    std::vector<double> values;
+    int width, height;
+    std::stringstream ragged("1,2,3\n4,5\n"), words("1,2\nx,3\n"), glued("1,2x\n"), empty("\n \n");
+    EXPECT_FALSE(readText(ragged, values, width, height));
+    EXPECT_FALSE(readText(words, values, width, height));
+    EXPECT_FALSE(readText(glued, values, width, height));
+    EXPECT_FALSE(readText(empty, values, width, height));
+    std::stringstream wrong_size("1,2\n3,4\n");
+    EXPECT_FALSE(readText(wrong_size, a)); //a is 3 x 2
+    EXPECT_FALSE(loadText("TensorMath_missing_file.csv", values, width, height));
+
+    const char *path = "TensorMath_text_test.csv";
+    ASSERT_TRUE(saveText(path, expected, ';'));
+    Matrix loaded(3, 2, Layout::RowMajor);
+    ASSERT_TRUE(loadText(path, loaded));
+    EXPECT_EQ(loaded, expected);
+    std::remove(path);
+}
+
+#endif //TENSORMATH_TEXTTEST_HPP
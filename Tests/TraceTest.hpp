@@ -0,0 +1,66 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_TRACETEST_HPP
+#define TENSORMATH_TRACETEST_HPP
+
+#include <sstream>
+#include <thread>
+#include "../TensorMath/Matrix.hpp"
+#include "../TensorMath/Text.hpp"
+#include "gtest/gtest.h"
+
+//tests for the trace export(the test build defines TENSORMATH_TRACE, see CMakeLists.txt)
+using namespace TensorMath;
+
+std::vector<TraceEvent> traceTestEvents(const std::string &name) {
+    std::vector<TraceEvent> found;
+    for (int thread = 0; thread < getTraceThreadCount(); ++thread) {
+        for (const TraceEvent &event: getTraceEvents(thread)) {
+            if (name == event.name) { found.push_back(event); }
+        }
+    }
+    return found;
+} //events of one operation on any thread
+
+TEST(TraceTest, events){
+    clearTrace();
+    Matrix a(20, 30), b(10, 20);
+    Matrix product = a * b;
+    std::stringstream text("1,2,3\n4,5,6\n");
+    std::vector<double> values;
+    int width, height;
+    EXPECT_TRUE(readText(text, values, width, height));
+    std::thread other([]() { Matrix x(4, 4); Matrix y = x * x; });
+    other.join();
+    std::vector<TraceEvent> products = traceTestEvents("multiply");
+    std::vector<TraceEvent> reads = traceTestEvents("readText");
+    if (!isTraceEnabled()) { //hooks are empty
+        EXPECT_TRUE(products.empty());
+        EXPECT_TRUE(reads.empty());
+        return;
+    }
+    ASSERT_EQ(products.size(), 2);
+    EXPECT_EQ(products[0].sizes[0], 30);
+    EXPECT_EQ(products[0].sizes[1], 10);
+    EXPECT_EQ(products[0].sizes[2], 20);
+    EXPECT_EQ(products[0].flops, 2 * 30 * 10 * 20);
+    EXPECT_GE(products[0].duration, 0);
+    EXPECT_EQ(products[1].sizes[0], 4);
+    ASSERT_EQ(reads.size(), 1);
+    EXPECT_EQ(reads[0].sizes[0], 3); //found out while reading
+    EXPECT_EQ(reads[0].sizes[1], 2);
+    EXPECT_EQ(getTraceDropped(), 0);
+
+    std::stringstream json;
+    EXPECT_TRUE(writeChromeTrace(json));
+    EXPECT_EQ(json.str().find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0);
+    EXPECT_NE(json.str().find("\"name\":\"multiply\",\"cat\":\"TensorMath\",\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.str().find("\"args\":{\"size\":[30,10,20],\"flops\":12000}"), std::string::npos);
+
+    clearTrace();
+    EXPECT_TRUE(traceTestEvents("multiply").empty());
+}
+
+#endif //TENSORMATH_TRACETEST_HPP
@@ -172,4 +172,32 @@ using namespace TensorMath;
         EXPECT_EQ(direction.reflect(normal), reflected);
     }
 
+    //test squared and approximate paths
+    TEST(VectorTest, fast_paths){
+        EXPECT_DOUBLE_EQ((Vector{4, 3}.lengthSquared()), 25.0);
+        EXPECT_DOUBLE_EQ((Vector{3,2,0}.distanceSquared(Vector{-1,-1,0})), 25.0);
+        //fast normalization, each precision level
+        Vector v = {1.5, -2.25, 7, 0.125};
+        Vector expected = v.normalized();
+        EXPECT_TRUE(v.normalizedFast(Precision::Low).equals(expected, 1e-5));
+        EXPECT_TRUE(v.normalizedFast(Precision::Medium).equals(expected, 1e-10));
+        EXPECT_TRUE(v.normalizedFast(Precision::High) == expected);
+        //in place and batched
+        Vector in_place = v;
+        in_place.normalize();
+        EXPECT_EQ(in_place, expected);
+        Vector batch[2] = {v, Vector{0, 0, 3, 4}};
+        Vector::normalizeBatch(batch, 2, Precision::High);
+        EXPECT_EQ(batch[0], expected);
+        EXPECT_EQ(batch[1], (Vector{0, 0, 0.6, 0.8}));
+        double lengths[2];
+        Vector::lengthSquaredBatch(batch, lengths, 2);
+        EXPECT_NEAR(lengths[0], 1.0, 1e-14);
+        EXPECT_NEAR(lengths[1], 1.0, 1e-14);
+        //reciprocal square root over a wide range
+        for (double x = 1e-200; x < 1e200; x *= 7.3) {
+            EXPECT_NEAR(fastInverseSqrt(x, Precision::High) * std::sqrt(x), 1.0, 1e-15);
+        }
+    }
+
 #endif //TENSOR_VECTORTEST_HPP
@@ -0,0 +1,131 @@
+//
+// Created by Philip on 10/19/2026.
+//
+
+#ifndef TENSORMATH_VIEWTEST_HPP
+#define TENSORMATH_VIEWTEST_HPP
+
+#include "../TensorMath/View.hpp"
+#include "../TensorMath/Matrix.hpp"
+#include "gtest/gtest.h"
+
+//tests for non-owning views
+using namespace TensorMath;
+
+TEST(ViewTest, vector_view){
+    double buffer[6] = {1, 2, 3, 4, 5, 6}; //memory owned by someone else
+    VectorView all(buffer, 6);
+    VectorView odd(buffer, 3, 2); //1,3,5
+    EXPECT_EQ(odd.getDim(), 3);
+    EXPECT_DOUBLE_EQ(odd[2], 5);
+    EXPECT_EQ(Vector(odd), (Vector{1, 3, 5})); //copy out
+    //reductions
+    EXPECT_DOUBLE_EQ(all.sum(), 21);
+    EXPECT_DOUBLE_EQ(odd.dotProduct(Vector{1, 1, 1}), 9);
+    EXPECT_DOUBLE_EQ(odd.lengthSquared(), 35);
+    EXPECT_DOUBLE_EQ(odd.distanceSquared(VectorView(buffer + 1, 3, 2)), 3);
+    //operations write straight into the buffer
+    odd *= 2;
+    EXPECT_DOUBLE_EQ(buffer[4], 10);
+    odd += Vector{1, 1, 1};
+    EXPECT_DOUBLE_EQ(buffer[0], 3);
+    odd = Vector{0, 0, 0};
+    EXPECT_DOUBLE_EQ(buffer[2], 0);
+    EXPECT_DOUBLE_EQ(buffer[3], 4); //values between strides are untouched
+    //operations into new vectors, contiguous and strided
+    Vector a{1, 2, 3};
+    ConstVectorView read_only = a;
+    EXPECT_EQ(read_only + a, (Vector{2, 4, 6}));
+    EXPECT_EQ(VectorView(buffer + 1, 3, 2) - read_only, (Vector{1, 2, 3}));
+    EXPECT_TRUE(read_only == a);
+    //views of vectors write into the vector
+    VectorView of_vector = a;
+    of_vector[0] = 7;
+    EXPECT_DOUBLE_EQ(a[0], 7);
+    FixedVector<3> fixed{1, 2, 3};
+    VectorView of_fixed = fixed;
+    of_fixed /= 2;
+    EXPECT_DOUBLE_EQ(fixed[2], 1.5);
+}
+
+TEST(ViewTest, vector_with_view){
+    Vector a{1, 2, 3}, b{4, 5, 6};
+    double buffer[6] = {1, 0, 2, 0, 3, 0};
+    ConstVectorView strided(buffer, 3, 2); //1,2,3
+    InstrumentSnapshot start = getThreadInstrumentSnapshot();
+    Vector sum = a + strided;
+    Vector difference = b - ConstVectorView(a);
+    Vector product = a * VectorView(b);
+    Vector quotient = b / strided;
+    b += strided;
+    b -= ConstVectorView(a);
+    double dot = dotProduct(a, strided);
+    bool equal = strided.equals(a) && ConstMatrixView::columnMajor(buffer, 2, 3) == ConstMatrixView::rowMajor(buffer, 3, 2).transposed();
+    InstrumentSnapshot work = getThreadInstrumentSnapshot() - start;
+    EXPECT_EQ(sum, (Vector{2, 4, 6}));
+    EXPECT_EQ(difference, (Vector{3, 3, 3}));
+    EXPECT_EQ(product, (Vector{4, 10, 18}));
+    EXPECT_EQ(quotient, (Vector{4, 2.5, 2}));
+    EXPECT_EQ(b, (Vector{4, 5, 6}));
+    EXPECT_DOUBLE_EQ(dot, 14);
+    EXPECT_TRUE(equal);
+    EXPECT_EQ(work.copies, 0); //views are read in place, comparisons too
+    EXPECT_EQ(work.allocations, isInstrumentEnabled() ? 4 : 0); //only the results
+}
+
+TEST(ViewTest, matrix_view){
+    //2x3 row major buffer
+    double buffer[6] = {1, 2,
+                        3, 4,
+                        5, 6};
+    MatrixView rows = MatrixView::rowMajor(buffer, 2, 3);
+    EXPECT_DOUBLE_EQ(rows.getValue(1, 2), 6);
+    EXPECT_DOUBLE_EQ(rows[0][1], 3);
+    EXPECT_EQ(Vector(rows.row(1)), (Vector{3, 4}));
+    EXPECT_EQ(Vector(rows.column(1)), (Vector{2, 4, 6}));
+    //a matrix and a view of the same values are equal
+    Matrix copy(2, 3);
+    copy.fillArray({1, 2, 3, 4, 5, 6});
+    EXPECT_TRUE(copy.equals(rows));
+    EXPECT_EQ(Matrix(rows), copy);
+    //transposes and blocks are views too
+    MatrixView transposed = rows.transposed();
+    EXPECT_EQ(transposed.getWidth(), 3);
+    EXPECT_DOUBLE_EQ(transposed.getValue(2, 1), 6);
+    MatrixView block = rows.block(1, 1, 1, 2);
+    block *= 10;
+    EXPECT_DOUBLE_EQ(buffer[3], 40);
+    EXPECT_DOUBLE_EQ(buffer[5], 60);
+    EXPECT_DOUBLE_EQ(rows.sum(), 1 + 2 + 3 + 40 + 5 + 60);
+}
+
+TEST(ViewTest, view_arithmetic){
+    Matrix a(2, 2);
+    a.fillArray({1, 2, 3, 4});
+    Matrix b(2, 2);
+    b.fillArray({2, 0, 1, 2});
+    Matrix a_times_b(2, 2);
+    a_times_b.fillArray({4, 4, 10, 8});
+    //multiply row major foreign memory into foreign memory
+    double a_rows[4] = {1, 2, 3, 4};
+    double b_columns[4] = {2, 1, 0, 2};
+    double out[4];
+    multiply(ConstMatrixView::rowMajor(a_rows, 2, 2), ConstMatrixView::columnMajor(b_columns, 2, 2),
+             MatrixView::columnMajor(out, 2, 2));
+    EXPECT_TRUE(a_times_b.equals(ConstMatrixView::columnMajor(out, 2, 2)));
+    //matrices and views mix
+    EXPECT_EQ(a * ConstMatrixView::columnMajor(b_columns, 2, 2), a_times_b);
+    EXPECT_EQ(ConstMatrixView::rowMajor(a_rows, 2, 2) * b, a_times_b);
+    EXPECT_EQ(a.view().transposed().transposed() + b, a + b);
+    EXPECT_EQ(a - b.view(), a - b);
+    //matrix columns and rows are views into the matrix
+    a[1][0] = 9;
+    EXPECT_DOUBLE_EQ(a.getValue(1, 0), 9);
+    a.row(1) *= 2;
+    EXPECT_DOUBLE_EQ(a.getValue(0, 1), 6);
+    a[0] = Vector{5, 5};
+    EXPECT_DOUBLE_EQ(a.getValue(0, 1), 5);
+    EXPECT_EQ(a.getColumn(1), (Vector{9, 8}));
+}
+
+#endif //TENSORMATH_VIEWTEST_HPP